@@ -0,0 +1,416 @@
+// src/AllocBenchmark.cpp
+// hotel_alloc_bench: counts the heap allocations of real ApiClient calls
+// (getRoomById, createBooking, updateRoom) against a floor: the same request
+// sent on a bare cpr::Session with its URL, headers and body built up front
+// and its response left undecoded. The difference is what the client adds per
+// call: building the request, metrics, caching and decoding. For reference it
+// also counts the old per-request construction (string concatenation,
+// std::to_string, a cpr::Header per request, a json DOM dumped to a temporary),
+// and checks that JsonWriter's bodies decode to what nlohmann writes.
+//
+// Requests go to a MockApi served in-process with Crow, or to --url (e.g. a
+// hotel_mock_server). Only the calling thread's allocations are counted, so
+// the in-process server's own work doesn't show up. getRoomById runs with a
+// room cache TTL of 0: every call is a conditional GET answered 304.
+//
+// Example:
+//   hotel_alloc_bench --iterations=20000
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <cpr/cpr.h>
+#include <crow.h>
+#include <nlohmann/json.hpp>
+#include "ApiClient.h"
+#include "DataStructures.h"
+#include "Logger.h"
+#include "MockApi.h"
+#include "RequestBuilder.h"
+
+// --- Allocation counting ---
+// Every replaceable form of operator new ends up in these two. Counted per
+// thread: the client's work happens on the calling thread, the server's doesn't.
+namespace {
+thread_local uint64_t threadAllocations = 0;
+} // namespace
+
+void* operator new(std::size_t size) {
+    ++threadAllocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+const std::string kApiPrefix = "/api";
+const std::string kEmail = "admin@hotel.local"; // Seeded by MockApi
+const std::string kPassword = "password";
+constexpr int kRoomCount = 20;
+
+struct BenchConfig {
+    std::string baseUrl;   // Empty: serve a MockApi in-process
+    int port = 8091;       // In-process server
+    uint64_t iterations = 20000;
+    uint64_t warmup = 500;
+};
+
+struct Result {
+    double allocationsPerRequest = 0.0;
+    double nanosPerRequest = 0.0;
+    uint64_t failures = 0;
+};
+
+size_t sink = 0; // Keeps the legacy builds observable
+
+void printUsage() {
+    std::cout << "Usage: hotel_alloc_bench [options]\n"
+              << "  --iterations=N  Measured requests per row (default 20000)\n"
+              << "  --warmup=N      Unmeasured requests before each row (default 500)\n"
+              << "  --url=URL       API to send to, e.g. a hotel_mock_server (default: an in-process MockApi)\n"
+              << "  --port=N        Port of the in-process MockApi (default 8091)\n";
+}
+
+bool parseArgs(int argc, char** argv, BenchConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        size_t eq = arg.find('=');
+        if (eq != std::string::npos) {
+            value = arg.substr(eq + 1);
+            arg = arg.substr(0, eq);
+        }
+        try {
+            if (arg == "--help" || arg == "-h") { printUsage(); return false; }
+            else if (arg == "--iterations") config.iterations = std::max<uint64_t>(1, std::stoull(value));
+            else if (arg == "--warmup") config.warmup = std::stoull(value);
+            else if (arg == "--url") config.baseUrl = value;
+            else if (arg == "--port") config.port = std::stoi(value);
+            else {
+                std::cerr << "[Alloc Bench Error] Unknown option: " << arg << std::endl;
+                printUsage();
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "[Alloc Bench Error] Invalid value for " << arg << ": '" << value << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Runs `op` warmup times unmeasured, then `iterations` times counted; op(i) returns false on failure
+template <typename Op>
+Result measure(uint64_t iterations, uint64_t warmup, Op op) {
+    for (uint64_t i = 0; i < warmup; ++i) op(i);
+    Result result;
+    uint64_t before = threadAllocations;
+    auto start = Clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        if (!op(i)) ++result.failures;
+    }
+    auto elapsed = Clock::now() - start;
+    result.allocationsPerRequest = static_cast<double>(threadAllocations - before) / iterations;
+    result.nanosPerRequest = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    return result;
+}
+
+void printRow(const char* name, const Result& floor, const Result& client, const Result& legacy) {
+    std::cout << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << floor.allocationsPerRequest << std::setw(10) << client.allocationsPerRequest
+              << std::setw(10) << client.allocationsPerRequest - floor.allocationsPerRequest
+              << std::setw(12) << legacy.allocationsPerRequest
+              << std::setprecision(0) << std::setw(12) << floor.nanosPerRequest
+              << std::setw(12) << client.nanosPerRequest << "\n";
+}
+
+BookingData sampleBooking(uint64_t i) {
+    BookingData booking;
+    booking.room_id = static_cast<int>(i % kRoomCount) + 1;
+    booking.check_in = Date::fromCivil(2026, 7, 1) + static_cast<int32_t>(i % 90);
+    booking.check_out = booking.check_in + 3;
+    booking.guests = 2;
+    booking.package = "Bed & Breakfast \"Deluxe\"";
+    booking.housekeeping = true;
+    booking.housekeeping_time = TimeOfDay::fromMinutes(10 * 60 + 30);
+    booking.parking = i % 2 == 0;
+    return booking;
+}
+
+RoomData sampleRoom() {
+    RoomData room;
+    room.name = "Sea View Suite";
+    room.type = "suite";
+    room.price = 249.5;
+    room.bed_size = "king";
+    room.view = "sea";
+    room.capacity = 3;
+    room.description = "Corner suite on the top floor.\nBalcony, bathtub and a separate lounge.";
+    room.amenities = {"wifi", "minibar", "air conditioning", "room service"};
+    room.image = "rooms/sea-view-suite.jpg";
+    room.available = true;
+    return room;
+}
+
+// The JsonWriter bodies must decode to exactly what nlohmann's to_json produces
+bool sameAsNlohmann() {
+    bool ok = true;
+    auto check = [&ok](const char* what, const json& expected, const std::string& written) {
+        json parsed = json::parse(written, nullptr, false);
+        if (parsed != expected) {
+            std::cerr << "[Alloc Bench Error] " << what << " body differs:\n  JsonWriter: " << written
+                      << "\n  nlohmann:   " << expected.dump() << std::endl;
+            ok = false;
+        }
+    };
+    std::string body;
+    for (uint64_t i = 0; i < 4; ++i) {
+        BookingData booking = sampleBooking(i);
+        if (i == 3) { booking.housekeeping = false; booking.housekeeping_time = TimeOfDay(); booking.check_out = Date(); }
+        body.clear();
+        JsonWriter writer(body);
+        writeJson(writer, booking);
+        check("BookingData", json(booking), body);
+    }
+    RoomData room = sampleRoom();
+    room.name = std::string("Tab\there, bell\x07, slash \\ and caf\xc3\xa9");
+    body.clear();
+    JsonWriter writer(body);
+    writeJson(writer, room);
+    check("RoomData", json(room), body);
+    return ok;
+}
+
+// --- Floor ---
+// A bare pooled session sending requests prepared in advance, so only what cpr
+// and curl do per transfer is counted. The headers match the client's default
+// block (plus the per-request header the client adds) and are updated in place.
+class FloorSender {
+public:
+    explicit FloorSender(std::string baseUrl) : base_url_(std::move(baseUrl)) {}
+
+    bool login() {
+        session_.SetUrl(cpr::Url{base_url_ + "/login"});
+        session_.SetHeader(cpr::Header{{"Content-Type", "application/json"}, {"Accept", "application/json"}});
+        session_.SetBody(cpr::Body{json{{"email", kEmail}, {"password", kPassword}, {"role", "admin"}}.dump()});
+        cpr::Response response = session_.Post();
+        json reply = json::parse(response.text, nullptr, false);
+        if (response.status_code != 200 || !reply.contains("token") || !reply["token"].is_string()) return false;
+        std::string bearer = "Bearer " + reply["token"].get<std::string>();
+        read_headers_ = {{"Content-Type", "application/json"}, {"Accept", "application/json"}, {"If-None-Match", ""}};
+        write_headers_ = {{"Content-Type", "application/json"}, {"Accept", "application/json"},
+                          {"Authorization", bearer}, {"Idempotency-Key", std::string(32, '0')}};
+        // Looked up once: operator[] would build a std::string key on every request
+        if_none_match_ = &read_headers_.find("If-None-Match")->second;
+        idempotency_key_ = &write_headers_.find("Idempotency-Key")->second;
+        return true;
+    }
+
+    // The ETag of every room, so the floor's GETs are answered 304 like the client's
+    bool prepareRooms() {
+        for (int id = 1; id <= kRoomCount; ++id) {
+            room_urls_.push_back(base_url_ + "/rooms/" + std::to_string(id));
+            session_.SetUrl(cpr::Url{room_urls_.back()});
+            session_.SetHeader(cpr::Header{{"Accept", "application/json"}});
+            session_.SetBody(cpr::Body{""});
+            cpr::Response response = session_.Get();
+            auto etag = response.header.find("ETag");
+            if (response.status_code != 200 || etag == response.header.end()) return false;
+            etags_.push_back(etag->second);
+        }
+        bookings_url_ = base_url_ + "/bookings";
+        return true;
+    }
+
+    bool getRoom(uint64_t i) {
+        size_t index = i % room_urls_.size();
+        if_none_match_->assign(etags_[index]);
+        return send(HttpMethod::Get, room_urls_[index], read_headers_, empty_);
+    }
+    bool postBooking(uint64_t i, const std::string& body) {
+        nextKey(i);
+        return send(HttpMethod::Post, bookings_url_, write_headers_, body);
+    }
+    bool putRoom(uint64_t i, const std::string& body) {
+        nextKey(i);
+        return send(HttpMethod::Put, room_urls_[i % room_urls_.size()], write_headers_, body);
+    }
+
+private:
+    // A fresh key per write, written over the old one (same length, no allocation)
+    void nextKey(uint64_t i) {
+        std::string& key = *idempotency_key_;
+        for (size_t d = 0; d < key.size(); ++d, i /= 16) key[key.size() - 1 - d] = "0123456789abcdef"[i % 16];
+        key[0] = 'f'; // Apart from any key the client generates
+    }
+
+    // The same calls ApiClient::transfer makes
+    bool send(HttpMethod method, const std::string& url, const cpr::Header& headers, const std::string& body) {
+        session_.SetUrl(cpr::Url{url});
+        session_.SetHeader(headers);
+        session_.SetBody(cpr::Body{body});
+        cpr::Response response = method == HttpMethod::Get ? session_.Get()
+                               : method == HttpMethod::Post ? session_.Post() : session_.Put();
+        return !response.error && response.status_code < 400;
+    }
+
+    std::string base_url_;
+    cpr::Session session_;
+    cpr::Header read_headers_;
+    cpr::Header write_headers_;
+    std::string* if_none_match_ = nullptr;   // Values inside the headers above
+    std::string* idempotency_key_ = nullptr;
+    std::vector<std::string> room_urls_;
+    std::vector<std::string> etags_;
+    std::string bookings_url_;
+    const std::string empty_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) return 1;
+    if (!sameAsNlohmann()) return 1;
+    Logger::instance().setLevel(LogLevel::Off); // Logging would be counted as the client's
+
+    // --- In-process server ---
+    // Overlapping bookings are accepted, so the same booking can be sent every iteration
+    MockOptions options;
+    options.roomCount = kRoomCount;
+    options.rejectOverlaps = false;
+    MockApi api(options);
+    crow::SimpleApp app;
+    std::future<void> server;
+    bool inProcess = config.baseUrl.empty();
+    if (inProcess) {
+        config.baseUrl = "http://127.0.0.1:" + std::to_string(config.port) + kApiPrefix;
+        app.loglevel(crow::LogLevel::Warning);
+        CROW_CATCHALL_ROUTE(app)([&api](const crow::request& req) {
+            if (req.url.compare(0, kApiPrefix.size(), kApiPrefix) != 0) {
+                return crow::response(404, "{\"message\":\"Not Found\"}");
+            }
+            MockRequest request;
+            request.method = crow::method_name(req.method);
+            request.target = req.raw_url.substr(kApiPrefix.size());
+            request.body = req.body;
+            request.authorization = req.get_header_value("Authorization");
+            request.ifNoneMatch = req.get_header_value("If-None-Match");
+            request.idempotencyKey = req.get_header_value("Idempotency-Key");
+            request.baseUrl = "http://" + req.get_header_value("Host") + kApiPrefix;
+
+            MockResponse result = api.handle(request);
+            crow::response res(result.status, result.body);
+            for (const auto& header : result.headers) res.set_header(header.first, header.second);
+            return res;
+        });
+        server = app.bindaddr("127.0.0.1").port(static_cast<std::uint16_t>(config.port)).concurrency(2).run_async();
+        app.wait_for_server_start();
+    }
+
+    int status = 0;
+    {
+        // --- Client and floor, both logged in ---
+        ApiClient client(config.baseUrl, 1);
+        client.setRoomCacheTtl(std::chrono::seconds(0)); // Every getRoomById reaches the server
+        FloorSender floor(config.baseUrl);
+        if (!client.login(kEmail, kPassword, "admin") || !floor.login() || !floor.prepareRooms()) {
+            std::cerr << "[Alloc Bench Error] Could not log in as " << kEmail << " at " << config.baseUrl
+                      << " (a MockApi server with its seeded accounts is expected)" << std::endl;
+            status = 1;
+        } else {
+            const BookingData booking = sampleBooking(7);
+            const RoomData room = sampleRoom();
+            std::string bookingBody;
+            std::string roomBody;
+            { JsonWriter writer(bookingBody); writeJson(writer, booking); }
+            { JsonWriter writer(roomBody); writeJson(writer, room); }
+            const uint64_t n = config.iterations;
+            const uint64_t w = config.warmup;
+            auto roomId = [](uint64_t i) { return static_cast<int>(i % kRoomCount) + 1; };
+
+            // Reads first: the writes below change the rooms' ETags
+            Result floorGet = measure(n, w, [&](uint64_t i) { return floor.getRoom(i); });
+            Result clientGet = measure(n, w, [&](uint64_t i) { return client.getRoomById(roomId(i)).has_value(); });
+            Result floorPost = measure(n, w, [&](uint64_t i) { return floor.postBooking(i, bookingBody); });
+            Result clientPost = measure(n, w, [&](uint64_t) { return client.createBooking(booking).has_value(); });
+            Result floorPut = measure(n, w, [&](uint64_t i) { return floor.putRoom(i, roomBody); });
+            Result clientPut = measure(n, w, [&](uint64_t i) { return client.updateRoom(roomId(i), room); });
+
+            // --- Reference: what sendRequest and its callers built per request before RequestBuilder ---
+            const std::string& baseUrl = config.baseUrl;
+            const std::string bearer = "Bearer 42|4b1f0a7e9c3d2e8f6a5b4c3d2e1f0a9b8c7d6e5f";
+            auto legacyHeaders = [&bearer](bool withAuth) {
+                cpr::Header headers = {
+                    {"Content-Type", "application/json"},
+                    {"Accept", "application/json"}
+                };
+                if (withAuth) headers["Authorization"] = bearer;
+                return headers;
+            };
+            Result legacyGet = measure(n, w, [&](uint64_t i) {
+                std::string path = "/rooms/" + std::to_string(roomId(i));
+                cpr::Url url{baseUrl + path};
+                cpr::Header headers = legacyHeaders(false);
+                sink += url.size() + headers.size();
+                return true;
+            });
+            Result legacyPost = measure(n, w, [&](uint64_t) {
+                json payload = booking;
+                cpr::Url url{baseUrl + "/bookings"};
+                cpr::Header headers = legacyHeaders(true);
+                cpr::Body body{payload.dump()};
+                sink += url.size() + headers.size() + body.str().size();
+                return true;
+            });
+            Result legacyPut = measure(n, w, [&](uint64_t i) {
+                std::string path = "/rooms/" + std::to_string(roomId(i));
+                json payload = room;
+                cpr::Url url{baseUrl + path};
+                cpr::Header headers = legacyHeaders(true);
+                cpr::Body body{payload.dump()};
+                sink += url.size() + headers.size() + body.str().size();
+                return true;
+            });
+
+            std::cout << "hotel_alloc_bench: " << n << " requests per row after " << w << " warm-up, against "
+                      << config.baseUrl << (inProcess ? " (in-process MockApi)" : "") << "\n\n"
+                      << "Allocations per request on the calling thread: floor = bare cpr session with the\n"
+                      << "request prebuilt, client = ApiClient call, extra = client - floor, old build =\n"
+                      << "the pre-RequestBuilder construction alone (not sent)\n\n"
+                      << std::left << std::setw(18) << "Request" << std::right
+                      << std::setw(10) << "floor" << std::setw(10) << "client" << std::setw(10) << "extra"
+                      << std::setw(12) << "old build" << std::setw(12) << "ns floor" << std::setw(12) << "ns client" << "\n";
+            printRow("GET /rooms/{id}", floorGet, clientGet, legacyGet);
+            printRow("POST /bookings", floorPost, clientPost, legacyPost);
+            printRow("PUT /rooms/{id}", floorPut, clientPut, legacyPut);
+            std::cout << "\n(checksum " << sink << ")" << std::endl;
+
+            uint64_t failures = floorGet.failures + clientGet.failures + floorPost.failures + clientPost.failures +
+                                floorPut.failures + clientPut.failures;
+            if (failures > 0) {
+                std::cerr << "[Alloc Bench Error] " << failures << " requests failed; their rows don't measure a full request" << std::endl;
+                status = 1;
+            }
+        }
+    }
+
+    if (inProcess) app.stop();
+    return status;
+}
@@ -1,159 +1,490 @@
 // src/ApiClient.cpp
 #include "ApiClient.h"
+#include "EndpointCall.h"
+#include "Logger.h"
 #include <cpr/cpr.h>
+#include <curl/curl.h>
 #include <nlohmann/json.hpp>
-#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
 #include <optional>
+#include <thread>
 #include <stdexcept> // For exceptions
 
 using json = nlohmann::json;
 
 // --- Constructor ---
-ApiClient::ApiClient(const std::string& base_url) : base_url_(base_url), auth_token_("") {
+ApiClient::ApiClient(const std::string& base_url, size_t maxConnectionsPerHost)
+    : base_url_(base_url), host_key_(ConnectionPool::hostKey(base_url)),
+      pool_(maxConnectionsPerHost), workers_(maxConnectionsPerHost) {
     // Basic validation could be added here if needed
     if (base_url.empty()) {
-        std::cerr << "[Config Error] API base URL cannot be empty!" << std::endl;
+        LOG_ERROR("[Config Error] API base URL cannot be empty!");
         // Consider throwing an exception or setting a default invalid state
     }
-    std::cout << "ApiClient initialized with base URL: " << base_url_ << std::endl;
+    LOG_INFO("ApiClient initialized with base URL: " << base_url_);
 }
 
 // --- Public Authentication Check ---
 bool ApiClient::isAuthenticated() const {
-    return !auth_token_.empty();
+    return tokens_.current()->loggedIn();
+}
+
+void ApiClient::setAutoRelogin(bool enabled) {
+    auto_relogin_.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        std::lock_guard<std::mutex> lock(auth_write_mutex_);
+        credentials_.reset();
+    }
+}
+
+uint64_t ApiClient::relogins() const {
+    return relogins_.load(std::memory_order_relaxed);
+}
+
+ConnectionStats ApiClient::connectionStats() const {
+    return pool_.stats();
+}
+
+void ApiClient::setTransportOptions(const TransportOptions& options) {
+    pool_.setTransportOptions(options);
+}
+
+RequestMetrics::Snapshot ApiClient::metricsSnapshot() const {
+    return metrics_.snapshot();
+}
+
+std::string ApiClient::metricsText() const {
+    return metrics_.prometheusText();
+}
+
+void ApiClient::setRetryPolicy(const RetryPolicy& policy) {
+    retry_policy_ = policy;
+}
+
+void ApiClient::setHedgePolicy(const HedgePolicy& policy) {
+    hedge_policy_ = policy;
+    if (policy.enabled && !hedge_workers_) {
+        // Two transfers per hedged call, at most one call per pooled connection
+        hedge_workers_ = std::make_unique<WorkerPool>(2 * pool_.maxSessionsPerHost());
+    } else if (!policy.enabled) {
+        hedge_workers_.reset();
+    }
+}
+
+RetryStats ApiClient::retryStats() const {
+    RetryStats s;
+    s.retries = retries_.load(std::memory_order_relaxed);
+    s.hedgesSent = hedges_sent_.load(std::memory_order_relaxed);
+    s.hedgesWon = hedges_won_.load(std::memory_order_relaxed);
+    return s;
+}
+
+
+uint64_t ApiClient::coalescedRequests() const {
+    return room_list_flights_.coalesced() + room_flights_.coalesced() + booking_list_flights_.coalesced() +
+           booking_flights_.coalesced() + user_flights_.coalesced();
 }
 
 
 // --- Private Helpers Implementation ---
 
-cpr::Header ApiClient::prepareHeaders(bool requiresAuth) {
-    cpr::Header headers = {
-        {"Content-Type", "application/json"},
-        {"Accept", "application/json"}
-    };
+std::string ApiClient::flightKey(HttpMethod method, std::string_view path, bool requiresAuth) const {
+    std::string key(methodName(method));
+    key += ' ';
+    key += path;
     if (requiresAuth) {
-        if (isAuthenticated()) {
-            headers["Authorization"] = "Bearer " + auth_token_;
-        } else {
-            // This situation should ideally be prevented by checks in the public methods
-            std::cerr << "[Header Warning] Auth required but client is not authenticated." << std::endl;
-            // Depending on application logic, you might want to throw here:
-            // throw std::runtime_error("Authentication required but token is missing.");
-        }
+        // The token itself, not a hash of it: a collision would hand one user another's data
+        key += " @";
+        key += authToken();
     }
-    return headers;
+    return key;
 }
 
-// Central place to handle response status checks and JSON parsing
-std::optional<json> ApiClient::handleResponse(const cpr::Response& response, int expectedStatus) {
-     // Log status code and potentially truncated body for debugging
-     std::cout << "[API Response] Status: " << response.status_code;
-     if (response.text.length() < 500) { // Limit log size
-         std::cout << ", Body: " << response.text << std::endl;
-     } else {
-          std::cout << ", Body: (Truncated - " << response.text.length() << " bytes)" << std::endl;
-     }
+std::string ApiClient::authToken() const {
+    return tokens_.current()->token;
+}
+
+void ApiClient::setAuthToken(const std::string& token, std::optional<Credentials> credentials, int userId) {
+    std::lock_guard<std::mutex> lock(auth_write_mutex_);
+    publishToken(token, std::move(credentials), userId);
+}
+
+void ApiClient::publishToken(const std::string& token, std::optional<Credentials> credentials, int userId) {
+    // A re-login keeps the user (and syncs in flight); another user's or no one's gets an empty replica
+    std::shared_ptr<const AuthSnapshot> previous = tokens_.current();
+    std::string scope = replicaScope(token, userId);
+    if (scope != replicaScope(previous->token, previous->userId)) booking_replica_.reset(std::move(scope));
+    tokens_.publish(token, userId);
+    credentials_ = auto_relogin_.load(std::memory_order_relaxed) ? std::move(credentials) : std::nullopt;
+}
+
+std::string ApiClient::replicaScope(const std::string& token, int userId) {
+    if (token.empty()) return "";
+    return userId != 0 ? "user:" + std::to_string(userId) : "token:" + token;
+}
+
+std::shared_ptr<const cpr::Header> ApiClient::headerBlock(const AuthSnapshot& auth, bool requiresAuth) const {
+    if (requiresAuth && !auth.loggedIn()) {
+        // This situation should ideally be prevented by checks in the public methods
+        LOG_WARN("[Header Warning] Auth required but client is not authenticated.");
+    }
+    return auth.headers.get(requiresAuth);
+}
+
+bool ApiClient::reauthenticate(uint64_t rejectedVersion) {
+    return *relogin_flights_.run(std::to_string(rejectedVersion), [this, rejectedVersion] {
+        std::optional<Credentials> credentials;
+        int userId = 0;
+        {
+            std::lock_guard<std::mutex> lock(auth_write_mutex_);
+            std::shared_ptr<const AuthSnapshot> current = tokens_.current();
+            if (current->version != rejectedVersion) return current->loggedIn(); // Already replaced (or logged out)
+            credentials = credentials_;
+            userId = current->userId; // Same credentials, same account
+        }
+        if (!credentials) return false;
+
+        LOG_INFO("[Auth] Token rejected, logging in again as " << credentials->email << ".");
+        json payload = {{"email", credentials->email}, {"password", credentials->password}, {"role", credentials->role}};
+        std::optional<json> response = call<endpoints::login>(endpoints::login.pattern, payload.dump());
+        if (!response || !response->contains("token") || !(*response)["token"].is_string()) {
+            LOG_ERROR("[Auth Error] Re-login failed; requests needing auth will fail until the next login.");
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(auth_write_mutex_);
+        std::shared_ptr<const AuthSnapshot> current = tokens_.current();
+        if (current->version != rejectedVersion) {
+            // A logout or another login won meanwhile; don't undo it
+            return current->loggedIn();
+        }
+        publishToken((*response)["token"].get<std::string>(), std::move(credentials), userId);
+        relogins_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    });
+}
+
+// Logs the response and checks for transport errors and the expected status.
+// Error bodies are decoded here for logging; successful bodies are left to the caller.
+bool ApiClient::checkResponse(const cpr::Response& response, StatusSet expected) {
+    // Status at debug level; the body only when body dumps are on (HOTEL_LOG_BODIES)
+    if (Logger::enabled(LogLevel::Debug)) {
+        if (!Logger::bodyDumps()) {
+            LOG_DEBUG("[API Response] Status: " << response.status_code << ", Body: " << response.text.length() << " bytes");
+        } else if (response.text.length() < 500) { // Limit log size
+            LOG_DEBUG("[API Response] Status: " << response.status_code << ", Body: " << response.text);
+        } else {
+            LOG_DEBUG("[API Response] Status: " << response.status_code << ", Body: (Truncated - " << response.text.length() << " bytes)");
+        }
+    }
 
     // Check for CPR library-level errors (network issues, etc.)
     if (response.error) {
-        std::cerr << "[API Error] CPR Error (" << static_cast<int>(response.error.code) << "): " << response.error.message << std::endl;
-        return std::nullopt;
+        LOG_ERROR("[API Error] CPR Error (" << static_cast<int>(response.error.code) << "): " << response.error.message);
+        return false;
     }
 
-    // Check if the HTTP status code matches the expected one
-    if (response.status_code != expectedStatus) {
-        std::cerr << "[API Error] Expected status " << expectedStatus << " but received " << response.status_code << "." << std::endl;
+    // Check if the HTTP status code is one of the expected ones
+    if (!expected.contains(response.status_code)) {
+        LOG_ERROR("[API Error] Expected status " << expected.toString() << " but received " << response.status_code << ".");
         // Attempt to parse the body as JSON for more detailed error messages from the API
         try {
             if (!response.text.empty()) {
                 json error_json = json::parse(response.text);
                 // Look for common Laravel error structures
                 if (error_json.contains("message")) {
-                    std::cerr << "[API Error Message] " << error_json["message"].get<std::string>() << std::endl;
+                    LOG_ERROR("[API Error Message] " << error_json["message"].get<std::string>());
                 }
                  if (error_json.contains("errors")) { // Laravel validation errors
-                     std::cerr << "[API Validation Errors] " << error_json["errors"].dump(2) << std::endl;
-                 } else if (!error_json.contains("message")){
-                     std::cerr << "[API Error Body] " << error_json.dump(2) << std::endl; // Pretty print if unknown structure
+                     LOG_ERROR("[API Validation Errors] " << error_json["errors"].dump(2));
+                 } else if (!error_json.contains("message") && Logger::bodyDumps()) {
+                     LOG_ERROR("[API Error Body] " << error_json.dump(2)); // Pretty print if unknown structure
                  }
             } else {
-                 std::cerr << "[API Error Body] (Empty)" << std::endl;
+                 LOG_ERROR("[API Error Body] (Empty)");
             }
         } catch (json::parse_error&) {
             // If the error response isn't JSON, print the raw text
-            std::cerr << "[API Error Body] " << response.text << std::endl;
+            if (Logger::bodyDumps()) LOG_ERROR("[API Error Body] " << response.text);
         }
-        return std::nullopt; // Indicate failure
+        return false; // Indicate failure
     }
+    return true;
+}
 
-    // Handle successful responses (matching expected status)
-
-    // Case 1: Successful response with no content expected (e.g., 204) or empty body
-    if (expectedStatus == 204 || response.text.empty()) {
-         if (response.text.empty() && expectedStatus != 204) {
+// The body of an already status-checked response as JSON, for routes that
+// don't answer with a {"data": ...} resource (see shape::Document)
+std::optional<json> ApiClient::parseDocument(const cpr::Response& response) {
+    // No content expected (e.g. 204) or empty body: success without parseable data
+    if (response.status_code == 204 || response.text.empty()) {
+         if (response.text.empty() && response.status_code != 204) {
              // Log if body is unexpectedly empty for statuses other than 204
-             std::cout << "[API Info] Received empty response body for status " << response.status_code << "." << std::endl;
+             LOG_INFO("[API Info] Received empty response body for status " << response.status_code << ".");
          }
-        // Return an empty JSON object to signify success without parseable data
         return json({});
     }
 
-    // Case 2: Successful response with content, try parsing JSON
     try {
         return json::parse(response.text);
     } catch (json::parse_error& e) {
-        std::cerr << "[JSON Error] Failed to parse successful response: " << e.what() << std::endl;
-        std::cerr << "[JSON Error] Raw Response Text: " << response.text << std::endl;
+        LOG_ERROR("[JSON Error] Failed to parse successful response: " << e.what());
+        if (Logger::bodyDumps()) LOG_ERROR("[JSON Error] Raw Response Text: " << response.text);
         return std::nullopt; // Indicate failure due to parsing error
     }
 }
 
-// Central request function using CPR
-std::optional<json> ApiClient::performRequest(
-    const std::string& method,
-    const std::string& relative_path,
-    int expectedStatus,
+// Everything needed to (re)send one request: built once, reused by retries and
+// hedges. The text is borrowed (caller's strings, this thread's RequestBuilder)
+// and the header block shared, so preparing a request copies nothing.
+struct ApiClient::PreparedRequest {
+    HttpMethod method = HttpMethod::Get;
+    std::string_view path;
+    std::string_view url;
+    std::string_view body;
+    std::shared_ptr<const cpr::Header> headers;
+    const cpr::Header* extraHeaders = nullptr; // Applied over `headers`
+
+    // A copy that owns its text, for transfers that may outlive the caller (a hedge's loser)
+    std::shared_ptr<PreparedRequest> detach() const;
+
+private:
+    std::string storage_;
+    std::optional<cpr::Header> extra_storage_;
+};
+
+std::shared_ptr<ApiClient::PreparedRequest> ApiClient::PreparedRequest::detach() const {
+    auto copy = std::make_shared<PreparedRequest>();
+    copy->method = method;
+    copy->storage_.reserve(path.size() + url.size() + body.size());
+    std::string_view* fields[] = {&copy->path, &copy->url, &copy->body};
+    std::string_view sources[] = {path, url, body};
+    for (std::string_view source : sources) copy->storage_.append(source.data(), source.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        *fields[i] = std::string_view(copy->storage_).substr(offset, sources[i].size());
+        offset += sources[i].size();
+    }
+    copy->headers = headers;
+    if (extraHeaders) {
+        copy->extra_storage_ = *extraHeaders;
+        copy->extraHeaders = &*copy->extra_storage_;
+    }
+    return copy;
+}
+
+// Sends the request over a pooled session and returns the raw response.
+// std::nullopt means the request could not be sent at all (missing body, exception).
+std::optional<cpr::Response> ApiClient::sendSerialized(
+    HttpMethod method,
+    std::string_view relative_path,
     bool requiresAuth,
-    const std::optional<json>& payload)
+    std::string_view body,
+    const cpr::Header* extraHeaders,
+    bool hedged)
 {
-    // Construct the full URL
-    cpr::Url url = cpr::Url{base_url_ + relative_path};
-    // Prepare headers, including auth if needed
-    cpr::Header headers = prepareHeaders(requiresAuth);
-    // Declare response variable
-    cpr::Response response;
+    if ((method == HttpMethod::Post || method == HttpMethod::Put) && body.empty()) { // POST/PUT typically require a body
+        LOG_ERROR("[Request Error] " << methodName(method) << " request to " << relative_path << " called without a payload.");
+        return std::nullopt;
+    }
+    uint64_t recordedFrom = recorder_ ? recorder_->now() : 0;
+
+    PreparedRequest request;
+    request.method = method;
+    request.path = relative_path;
+    // Construct the full URL in this thread's reusable buffer
+    request.url = RequestBuilder::forThisThread().url(base_url_, relative_path);
+    request.body = body;
+    // Prebuilt headers, including auth if needed; extras are applied per transfer.
+    // Holding the snapshot keeps it valid after a token change, so a 401 can be traced to it.
+    std::shared_ptr<const AuthSnapshot> auth = tokens_.current();
+    request.headers = headerBlock(*auth, requiresAuth);
+    request.extraHeaders = extraHeaders;
+
+    // Only GETs are safe to send more than once
+    bool idempotent = method == HttpMethod::Get;
+    int attempts = idempotent ? std::max(1, retry_policy_.maxAttempts) : 1;
+    hedged = hedged && idempotent && hedge_workers_;
+    std::shared_ptr<const PreparedRequest> detached;
+    if (hedged) detached = request.detach();
+
+    auto send = [&]() -> std::optional<cpr::Response> {
+        if (hedged) return hedgedTransfer(detached);
+        // Borrow a kept-alive session for this host; returned to the pool on scope exit
+        ConnectionPool::Lease lease = pool_.acquire(host_key_);
+        return transfer(request, lease);
+    };
 
-    // Prepare body if payload is provided
-    cpr::Body body = payload.has_value() ? cpr::Body{payload.value().dump()} : cpr::Body{""};
+    std::optional<cpr::Response> response;
+    for (int attempt = 1; ; ++attempt) {
+        response = send();
+        if (!response || attempt >= attempts || !RetryPolicy::isRetryable(*response)) break;
+
+        std::chrono::milliseconds delay = retry_policy_.delayBefore(attempt, *response);
+        LOG_WARN("[Retry] " << methodName(method) << " " << relative_path << " failed ("
+                 << (response->error ? response->error.message : "HTTP " + std::to_string(response->status_code))
+                 << "), attempt " << attempt + 1 << " of " << attempts << " in " << delay.count() << " ms");
+        retries_.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::sleep_for(delay);
+    }
+
+    if (response && response->status_code == 401 && requiresAuth && auth->loggedIn()) {
+        // The re-login reuses this thread's RequestBuilder: keep our own copy of the request first.
+        // A 401 means the API didn't act on it, so resending a write is safe too.
+        std::shared_ptr<PreparedRequest> owned = request.detach();
+        if (reauthenticate(auth->version)) {
+            owned->headers = headerBlock(*tokens_.current(), true);
+            LOG_INFO("[Auth] Resending " << methodName(method) << " " << owned->path << " with the new token.");
+            if (hedged) {
+                response = hedgedTransfer(owned);
+            } else {
+                ConnectionPool::Lease lease = pool_.acquire(host_key_);
+                response = transfer(*owned, lease);
+            }
+        }
+    }
+    if (recorder_) recordTraffic(recordedFrom, method, relative_path, requiresAuth, body, response);
+    return response;
+}
+
+namespace {
+
+// Uninstalls a transfer's cancel hook however the transfer ends (a cpr call can
+// throw): the session goes back to the pool and must not keep calling into a
+// flag its caller has since destroyed
+struct CancelHook {
+    cpr::Session* session = nullptr; // Set while the hook is installed
+    ~CancelHook() {
+        if (!session) return;
+        session->SetProgressCallback(cpr::ProgressCallback{}); // Drops the lambda holding the flag
+        curl_easy_setopt(session->GetCurlHolder()->handle, CURLOPT_NOPROGRESS, 1L);
+    }
+};
+
+} // namespace
+
+std::optional<cpr::Response> ApiClient::transfer(const PreparedRequest& request, ConnectionPool::Lease& lease,
+                                                 const std::atomic<bool>* cancel) {
+    cpr::Session& session = lease.session();
+    // cpr keeps its own copies; these are the only ones made per transfer
+    session.SetUrl(cpr::Url{request.url.data(), request.url.size()});
+    session.SetHeader(*request.headers);
+    if (request.extraHeaders) session.UpdateHeader(*request.extraHeaders);
+    // Always reset the body: pooled sessions remember the previous request's body
+    session.SetBody(cpr::Body{request.body.data(), request.body.size()});
+    CancelHook hook;
+    if (cancel) {
+        // curl polls this during the transfer; returning false aborts it
+        session.SetProgressCallback(cpr::ProgressCallback(
+            [cancel](auto, auto, auto, auto, intptr_t) { return !cancel->load(std::memory_order_relaxed); }));
+        hook.session = &session;
+    }
 
     // --- Execute HTTP Request based on method ---
+    cpr::Response response;
     try {
-        if (method == "GET") {
-            response = cpr::Get(url, headers);
-        } else if (method == "POST") {
-             if (!payload.has_value()) { // POST typically requires a body
-                 std::cerr << "[Request Error] POST request to " << relative_path << " called without a payload." << std::endl;
-                 return std::nullopt;
-             }
-            response = cpr::Post(url, headers, body);
-        } else if (method == "PUT") {
-             if (!payload.has_value()) { // PUT typically requires a body
-                 std::cerr << "[Request Error] PUT request to " << relative_path << " called without a payload." << std::endl;
-                 return std::nullopt;
-             }
-            response = cpr::Put(url, headers, body);
-        } else if (method == "DELETE") {
-            response = cpr::Delete(url, headers); // DELETE may or may not have a body depending on API
-        } else {
-            std::cerr << "[Request Error] Unsupported HTTP method provided: " << method << std::endl;
-            return std::nullopt;
+        switch (request.method) {
+            case HttpMethod::Get: response = session.Get(); break;
+            case HttpMethod::Post: response = session.Post(); break;
+            case HttpMethod::Put: response = session.Put(); break;
+            case HttpMethod::Delete: response = session.Delete(); break; // DELETE may or may not have a body depending on API
         }
     } catch (const std::exception& e) {
          // Catch potential exceptions during the cpr:: call itself (less common)
-         std::cerr << "[Request Error] Exception during HTTP request (" << method << " " << relative_path << "): " << e.what() << std::endl;
+         LOG_ERROR("[Request Error] Exception during HTTP request (" << methodName(request.method) << " " << request.path << "): " << e.what());
          return std::nullopt;
     }
+    if (cancel && response.error && cancel->load(std::memory_order_relaxed)) return response; // Lost the race: not a sample
+    metrics_.recordTransfer(methodName(request.method), request.path, response, session);
+    lease.recordTransfer(response);
+    return response;
+}
+
+// --- Hedged Reads ---
+
+namespace {
+
+// Shared between a hedged GET and the (up to two) transfers racing for it
+struct HedgeRace {
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::optional<cpr::Response> winner; // First response that isn't a transport error
+    int winnerIndex = -1;
+    std::optional<cpr::Response> failure; // Kept in case both attempts fail
+    int running = 0;
+    std::atomic<bool> settled{false};    // Tells the slower transfer to abort
+};
 
-    // Handle the response (checks status, parses JSON)
-    return handleResponse(response, expectedStatus);
-}
\ No newline at end of file
+} // namespace
+
+std::chrono::milliseconds ApiClient::hedgeDelay(const PreparedRequest& request) const {
+    std::optional<AtomicHistogram::Snapshot> latency = metrics_.histogram(methodName(request.method), request.path, RequestPhase::Total);
+    if (!latency || latency->count < hedge_policy_.minSamples) return hedge_policy_.defaultDelay;
+    double millis = latency->quantileMillis(hedge_policy_.quantile);
+    if (!std::isfinite(millis)) return hedge_policy_.defaultDelay;
+    return std::max(hedge_policy_.minDelay, std::chrono::milliseconds(static_cast<long long>(std::ceil(millis))));
+}
+
+std::optional<cpr::Response> ApiClient::hedgedTransfer(const std::shared_ptr<const PreparedRequest>& request) {
+    auto race = std::make_shared<HedgeRace>();
+    // Leases are move-only; share them so the job fits in a std::function
+    auto launch = [this, request, race](ConnectionPool::Lease lease, int index) {
+        auto held = std::make_shared<ConnectionPool::Lease>(std::move(lease));
+        {
+            std::lock_guard<std::mutex> lock(race->mutex);
+            ++race->running;
+        }
+        hedge_workers_->post([this, request, race, held, index] {
+            std::optional<cpr::Response> response = transfer(*request, *held, &race->settled);
+            std::lock_guard<std::mutex> lock(race->mutex);
+            --race->running;
+            if (response && !response->error && !race->winner) {
+                race->winner = std::move(response);
+                race->winnerIndex = index;
+                race->settled.store(true, std::memory_order_relaxed);
+            } else if (response && !race->failure) {
+                race->failure = std::move(response);
+            }
+            race->finished.notify_all();
+        });
+    };
+    auto done = [&race] { return race->winner.has_value() || race->running == 0; };
+
+    launch(pool_.acquire(host_key_), 0);
+    std::unique_lock<std::mutex> lock(race->mutex);
+    if (!race->finished.wait_for(lock, hedgeDelay(*request), done)) {
+        lock.unlock();
+        // Hedge only if a connection is free right away; waiting for one defeats the point
+        if (std::optional<ConnectionPool::Lease> spare = pool_.tryAcquire(host_key_)) {
+            LOG_DEBUG("[Hedge] " << methodName(request->method) << " " << request->path << " is slow, sending a second copy");
+            hedges_sent_.fetch_add(1, std::memory_order_relaxed);
+            launch(std::move(*spare), 1);
+        }
+        lock.lock();
+    }
+    race->finished.wait(lock, done);
+    race->settled.store(true, std::memory_order_relaxed); // Cancel whichever is still running
+
+    if (race->winner) {
+        if (race->winnerIndex == 1) hedges_won_.fetch_add(1, std::memory_order_relaxed);
+        return std::move(race->winner);
+    }
+    return std::move(race->failure);
+}
+
+// Central request function using CPR
+// Hands back the checked raw response so list endpoints can stream-decode the
+// body without a json DOM
+std::optional<cpr::Response> ApiClient::performRawRequest(
+    HttpMethod method,
+    std::string_view relative_path,
+    StatusSet expected,
+    bool requiresAuth)
+{
+    std::optional<cpr::Response> response = sendSerialized(method, relative_path, requiresAuth, {});
+    if (!response || !checkResponse(response.value(), expected)) {
+        return std::nullopt;
+    }
+    return response;
+}
@@ -2,11 +2,33 @@
 #ifndef API_CLIENT_H
 #define API_CLIENT_H
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp> // Include json header
 #include "DataStructures.h"  // Include our structs
+#include "Endpoint.h"        // Compile-time route descriptors (method, path, statuses, shape)
+#include "ConnectionPool.h"  // Pooled keep-alive sessions
+#include "MutationJournal.h" // Offline queue for writes that couldn't be sent
+#include "PageCursor.h"      // Iteration over paginated listings
+#include "RequestBuilder.h"  // Allocation-free paths, bodies and headers
+#include "RequestMetrics.h"  // Per-route latency/status counters
+#include "RetryPolicy.h"     // Backoff for transient failures, hedged reads
+#include "RoomCache.h"       // Local room catalog with ETag revalidation
+#include "SingleFlight.h"    // Sharing of concurrent identical GETs
+#include "SyncReplica.h"     // Local copies kept current by delta sync
+#include "TokenStore.h"      // Read-copy-update holder of the current auth token
+#include "TrafficCapture.h"  // Recording of requests and responses for hotel_replay
+#include "WorkerPool.h"      // Threads behind the *Async methods
 
 // Forward declare cpr::Response and cpr::Header
 namespace cpr {
@@ -16,29 +38,209 @@ namespace cpr {
 using json = nlohmann::json;
 
 
+// --- Batch Booking Results ---
+struct BookingBatchItem {
+    std::optional<Booking> booking; // Created booking, if successful
+    std::string error;              // Short failure reason otherwise
+    bool ok() const { return booking.has_value(); }
+};
+
+struct BookingBatchResult {
+    std::vector<BookingBatchItem> items; // Same order as the input
+    size_t succeeded = 0;
+    size_t failed = 0;
+    double elapsedSeconds = 0.0;
+    double bookingsPerSecond = 0.0;      // Successful creations per second
+};
+
+
 class ApiClient {
 private:
     std::string base_url_;
-    std::string auth_token_;
+    // The current token and its headers: requests read it without waiting on writers,
+    // login/logout/re-login publish a new one (TokenStore.h)
+    TokenStore tokens_;
+    struct Credentials {
+        std::string email;
+        std::string password;
+        std::string role;
+    };
+    std::mutex auth_write_mutex_;            // Serializes token changes; requests never take it
+    std::optional<Credentials> credentials_; // For re-login, kept only with auto re-login on
+    std::atomic<bool> auto_relogin_{false};
+    std::atomic<uint64_t> relogins_{0};
+    SingleFlight<bool> relogin_flights_;     // One re-login per rejected token, keyed by its version
+    std::string host_key_;   // "scheme://host:port" of base_url_, key into pool_
+    ConnectionPool pool_;    // Reused curl sessions, shared by every request path
+    RoomCache room_cache_;   // getRooms/getRoomById results, invalidated by room writes
+    RequestMetrics metrics_; // Per-route timings and status counts, recorded by sendSerialized
+    RetryPolicy retry_policy_;
+    HedgePolicy hedge_policy_;
+    std::atomic<uint64_t> retries_{0};
+    std::atomic<uint64_t> hedges_sent_{0};
+    std::atomic<uint64_t> hedges_won_{0};
+    // Concurrent identical GETs share one request and decoded result (keyed by flightKey())
+    SingleFlight<std::vector<Room>> room_list_flights_;
+    SingleFlight<std::optional<Room>> room_flights_;
+    SingleFlight<std::vector<Booking>> booking_list_flights_;
+    SingleFlight<std::optional<Booking>> booking_flights_;
+    SingleFlight<std::optional<User>> user_flights_;
+    SingleFlight<SyncDiff> sync_flights_;
+    SyncReplica<Room> room_replica_;       // Kept by syncRooms()
+    SyncReplica<Booking> booking_replica_; // Kept by syncBookings(); reset when the signed-in user changes
+    MutationJournal* journal_ = nullptr; // Not owned; writes that fail in transit are queued here
+    std::mutex replay_mutex_;            // One journal replay at a time, so entries go out once and in order
+    TrafficRecorder* recorder_ = nullptr; // Not owned; every request sent is recorded here
+    // Runs the racing transfers of hedged GETs; created when hedging is enabled
+    std::unique_ptr<WorkerPool> hedge_workers_;
+    // Declared last so queued async jobs finish before the members they use are destroyed
+    WorkerPool workers_;
 
     // --- Private Helpers ---
-    cpr::Header prepareHeaders(bool requiresAuth = false);
-    std::optional<json> handleResponse(const cpr::Response& response, int expectedStatus = 200);
-
-    // Central method to perform HTTP requests
-    std::optional<json> performRequest(
-        const std::string& method,           // e.g., "GET", "POST"
-        const std::string& relative_path,    // e.g., "/login", "/rooms/5"
-        int expectedStatus,                 // Expected HTTP status for success
-        bool requiresAuth,                  // Does this request need the auth token?
-        const std::optional<json>& payload = std::nullopt // Optional JSON body for POST/PUT
+    std::string authToken() const;
+    // Publishes a new token (empty = logged out), the credentials that obtained it and its user
+    void setAuthToken(const std::string& token, std::optional<Credentials> credentials = std::nullopt, int userId = 0);
+    void publishToken(const std::string& token, std::optional<Credentials> credentials, int userId); // auth_write_mutex_ held
+    // The prebuilt default headers (with Authorization if requiresAuth and logged in)
+    std::shared_ptr<const cpr::Header> headerBlock(const AuthSnapshot& auth, bool requiresAuth) const;
+    // Whose data a per-user replica holds: the user id, or the token itself when
+    // the login didn't report one; "" when logged out
+    static std::string replicaScope(const std::string& token, int userId);
+    // After a 401: logs in again with the saved credentials unless the rejected
+    // token (by version) was already replaced. Concurrent callers share one login.
+    bool reauthenticate(uint64_t rejectedVersion);
+    bool checkResponse(const cpr::Response& response, StatusSet expected = 200);
+    std::optional<json> parseDocument(const cpr::Response& response);
+
+    // Sends a request and returns the raw response, for callers that need status/headers
+    // (e.g. 304 revalidation). The body is already serialized (JsonWriter, a journal
+    // entry); empty for none. extraHeaders are merged over the defaults. GETs are
+    // retried per retry_policy_; hedged GETs also race a second copy (hedge_policy_).
+    // The URL goes into this thread's RequestBuilder, so building the request allocates nothing.
+    std::optional<cpr::Response> sendSerialized(
+        HttpMethod method,
+        std::string_view relative_path,
+        bool requiresAuth,
+        std::string_view body,
+        const cpr::Header* extraHeaders = nullptr,
+        bool hedged = false
+    );
+
+    // Hands a finished sendSerialized call to recorder_
+    void recordTraffic(uint64_t started, HttpMethod method, std::string_view path, bool requiresAuth,
+                       std::string_view body, const std::optional<cpr::Response>& response);
+
+    // One attempt of a prepared request (ApiClient.cpp); `cancel` aborts it mid-transfer
+    struct PreparedRequest;
+    std::optional<cpr::Response> transfer(const PreparedRequest& request, ConnectionPool::Lease& lease,
+                                          const std::atomic<bool>* cancel = nullptr);
+    std::optional<cpr::Response> hedgedTransfer(const std::shared_ptr<const PreparedRequest>& request);
+    std::chrono::milliseconds hedgeDelay(const PreparedRequest& request) const;
+
+    std::optional<Booking> submitBooking(const BookingData& bookingData, std::string& error);
+
+    // Sends a write with a fresh Idempotency-Key; if the API is unreachable and a
+    // journal is attached, the write is queued for replay (ApiClient_Offline.cpp)
+    std::optional<cpr::Response> sendMutation(HttpMethod method, std::string_view path, std::string_view body);
+    static std::string_view newIdempotencyKey(std::array<char, 32>& buffer);
+
+    // "GET /rooms/42" plus the auth scope: requests made with different tokens never share
+    std::string flightKey(HttpMethod method, std::string_view path, bool requiresAuth) const;
+    // The network side of the GETs below, run once per flight
+    std::vector<Room> fetchRooms();
+    std::optional<Room> fetchRoomById(int id);
+    std::vector<Booking> fetchBookings();
+    std::optional<Booking> fetchBookingById(int id);
+    std::optional<User> fetchUserProfile(int id);
+
+    // --- Typed Endpoints (Endpoint.h; defined in EndpointCall.h) ---
+    // Sends E (its method, auth, statuses, hedging) to `path` - E's pattern, or
+    // endpointPath<E>(id) - and decodes the reply as E's shape. The method and
+    // the decoder are fixed at compile time, per endpoint.
+    template <const auto& E>
+    EndpointResult<E> call(std::string_view path, std::string_view body = {});
+    // The status check and decode half of call(), for requests sent another way
+    // (conditional GETs, journaled writes)
+    template <const auto& E>
+    EndpointResult<E> receive(const std::optional<cpr::Response>& response, std::string_view path);
+
+    // One page of a paginated listing, decoded into T (ApiClient_Pagination.cpp)
+    template <typename T>
+    Page<T> fetchPage(const std::string& path, bool requiresAuth);
+    std::string nextPagePath(const std::string& path, const PageInfo& info) const;
+
+    // GET path?updated_since=<cursor> applied to the replica; from an API that sends
+    // no cursor, every page of the plain listing applied as a full snapshot (ApiClient_Sync.cpp)
+    template <typename T>
+    SyncDiff syncInto(SyncReplica<T>& replica, const char* path, bool requiresAuth);
+
+    // Sends a request and returns the status-checked raw response, for paths only
+    // known at run time (pagination links, sync cursors)
+    std::optional<cpr::Response> performRawRequest(
+        HttpMethod method,
+        std::string_view relative_path,
+        StatusSet expected,
+        bool requiresAuth
     );
 
 public:
-    ApiClient(const std::string& base_url);
+    // Async methods run on up to maxConnectionsPerHost worker threads, one per pooled connection
+    ApiClient(const std::string& base_url, size_t maxConnectionsPerHost = 4);
 
     bool isAuthenticated() const;
 
+    // Pool counters (new vs reused connections) for monitoring keep-alive savings
+    ConnectionStats connectionStats() const;
+    // HTTP version, compression and cache sharing for the pooled sessions; set before issuing requests
+    void setTransportOptions(const TransportOptions& options);
+
+    // Per-route request metrics: status classes, body sizes and the curl timing
+    // breakdown (dns/connect/tls/server/download) next to client-side parse time
+    RequestMetrics::Snapshot metricsSnapshot() const;
+    std::string metricsText() const; // Prometheus text format
+
+    // Retry and hedging behaviour for GETs; set these before issuing requests
+    void setRetryPolicy(const RetryPolicy& policy);
+    void setHedgePolicy(const HedgePolicy& policy); // Hedges getRoomById / getBookingById
+    RetryStats retryStats() const;
+
+    // --- Concurrency ---
+    // One client may be shared by any number of threads, logged in once. Requests
+    // read the auth token without locking; login/logout swap it without waiting
+    // for requests in flight (those finish with the token they started with).
+    // With auto re-login on, login() keeps the credentials, and a request whose
+    // token is rejected (401) triggers one re-login shared by every request that
+    // hit the same token, then is sent again. Off by default: it keeps the
+    // password in memory for the session.
+    void setAutoRelogin(bool enabled); // Set before login()
+    uint64_t relogins() const;         // Re-logins performed after a 401
+
+    // Calls to getRooms/getRoomById/getBookings/getBookingById/getUserProfile that
+    // joined an identical in-flight request instead of sending their own
+    uint64_t coalescedRequests() const;
+
+    // --- Offline Writes ---
+    // With a journal attached, createBooking/updateRoom/updateUserProfile calls that
+    // never left this machine (host not found, connection refused) are saved to it
+    // under the logged-in user and still report failure; lastWriteQueued() tells the
+    // caller the write will be replayed. A write that may have reached the API
+    // (timeout, 5xx) is never queued: the API doesn't dedupe on Idempotency-Key.
+    void setMutationJournal(MutationJournal* journal); // Set before issuing requests
+    bool lastWriteQueued() const;  // For the calling thread's most recent write
+    size_t queuedWrites() const;   // The logged-in user's writes still queued
+    // Sends the logged-in user's queued writes in order; other users' stay queued
+    // until they log in. Stops at the first one the API turns away for now;
+    // returns how many were delivered.
+    size_t replayJournal();
+
+    // --- Traffic Capture ---
+    // With a recorder attached, every request sent (retries and hedges counted
+    // once, as the caller saw it) is written to its capture file with the
+    // response and timings. hotel_replay plays the file back.
+    void setTrafficRecorder(TrafficRecorder* recorder); // Set before issuing requests
+    // Sends a captured request as it was recorded, without checking the status (hotel_replay)
+    std::optional<cpr::Response> replayRequest(const TrafficRecord& record);
+
     // --- Authentication (Declarations only) ---
     std::optional<User> login(const std::string& email, const std::string& password, const std::string& role = "user");
     bool signup(const std::string& username, const std::string& email, const std::string& password, const std::string& phone, int age);
@@ -51,19 +253,144 @@ public:
     bool updateRoom(int id, const RoomData& roomData);      // PUT /rooms/{id} (Requires Auth)
     bool deleteRoom(int id);                                // DELETE /rooms/{id} (Requires Auth)
 
+    // Room cache: entries younger than the TTL skip the network; older ones are
+    // revalidated with ETag/Last-Modified. A TTL of 0 revalidates on every call.
+    void setRoomCacheTtl(std::chrono::seconds ttl);
+    RoomCache::Stats roomCacheStats() const;
+    // Catalog handover to/from a saved snapshot (SnapshotFile.h). A seeded catalog
+    // is revalidated by the next getRooms, and served as-is while the API is down.
+    std::optional<RoomCache::Catalog> roomCatalog() const;
+    void seedRoomCatalog(const RoomCache::Catalog& catalog);
+
 
     // --- Bookings (Declarations only) ---
     std::optional<Booking> createBooking(const BookingData& bookingData);
-    std::vector<Booking> getBookings();
+    // Group/event reservations: POSTs run in parallel over up to maxConcurrency
+    // pooled connections (0 = all of them); per-item results keep input order.
+    BookingBatchResult createBookings(const std::vector<BookingData>& bookings, size_t maxConcurrency = 0);
+    std::vector<Booking> getBookings(); // Collects every page; prefer bookingPages() for long histories
     std::optional<Booking> getBookingById(int id);
     bool deleteBooking(int id);
 
+    // --- Paginated Listings ---
+    // Cursors follow Laravel pagination (links.next / meta), holding one page at a
+    // time and prefetching the next. perPage > 0 adds ?per_page=N.
+    PageCursor<Booking> bookingPages(int perPage = 0);       // GET /bookings (Requires Auth)
+    PageCursor<Booking> adminBookingPages(int perPage = 0);  // GET /admin/bookings (Requires Auth)
+    PageCursor<Room> adminRoomPages(int perPage = 0);        // GET /admin/rooms (Requires Auth)
+
+    // --- Delta Sync ---
+    // Local replicas of the room list and the user's bookings, refreshed by asking
+    // only for what changed since the last sync (?updated_since=<cursor>). The first
+    // sync, or one whose cursor the server no longer covers, transfers everything,
+    // and so does every sync against an API without updated_since support (no
+    // meta.sync_cursor in the reply): the listing, all pages of it, replaces the
+    // replica and the diff is worked out locally. The diff lists the ids inserted, updated and deleted; ok is false on failure,
+    // and the replica is left as it was. Concurrent syncs of the same replica share one request.
+    SyncDiff syncRooms();    // GET /rooms?updated_since=
+    SyncDiff syncBookings(); // GET /bookings?updated_since= (Requires Auth)
+    const SyncReplica<Room>& roomReplica() const { return room_replica_; }
+    const SyncReplica<Booking>& bookingReplica() const { return booking_replica_; }
+
+    // --- Reservations (Requires Auth) ---
+    // The front desk's view of bookings, with the stay's state changes
+    PageCursor<Booking> reservationPages(int perPage = 0);   // GET /reservations
+    std::optional<Booking> getReservation(int id);
+    std::optional<Booking> checkInReservation(int id);       // POST /reservations/{id}/check-in
+    std::optional<Booking> checkOutReservation(int id);      // POST /reservations/{id}/check-out
+    std::optional<Booking> cancelReservation(int id);        // POST /reservations/{id}/cancel
+
+    // --- Maintenance (Requires Auth) ---
+    PageCursor<MaintenanceTask> maintenanceTaskPages(int perPage = 0); // GET /maintenance/tasks
+    std::optional<MaintenanceTask> getMaintenanceTask(int id);
+    bool completeMaintenanceTask(int id, const std::string& notes = "");
+    // Takes a room out of service or returns it; the API requires notes
+    std::optional<Room> setRoomMaintenance(int roomId, bool underMaintenance, const std::string& notes);
+
+    // --- Payments (Requires Auth) ---
+    std::optional<Payment> createPayment(const PaymentData& payment); // Returns the transaction id and status
+    std::optional<Payment> getPayment(const std::string& transactionId);
+    // A full refund unless amount is given
+    bool refundPayment(const std::string& transactionId, const std::string& reason, std::optional<double> amount = std::nullopt);
+
     // --- User Profile (Declarations only) ---
     std::optional<User> getUserProfile(int id);
     // Note: Pass relevant fields, User struct might contain fields not allowed in update (id, role)
     bool updateUserProfile(int id, const User& userData);
 
 
+    // --- Async Variants ---
+    // Same requests as above, run on the client's worker pool. Each returns a future,
+    // or invokes the callback on a worker thread when done (keep callbacks short).
+    // Page cursors and createBookings have none: they already work in the background.
+    std::future<std::optional<User>> loginAsync(const std::string& email, const std::string& password,
+                                                const std::string& role = "user");
+    std::future<bool> signupAsync(const std::string& username, const std::string& email, const std::string& password,
+                                  const std::string& phone, int age);
+    std::future<bool> logoutAsync();
+
+    std::future<std::vector<Room>> getRoomsAsync();
+    std::future<std::optional<Room>> getRoomByIdAsync(int id);
+    std::future<std::optional<Room>> createRoomAsync(const RoomData& roomData);
+    std::future<bool> updateRoomAsync(int id, const RoomData& roomData);
+    std::future<bool> deleteRoomAsync(int id);
+
+    std::future<std::optional<Booking>> createBookingAsync(const BookingData& bookingData);
+    std::future<std::vector<Booking>> getBookingsAsync();
+    std::future<std::optional<Booking>> getBookingByIdAsync(int id);
+    std::future<bool> deleteBookingAsync(int id);
+
+    std::future<std::optional<Booking>> getReservationAsync(int id);
+    std::future<std::optional<Booking>> checkInReservationAsync(int id);
+    std::future<std::optional<Booking>> checkOutReservationAsync(int id);
+    std::future<std::optional<Booking>> cancelReservationAsync(int id);
+
+    std::future<std::optional<MaintenanceTask>> getMaintenanceTaskAsync(int id);
+    std::future<bool> completeMaintenanceTaskAsync(int id, const std::string& notes = "");
+    std::future<std::optional<Room>> setRoomMaintenanceAsync(int roomId, bool underMaintenance, const std::string& notes);
+
+    std::future<std::optional<Payment>> createPaymentAsync(const PaymentData& payment);
+    std::future<std::optional<Payment>> getPaymentAsync(const std::string& transactionId);
+    std::future<bool> refundPaymentAsync(const std::string& transactionId, const std::string& reason,
+                                         std::optional<double> amount = std::nullopt);
+
+    std::future<std::optional<User>> getUserProfileAsync(int id);
+    std::future<bool> updateUserProfileAsync(int id, const User& userData);
+
+    void loginAsync(const std::string& email, const std::string& password, const std::string& role,
+                    std::function<void(std::optional<User>)> onDone);
+    void signupAsync(const std::string& username, const std::string& email, const std::string& password,
+                     const std::string& phone, int age, std::function<void(bool)> onDone);
+    void logoutAsync(std::function<void(bool)> onDone);
+
+    void getRoomsAsync(std::function<void(std::vector<Room>)> onDone);
+    void getRoomByIdAsync(int id, std::function<void(std::optional<Room>)> onDone);
+    void createRoomAsync(const RoomData& roomData, std::function<void(std::optional<Room>)> onDone);
+    void updateRoomAsync(int id, const RoomData& roomData, std::function<void(bool)> onDone);
+    void deleteRoomAsync(int id, std::function<void(bool)> onDone);
+
+    void createBookingAsync(const BookingData& bookingData, std::function<void(std::optional<Booking>)> onDone);
+    void getBookingsAsync(std::function<void(std::vector<Booking>)> onDone);
+    void getBookingByIdAsync(int id, std::function<void(std::optional<Booking>)> onDone);
+    void deleteBookingAsync(int id, std::function<void(bool)> onDone);
+
+    void getReservationAsync(int id, std::function<void(std::optional<Booking>)> onDone);
+    void checkInReservationAsync(int id, std::function<void(std::optional<Booking>)> onDone);
+    void checkOutReservationAsync(int id, std::function<void(std::optional<Booking>)> onDone);
+    void cancelReservationAsync(int id, std::function<void(std::optional<Booking>)> onDone);
+
+    void getMaintenanceTaskAsync(int id, std::function<void(std::optional<MaintenanceTask>)> onDone);
+    void completeMaintenanceTaskAsync(int id, const std::string& notes, std::function<void(bool)> onDone);
+    void setRoomMaintenanceAsync(int roomId, bool underMaintenance, const std::string& notes,
+                                 std::function<void(std::optional<Room>)> onDone);
+
+    void createPaymentAsync(const PaymentData& payment, std::function<void(std::optional<Payment>)> onDone);
+    void getPaymentAsync(const std::string& transactionId, std::function<void(std::optional<Payment>)> onDone);
+    void refundPaymentAsync(const std::string& transactionId, const std::string& reason, std::optional<double> amount,
+                            std::function<void(bool)> onDone);
+
+    void getUserProfileAsync(int id, std::function<void(std::optional<User>)> onDone);
+    void updateUserProfileAsync(int id, const User& userData, std::function<void(bool)> onDone);
 };
 
 #endif // API_CLIENT_H
\ No newline at end of file
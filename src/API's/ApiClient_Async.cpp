@@ -0,0 +1,240 @@
+// src/ApiClient_Async.cpp
+#include "ApiClient.h"
+#include "DataStructures.h"
+#include <functional>
+#include <future>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// --- Async Implementation ---
+// Each variant runs the blocking method on workers_. Arguments are captured by
+// value because the caller's objects may be gone by the time the job runs.
+
+// --- Authentication ---
+
+std::future<std::optional<User>> ApiClient::loginAsync(const std::string& email, const std::string& password,
+                                                       const std::string& role) {
+    return workers_.submit([this, email, password, role] { return login(email, password, role); });
+}
+
+std::future<bool> ApiClient::signupAsync(const std::string& username, const std::string& email, const std::string& password,
+                                         const std::string& phone, int age) {
+    return workers_.submit([this, username, email, password, phone, age] {
+        return signup(username, email, password, phone, age);
+    });
+}
+
+std::future<bool> ApiClient::logoutAsync() {
+    return workers_.submit([this] { return logout(); });
+}
+
+void ApiClient::loginAsync(const std::string& email, const std::string& password, const std::string& role,
+                           std::function<void(std::optional<User>)> onDone) {
+    workers_.post([this, email, password, role, onDone = std::move(onDone)] { onDone(login(email, password, role)); });
+}
+
+void ApiClient::signupAsync(const std::string& username, const std::string& email, const std::string& password,
+                            const std::string& phone, int age, std::function<void(bool)> onDone) {
+    workers_.post([this, username, email, password, phone, age, onDone = std::move(onDone)] {
+        onDone(signup(username, email, password, phone, age));
+    });
+}
+
+void ApiClient::logoutAsync(std::function<void(bool)> onDone) {
+    workers_.post([this, onDone = std::move(onDone)] { onDone(logout()); });
+}
+
+
+// --- Rooms ---
+
+std::future<std::vector<Room>> ApiClient::getRoomsAsync() {
+    return workers_.submit([this] { return getRooms(); });
+}
+
+std::future<std::optional<Room>> ApiClient::getRoomByIdAsync(int id) {
+    return workers_.submit([this, id] { return getRoomById(id); });
+}
+
+std::future<std::optional<Room>> ApiClient::createRoomAsync(const RoomData& roomData) {
+    return workers_.submit([this, roomData] { return createRoom(roomData); });
+}
+
+std::future<bool> ApiClient::updateRoomAsync(int id, const RoomData& roomData) {
+    return workers_.submit([this, id, roomData] { return updateRoom(id, roomData); });
+}
+
+std::future<bool> ApiClient::deleteRoomAsync(int id) {
+    return workers_.submit([this, id] { return deleteRoom(id); });
+}
+
+void ApiClient::getRoomsAsync(std::function<void(std::vector<Room>)> onDone) {
+    workers_.post([this, onDone = std::move(onDone)] { onDone(getRooms()); });
+}
+
+void ApiClient::getRoomByIdAsync(int id, std::function<void(std::optional<Room>)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(getRoomById(id)); });
+}
+
+void ApiClient::createRoomAsync(const RoomData& roomData, std::function<void(std::optional<Room>)> onDone) {
+    workers_.post([this, roomData, onDone = std::move(onDone)] { onDone(createRoom(roomData)); });
+}
+
+void ApiClient::updateRoomAsync(int id, const RoomData& roomData, std::function<void(bool)> onDone) {
+    workers_.post([this, id, roomData, onDone = std::move(onDone)] { onDone(updateRoom(id, roomData)); });
+}
+
+void ApiClient::deleteRoomAsync(int id, std::function<void(bool)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(deleteRoom(id)); });
+}
+
+
+// --- Bookings ---
+
+std::future<std::optional<Booking>> ApiClient::createBookingAsync(const BookingData& bookingData) {
+    return workers_.submit([this, bookingData] { return createBooking(bookingData); });
+}
+
+std::future<std::vector<Booking>> ApiClient::getBookingsAsync() {
+    return workers_.submit([this] { return getBookings(); });
+}
+
+std::future<std::optional<Booking>> ApiClient::getBookingByIdAsync(int id) {
+    return workers_.submit([this, id] { return getBookingById(id); });
+}
+
+std::future<bool> ApiClient::deleteBookingAsync(int id) {
+    return workers_.submit([this, id] { return deleteBooking(id); });
+}
+
+void ApiClient::createBookingAsync(const BookingData& bookingData, std::function<void(std::optional<Booking>)> onDone) {
+    workers_.post([this, bookingData, onDone = std::move(onDone)] { onDone(createBooking(bookingData)); });
+}
+
+void ApiClient::getBookingsAsync(std::function<void(std::vector<Booking>)> onDone) {
+    workers_.post([this, onDone = std::move(onDone)] { onDone(getBookings()); });
+}
+
+void ApiClient::getBookingByIdAsync(int id, std::function<void(std::optional<Booking>)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(getBookingById(id)); });
+}
+
+void ApiClient::deleteBookingAsync(int id, std::function<void(bool)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(deleteBooking(id)); });
+}
+
+
+// --- Reservations ---
+
+std::future<std::optional<Booking>> ApiClient::getReservationAsync(int id) {
+    return workers_.submit([this, id] { return getReservation(id); });
+}
+
+std::future<std::optional<Booking>> ApiClient::checkInReservationAsync(int id) {
+    return workers_.submit([this, id] { return checkInReservation(id); });
+}
+
+std::future<std::optional<Booking>> ApiClient::checkOutReservationAsync(int id) {
+    return workers_.submit([this, id] { return checkOutReservation(id); });
+}
+
+std::future<std::optional<Booking>> ApiClient::cancelReservationAsync(int id) {
+    return workers_.submit([this, id] { return cancelReservation(id); });
+}
+
+void ApiClient::getReservationAsync(int id, std::function<void(std::optional<Booking>)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(getReservation(id)); });
+}
+
+void ApiClient::checkInReservationAsync(int id, std::function<void(std::optional<Booking>)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(checkInReservation(id)); });
+}
+
+void ApiClient::checkOutReservationAsync(int id, std::function<void(std::optional<Booking>)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(checkOutReservation(id)); });
+}
+
+void ApiClient::cancelReservationAsync(int id, std::function<void(std::optional<Booking>)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(cancelReservation(id)); });
+}
+
+
+// --- Maintenance ---
+
+std::future<std::optional<MaintenanceTask>> ApiClient::getMaintenanceTaskAsync(int id) {
+    return workers_.submit([this, id] { return getMaintenanceTask(id); });
+}
+
+std::future<bool> ApiClient::completeMaintenanceTaskAsync(int id, const std::string& notes) {
+    return workers_.submit([this, id, notes] { return completeMaintenanceTask(id, notes); });
+}
+
+std::future<std::optional<Room>> ApiClient::setRoomMaintenanceAsync(int roomId, bool underMaintenance, const std::string& notes) {
+    return workers_.submit([this, roomId, underMaintenance, notes] { return setRoomMaintenance(roomId, underMaintenance, notes); });
+}
+
+void ApiClient::getMaintenanceTaskAsync(int id, std::function<void(std::optional<MaintenanceTask>)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(getMaintenanceTask(id)); });
+}
+
+void ApiClient::completeMaintenanceTaskAsync(int id, const std::string& notes, std::function<void(bool)> onDone) {
+    workers_.post([this, id, notes, onDone = std::move(onDone)] { onDone(completeMaintenanceTask(id, notes)); });
+}
+
+void ApiClient::setRoomMaintenanceAsync(int roomId, bool underMaintenance, const std::string& notes,
+                                        std::function<void(std::optional<Room>)> onDone) {
+    workers_.post([this, roomId, underMaintenance, notes, onDone = std::move(onDone)] {
+        onDone(setRoomMaintenance(roomId, underMaintenance, notes));
+    });
+}
+
+
+// --- Payments ---
+
+std::future<std::optional<Payment>> ApiClient::createPaymentAsync(const PaymentData& payment) {
+    return workers_.submit([this, payment] { return createPayment(payment); });
+}
+
+std::future<std::optional<Payment>> ApiClient::getPaymentAsync(const std::string& transactionId) {
+    return workers_.submit([this, transactionId] { return getPayment(transactionId); });
+}
+
+std::future<bool> ApiClient::refundPaymentAsync(const std::string& transactionId, const std::string& reason,
+                                                std::optional<double> amount) {
+    return workers_.submit([this, transactionId, reason, amount] { return refundPayment(transactionId, reason, amount); });
+}
+
+void ApiClient::createPaymentAsync(const PaymentData& payment, std::function<void(std::optional<Payment>)> onDone) {
+    workers_.post([this, payment, onDone = std::move(onDone)] { onDone(createPayment(payment)); });
+}
+
+void ApiClient::getPaymentAsync(const std::string& transactionId, std::function<void(std::optional<Payment>)> onDone) {
+    workers_.post([this, transactionId, onDone = std::move(onDone)] { onDone(getPayment(transactionId)); });
+}
+
+void ApiClient::refundPaymentAsync(const std::string& transactionId, const std::string& reason, std::optional<double> amount,
+                                   std::function<void(bool)> onDone) {
+    workers_.post([this, transactionId, reason, amount, onDone = std::move(onDone)] {
+        onDone(refundPayment(transactionId, reason, amount));
+    });
+}
+
+
+// --- User Profile ---
+
+std::future<std::optional<User>> ApiClient::getUserProfileAsync(int id) {
+    return workers_.submit([this, id] { return getUserProfile(id); });
+}
+
+std::future<bool> ApiClient::updateUserProfileAsync(int id, const User& userData) {
+    return workers_.submit([this, id, userData] { return updateUserProfile(id, userData); });
+}
+
+void ApiClient::getUserProfileAsync(int id, std::function<void(std::optional<User>)> onDone) {
+    workers_.post([this, id, onDone = std::move(onDone)] { onDone(getUserProfile(id)); });
+}
+
+void ApiClient::updateUserProfileAsync(int id, const User& userData, std::function<void(bool)> onDone) {
+    workers_.post([this, id, userData, onDone = std::move(onDone)] { onDone(updateUserProfile(id, userData)); });
+}
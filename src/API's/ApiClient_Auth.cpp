@@ -1,39 +1,49 @@
 // src/ApiClient_Auth.cpp
 #include "ApiClient.h"
+#include "EndpointCall.h"
+#include "Logger.h"
 #include <nlohmann/json.hpp>
-#include <iostream>
 #include <optional>
 
 using json = nlohmann::json;
 
 // --- Authentication Implementation ---
 
-bool ApiClient::login(const std::string& email, const std::string& password, const std::string& role) {
+std::optional<User> ApiClient::login(const std::string& email, const std::string& password, const std::string& role) {
     json payload = {
         {"email", email},
-        {"password", password}
-         {"role", role} // Add only if backend requires it
+        {"password", password},
+        {"role", role} // Add only if backend requires it
     };
-    std::cout << "[API Request] POST /login" << std::endl;
-
-    // Use the central performRequest helper
-    std::optional<json> response_json_opt = performRequest("POST", "/login", 200, false, payload);
+    std::optional<json> response_json_opt = call<endpoints::login>(endpoints::login.pattern, payload.dump());
 
     if (!response_json_opt) {
-        auth_token_.clear();
-        return false;
+        setAuthToken("");
+        return std::nullopt;
     }
 
     json response_json = response_json_opt.value();
-    if (response_json.contains("token") && response_json["token"].is_string()) {
-        auth_token_ = response_json["token"];
-        std::cout << "[Auth] Login successful. Token stored." << std::endl;
-        return true;
-    } else {
-        std::cerr << "[Auth Error] Login succeeded (status 200) but token not found in response." << std::endl;
-        auth_token_.clear();
-        return false;
+    if (!response_json.contains("token") || !response_json["token"].is_string()) {
+        LOG_ERROR("[Auth Error] Login succeeded (status 200) but token not found in response.");
+        setAuthToken("");
+        return std::nullopt;
     }
+
+    // Prefer the user object returned by the API; fall back to what we know locally
+    User user;
+    user.email = email;
+    user.role = role;
+    if (response_json.contains("user") && response_json["user"].is_object()) {
+        try {
+            user = response_json["user"].get<User>();
+        } catch (json::exception& e) {
+            LOG_ERROR("[JSON Error] Failed to convert logged in user data: " << e.what());
+        }
+    }
+    // The user id goes with the token: queued offline writes are replayed only under it
+    setAuthToken(response_json["token"].get<std::string>(), Credentials{email, password, role}, user.id);
+    LOG_INFO("[Auth] Login successful. Token stored.");
+    return user;
 }
 
 bool ApiClient::signup(const std::string& username, const std::string& email, const std::string& password, const std::string& phone, int age) {
@@ -45,51 +55,39 @@ bool ApiClient::signup(const std::string& username, const std::string& email, co
         {"phone", phone},
         {"age", age}
     };
-    std::cout << "[API Request] POST /signup" << std::endl;
-
-    std::optional<json> response_json_opt = performRequest("POST", "/signup", 201, false, payload);
+    std::optional<json> response_json_opt = call<endpoints::signup>(endpoints::signup.pattern, payload.dump());
 
      if (!response_json_opt) {
-        return false; // Error logged in handleResponse via performRequest
+        return false; // Error logged by call()
     }
 
     json response_json = response_json_opt.value();
     if (response_json.contains("token") && response_json["token"].is_string()) {
-         auth_token_ = response_json["token"];
-         std::cout << "[Auth] Signup successful. User automatically logged in." << std::endl;
+         int userId = 0;
+         const json& user = response_json.contains("user") ? response_json["user"] : json();
+         if (user.is_object() && user.contains("id") && user["id"].is_number_integer()) userId = user["id"].get<int>();
+         setAuthToken(response_json["token"].get<std::string>(), Credentials{email, password, "user"}, userId);
+         LOG_INFO("[Auth] Signup successful. User automatically logged in.");
     } else {
-         std::cout << "[Auth] Signup successful. User created, please login separately." << std::endl;
+         LOG_INFO("[Auth] Signup successful. User created, please login separately.");
     }
     return true;
 }
 
 bool ApiClient::logout() {
     if (!isAuthenticated()) {
-        std::cerr << "[Auth Error] Cannot logout: No user is currently authenticated." << std::endl;
+        LOG_ERROR("[Auth Error] Cannot logout: No user is currently authenticated.");
         return true; // Already in desired state
     }
-    std::cout << "[API Request] POST /logout" << std::endl;
-
-    // Logout might return 200 or 204. We check for 204 first as it's common.
-    // performRequest handles logging if the status is unexpected.
-    std::optional<json> response_json_opt = performRequest("POST", "/logout", 204, true); // Try 204 first
-     if (!response_json_opt) {
-         // If 204 failed, maybe backend returns 200? Let's try again (optional, depends on API)
-          std::cout << "[Auth Info] Logout didn't return 204, checking for 200..." << std::endl;
-          response_json_opt = performRequest("POST", "/logout", 200, true);
-          if (!response_json_opt) {
-               std::cerr << "[Auth Warning] Logout request failed on server. Clearing token locally." << std::endl;
-          } else {
-               std::cout << "[Auth] Logout successful on server (returned 200)." << std::endl;
-          }
-
-     } else {
-          std::cout << "[Auth] Logout successful on server (returned 204)." << std::endl;
-     }
-
+    // Logout may answer 200 or 204; the POST carries an empty JSON object as its body
+    if (!call<endpoints::logout>(endpoints::logout.pattern)) {
+        LOG_WARN("[Auth Warning] Logout request failed on server. Clearing token locally.");
+    } else {
+        LOG_INFO("[Auth] Logout successful on server.");
+    }
 
     // Always clear the token locally on logout attempt
-    auth_token_.clear();
-    std::cout << "[Auth] Local token cleared." << std::endl;
+    setAuthToken("");
+    LOG_INFO("[Auth] Local token cleared.");
     return true;
 }
\ No newline at end of file
@@ -1,10 +1,17 @@
 // src/ApiClient_Bookings.cpp
 #include "ApiClient.h"
 #include "DataStructures.h"
+#include "EndpointCall.h"
+#include "JsonStreamDecoder.h"
+#include "Logger.h"
+#include <cpr/cpr.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <vector>
 #include <optional>
-#include <iostream>
 #include <string> // Needed for std::to_string
 
 using json = nlohmann::json;
@@ -12,114 +19,138 @@ using json = nlohmann::json;
 // --- Bookings Implementation ---
 
 std::optional<Booking> ApiClient::createBooking(const BookingData& bookingData) {
+    std::string error;
+    return submitBooking(bookingData, error);
+}
+
+// createBooking with the failure reason reported back, for batch results
+std::optional<Booking> ApiClient::submitBooking(const BookingData& bookingData, std::string& error) {
     if (!isAuthenticated()) {
-        std::cerr << "[Booking Error] Authentication required to create a booking." << std::endl;
+        LOG_ERROR("[Booking Error] Authentication required to create a booking.");
+        error = "not authenticated";
         return std::nullopt;
     }
-    std::cout << "[API Request] POST /bookings" << std::endl;
-    json payload = bookingData; // Convert BookingData struct to JSON
+    LOG_DEBUG("[API Request] POST /bookings");
+    // Serialize straight into this thread's reusable body buffer (no json DOM)
+    std::string& body = RequestBuilder::forThisThread().body();
+    JsonWriter writer(body);
+    writeJson(writer, bookingData);
 
     // Expect HTTP 201 Created for successful booking creation
-    std::optional<json> response_json_opt = performRequest("POST", "/bookings", 201, true, payload);
-
-    if (!response_json_opt) {
-        return std::nullopt; // Error logged by performRequest/handleResponse
+    std::optional<cpr::Response> response = sendMutation(endpoints::createBooking.method, endpoints::createBooking.pattern, body);
+    if (!response) {
+        error = "request could not be sent";
+        return std::nullopt;
+    }
+    if (lastWriteQueued()) {
+        error = "API unreachable, queued for replay";
+        return std::nullopt;
+    }
+    if (!checkResponse(response.value(), endpoints::createBooking.expected)) {
+        // Details were logged by checkResponse; keep a short reason per item
+        error = response->error ? "network error: " + response->error.message
+                                : "HTTP " + std::to_string(response->status_code);
+        return std::nullopt;
     }
 
-    json response_json = response_json_opt.value();
     // Expect the created booking object wrapped in 'data'
-    if (response_json.contains("data") && response_json["data"].is_object()) {
-         try {
-            // Parse the response back into a full Booking struct
-            return response_json["data"].get<Booking>();
-        } catch (json::exception& e) {
-             std::cerr << "[JSON Error] Failed to parse created booking response: " << e.what() << std::endl;
-             return std::nullopt;
+    Booking booking;
+    std::string decodeError;
+    RequestMetrics::ParseTimer parseTimer(metrics_, "POST", endpoints::createBooking.pattern);
+    if (!decodeDataObject(response->text, booking, decodeError)) {
+         LOG_ERROR("[JSON Error] Failed to parse created booking response: " << decodeError);
+         error = "invalid response: " + decodeError;
+         return std::nullopt;
+    }
+    return booking;
+}
+
+BookingBatchResult ApiClient::createBookings(const std::vector<BookingData>& bookings, size_t maxConcurrency) {
+    BookingBatchResult result;
+    result.items.resize(bookings.size());
+    auto started = std::chrono::steady_clock::now();
+
+    // Each lane claims the next unsent index, so results land in input order
+    std::atomic<size_t> nextIndex{0};
+    auto lane = [this, &bookings, &result, &nextIndex] {
+        for (size_t i = nextIndex.fetch_add(1); i < bookings.size(); i = nextIndex.fetch_add(1)) {
+            BookingBatchItem& item = result.items[i];
+            item.booking = submitBooking(bookings[i], item.error);
         }
+    };
+
+    size_t lanes = maxConcurrency == 0 ? workers_.threadCount() : std::min(maxConcurrency, workers_.threadCount());
+    lanes = std::min(lanes, bookings.size());
+    if (lanes <= 1 || workers_.isWorkerThread()) {
+        lane(); // Sequential (also avoids waiting on our own pool from a worker)
     } else {
-         std::cerr << "[API Error] Expected 'data' object in booking creation response." << std::endl;
-         return std::nullopt;
+        LOG_INFO("[Booking] Submitting " << bookings.size() << " bookings over " << lanes << " connections.");
+        std::vector<std::future<void>> running;
+        running.reserve(lanes);
+        for (size_t i = 0; i < lanes; ++i) running.push_back(workers_.submit(lane));
+        for (auto& f : running) f.get();
     }
+
+    result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    for (const auto& item : result.items) {
+        if (item.ok()) ++result.succeeded; else ++result.failed;
+    }
+    if (result.elapsedSeconds > 0) {
+        result.bookingsPerSecond = static_cast<double>(result.succeeded) / result.elapsedSeconds;
+    }
+    LOG_INFO("[Booking] Batch done: " << result.succeeded << " created, " << result.failed << " failed in "
+             << result.elapsedSeconds << "s (" << result.bookingsPerSecond << " bookings/s).");
+    return result;
 }
 
 std::vector<Booking> ApiClient::getBookings() {
      if (!isAuthenticated()) {
-        std::cerr << "[Booking Error] Authentication required to view bookings." << std::endl;
+        LOG_ERROR("[Booking Error] Authentication required to view bookings.");
         return {};
     }
-     std::cout << "[API Request] GET /bookings" << std::endl;
-     // Backend should filter bookings based on authenticated user/role
-     std::optional<json> response_json_opt = performRequest("GET", "/bookings", 200, true);
-
-    if (!response_json_opt) return {}; // Return empty vector on error
+    return *booking_list_flights_.run(flightKey(HttpMethod::Get, "/bookings", true), [this] { return fetchBookings(); });
+}
 
-    json response_json = response_json_opt.value();
-    // Expect Laravel collection resource format: { "data": [ ... ] }
-    if (response_json.contains("data") && response_json["data"].is_array()) {
-        try {
-            return response_json["data"].get<std::vector<Booking>>();
-        } catch (json::exception& e) {
-             std::cerr << "[JSON Error] Failed to convert booking list data: " << e.what() << std::endl;
-             return {};
-        }
-    } else {
-        std::cerr << "[API Error] Expected 'data' array in /bookings response." << std::endl;
-        return {};
-    }
+std::vector<Booking> ApiClient::fetchBookings() {
+     // Backend should filter bookings based on authenticated user/role.
+     // Walk every page so paginated responses are returned in full.
+     std::vector<Booking> bookings;
+     PageCursor<Booking> cursor = bookingPages();
+     while (std::optional<Booking> booking = cursor.next()) {
+         bookings.push_back(std::move(booking.value()));
+     }
+     if (cursor.failed()) return {}; // Return empty vector on error (logged by fetchPage)
+     return bookings;
 }
 
 std::optional<Booking> ApiClient::getBookingById(int id) {
     if (!isAuthenticated()) {
-        std::cerr << "[Booking Error] Authentication required to view a specific booking." << std::endl;
+        LOG_ERROR("[Booking Error] Authentication required to view a specific booking.");
         return std::nullopt;
     }
-    std::string path = "/bookings/" + std::to_string(id);
-    std::cout << "[API Request] GET " << path << std::endl;
-    // Backend must enforce authorization (can user view this specific booking?)
-    std::optional<json> response_json_opt = performRequest("GET", path, 200, true);
-
-    if (!response_json_opt) return std::nullopt;
+    RequestPath path("/bookings/", id);
+    return *booking_flights_.run(flightKey(HttpMethod::Get, path, true), [this, id] { return fetchBookingById(id); });
+}
 
-    json response_json = response_json_opt.value();
-    // Expect Laravel single resource format: { "data": { ... } }
-    if (response_json.contains("data") && response_json["data"].is_object()) {
-         try {
-            return response_json["data"].get<Booking>();
-        } catch (json::exception& e) {
-             std::cerr << "[JSON Error] Failed to convert booking data for ID " << id << ": " << e.what() << std::endl;
-             return std::nullopt;
-        }
-    } else {
-        std::cerr << "[API Error] Expected 'data' object in " << path << " response." << std::endl;
-        return std::nullopt;
-    }
+std::optional<Booking> ApiClient::fetchBookingById(int id) {
+    // Backend must enforce authorization (can user view this specific booking?)
+    // Hedged (see endpoints::getBooking): a stalled backend node shouldn't hold up a single-booking lookup
+    return call<endpoints::getBooking>(endpointPath<endpoints::getBooking>(id));
 }
 
 bool ApiClient::deleteBooking(int id) {
     if (!isAuthenticated()) {
-        std::cerr << "[Booking Error] Authentication required to delete a booking." << std::endl;
+        LOG_ERROR("[Booking Error] Authentication required to delete a booking.");
         return false;
     }
-    std::string path = "/bookings/" + std::to_string(id);
-    std::cout << "[API Request] DELETE " << path << std::endl;
     // Backend must enforce authorization
-
-    // Expect 204 No Content or maybe 200 OK for successful deletion
-    std::optional<json> response_json_opt = performRequest("DELETE", path, 204, true); // Try 204 first
-
-     if (!response_json_opt) {
-          // If 204 failed, maybe the backend returns 200 OK?
-          std::cout << "[Booking Info] Delete didn't return 204, checking for 200..." << std::endl;
-          response_json_opt = performRequest("DELETE", path, 200, true);
-     }
-
-    // Check if either attempt resulted in success (returned a value)
-    if (response_json_opt.has_value()) {
-         std::cout << "[Booking] Successfully deleted booking ID: " << id << std::endl;
+    // Expect 204 No Content or 200 OK for successful deletion
+    if (call<endpoints::deleteBooking>(endpointPath<endpoints::deleteBooking>(id))) {
+         LOG_INFO("[Booking] Successfully deleted booking ID: " << id);
          return true;
     } else {
-         // Error message was already logged by performRequest/handleResponse
-         std::cerr << "[Booking Error] Failed to delete booking ID: " << id << std::endl;
+         // Error message was already logged by call()
+         LOG_ERROR("[Booking Error] Failed to delete booking ID: " << id);
          return false;
     }
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+// src/ApiClient_Capture.cpp
+#include "ApiClient.h"
+#include "Logger.h"
+#include "TrafficCapture.h"
+#include <cpr/cpr.h>
+#include <optional>
+#include <string>
+
+// --- Traffic Capture Implementation ---
+
+namespace {
+
+// The response headers the client acts on; the rest aren't worth the bytes
+const char* const kRecordedHeaders[] = {"Content-Type", "ETag", "Last-Modified", "Retry-After"};
+
+} // namespace
+
+void ApiClient::setTrafficRecorder(TrafficRecorder* recorder) {
+    recorder_ = recorder;
+}
+
+void ApiClient::recordTraffic(uint64_t started, HttpMethod method, std::string_view path, bool requiresAuth,
+                              std::string_view body, const std::optional<cpr::Response>& response) {
+    if (!response) {
+        recorder_->record(started, method, path, requiresAuth, body, 0, 0, {}, {});
+        return;
+    }
+    thread_local std::string headers;
+    headers.clear();
+    for (const char* name : kRecordedHeaders) {
+        auto found = response->header.find(name);
+        if (found == response->header.end()) continue;
+        headers.append(name).append(": ").append(found->second).push_back('\n');
+    }
+    int status = response->error ? 0 : static_cast<int>(response->status_code);
+    auto transferMicros = static_cast<uint64_t>(response->elapsed * 1e6);
+    recorder_->record(started, method, path, requiresAuth, body, status, transferMicros, headers, response->text);
+}
+
+std::optional<cpr::Response> ApiClient::replayRequest(const TrafficRecord& record) {
+    LOG_DEBUG("[Replay] " << methodName(record.method) << " " << record.path);
+    std::string_view body = record.requestBody;
+    // Redacted logins/signups still need a body to be sent at all
+    if (body.empty() && (record.method == HttpMethod::Post || record.method == HttpMethod::Put)) body = "{}";
+    return sendSerialized(record.method, record.path, record.requiresAuth, body);
+}
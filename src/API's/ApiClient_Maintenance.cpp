@@ -0,0 +1,46 @@
+// src/ApiClient_Maintenance.cpp
+#include "ApiClient.h"
+#include "DataStructures.h"
+#include "EndpointCall.h"
+#include "Logger.h"
+#include <optional>
+#include <string>
+
+// --- Maintenance Implementation ---
+// The task listing is in ApiClient_Pagination.cpp (maintenanceTaskPages)
+
+std::optional<MaintenanceTask> ApiClient::getMaintenanceTask(int id) {
+    return call<endpoints::getMaintenanceTask>(endpointPath<endpoints::getMaintenanceTask>(id));
+}
+
+bool ApiClient::completeMaintenanceTask(int id, const std::string& notes) {
+    std::string& body = RequestBuilder::forThisThread().body();
+    if (!notes.empty()) JsonWriter(body).beginObject().field("notes", notes).endObject();
+
+    // The API answers with the bare task (no "data" envelope), so only the status is checked
+    if (!call<endpoints::completeMaintenanceTask>(endpointPath<endpoints::completeMaintenanceTask>(id), body)) {
+        LOG_ERROR("[Maintenance Error] Failed to complete task ID: " << id);
+        return false;
+    }
+    LOG_INFO("[Maintenance] Completed task ID: " << id);
+    return true;
+}
+
+std::optional<Room> ApiClient::setRoomMaintenance(int roomId, bool underMaintenance, const std::string& notes) {
+    std::string& body = RequestBuilder::forThisThread().body();
+    JsonWriter(body).beginObject()
+        .field("status", underMaintenance ? "under_maintenance" : "available")
+        .field("notes", notes)
+        .endObject();
+
+    std::optional<Room> room = call<endpoints::setRoomMaintenance>(endpointPath<endpoints::setRoomMaintenance>(roomId), body);
+    if (!room) {
+        LOG_ERROR("[Maintenance Error] Failed to change maintenance status of room ID: " << roomId);
+        return std::nullopt;
+    }
+    // The room's status shows in both the single-room entry and the catalog
+    room_cache_.invalidateRoom(roomId);
+    room_cache_.invalidateList();
+    LOG_INFO("[Maintenance] Room ID " << roomId << (underMaintenance ? " taken out of service." : " back in service."));
+    return room;
+}
@@ -0,0 +1,151 @@
+// src/ApiClient_Offline.cpp
+#include "ApiClient.h"
+#include "Logger.h"
+#include <cpr/cpr.h>
+#include <nlohmann/json.hpp>
+#include <array>
+#include <charconv>
+#include <random>
+#include <string>
+
+using json = nlohmann::json;
+
+// --- Offline Writes Implementation ---
+
+namespace {
+
+thread_local bool lastWriteWasQueued = false;
+
+// The request never left this machine (no host, no connection), so the API can't
+// have applied it. The API ignores Idempotency-Key, so only these writes are safe
+// to queue: one that timed out or lost its response may already be booked.
+bool neverSent(const cpr::Response& response) {
+    switch (response.error.code) {
+        case cpr::ErrorCode::COULDNT_RESOLVE_PROXY:
+        case cpr::ErrorCode::COULDNT_RESOLVE_HOST:
+        case cpr::ErrorCode::COULDNT_CONNECT:
+        case cpr::ErrorCode::SSL_CONNECT_ERROR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// A queued write the API turned away without acting on it, and may take later
+bool isTemporaryRejection(const cpr::Response& response) {
+    return neverSent(response) || response.status_code == 401 || // 401: token expired, wait for a login
+           response.status_code == 408 || response.status_code == 429 || response.status_code == 503;
+}
+
+} // namespace
+
+void ApiClient::setMutationJournal(MutationJournal* journal) {
+    journal_ = journal;
+}
+
+bool ApiClient::lastWriteQueued() const {
+    return lastWriteWasQueued;
+}
+
+// 128 random bits as hex: unique per write, reused by every replay of it
+std::string_view ApiClient::newIdempotencyKey(std::array<char, 32>& buffer) {
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    static const char hex[] = "0123456789abcdef";
+    for (size_t half = 0; half < 2; ++half) {
+        uint64_t bits = rng();
+        for (size_t i = 0; i < 16; ++i) buffer[half * 16 + i] = hex[(bits >> (60 - 4 * i)) & 0xF];
+    }
+    return std::string_view(buffer.data(), buffer.size());
+}
+
+std::optional<cpr::Response> ApiClient::sendMutation(HttpMethod method, std::string_view path, std::string_view body) {
+    lastWriteWasQueued = false;
+    // Sent on the first attempt too, for an API that dedupes on it (ours doesn't
+    // yet, hence neverSent()). The header map is kept per thread and its value
+    // overwritten in place, so this allocates nothing.
+    std::array<char, 32> buffer;
+    std::string_view key = newIdempotencyKey(buffer);
+    thread_local cpr::Header headers{{"Idempotency-Key", std::string(32, '0')}};
+    headers.begin()->second.assign(key.data(), key.size());
+    int userId = tokens_.current()->userId;
+    std::optional<cpr::Response> response = sendSerialized(method, path, true, body, &headers);
+    // Without a user id the entry couldn't be kept from whoever logs in next
+    if (!response || !journal_ || !neverSent(*response) || userId == 0) return response;
+
+    uint64_t sequence = journal_->append(userId, methodName(method), path, key, body);
+    if (sequence != 0 && journal_->waitDurable(sequence)) {
+        lastWriteWasQueued = true;
+        LOG_WARN("[Offline] " << methodName(method) << " " << path << " could not reach the API ("
+                 << (response->error ? response->error.message : "HTTP " + std::to_string(response->status_code))
+                 << "); saved as queued write #" << sequence);
+    } else {
+        LOG_ERROR("[Offline] " << methodName(method) << " " << path << " could not be saved to the journal either");
+    }
+    return response;
+}
+
+size_t ApiClient::queuedWrites() const {
+    int userId = tokens_.current()->userId;
+    return journal_ && userId != 0 ? journal_->pendingCount(userId) : 0;
+}
+
+size_t ApiClient::replayJournal() {
+    int userId = tokens_.current()->userId;
+    if (!journal_ || userId == 0) return 0;
+    std::lock_guard<std::mutex> lock(replay_mutex_);
+
+    // Only this user's writes, sent with their token; anyone else's stay queued for them
+    size_t delivered = 0;
+    for (const JournalEntry& entry : journal_->pending(userId)) {
+        if (tokens_.current()->userId != userId) break; // Logged out or switched user mid-replay
+        if (!json::accept(entry.body)) {
+            LOG_ERROR("[Offline] Dropping queued write #" << entry.sequence << ": body is not valid JSON");
+            journal_->ack(entry.sequence);
+            continue;
+        }
+        std::optional<HttpMethod> method = parseMethod(entry.method);
+        if (!method) {
+            LOG_ERROR("[Offline] Dropping queued write #" << entry.sequence << ": unsupported method " << entry.method);
+            journal_->ack(entry.sequence);
+            continue;
+        }
+        LOG_DEBUG("[API Request] " << entry.method << " " << entry.path << " (queued write #" << entry.sequence << ")");
+        cpr::Header headers{{"Idempotency-Key", entry.idempotencyKey}};
+        std::optional<cpr::Response> response = sendSerialized(*method, entry.path, true, entry.body, &headers);
+        if (!response) {
+            LOG_ERROR("[Offline] Dropping queued write #" << entry.sequence << ": it could not be sent");
+            journal_->ack(entry.sequence);
+            continue;
+        }
+        if (isTemporaryRejection(*response)) {
+            // Keep the order: later writes may depend on this one
+            LOG_DEBUG("[Offline] API not taking writes yet (" << (response->error ? response->error.message
+                      : "HTTP " + std::to_string(response->status_code)) << "); " << journal_->pendingCount(userId) << " still queued");
+            break;
+        }
+
+        if (response->status_code >= 200 && response->status_code < 300) {
+            ++delivered;
+            LOG_INFO("[Offline] Delivered queued write #" << entry.sequence << ": " << entry.method << " " << entry.path);
+            // Room writes change what the room cache holds
+            const std::string roomPrefix = "/rooms/";
+            int roomId = 0;
+            if (entry.path.compare(0, roomPrefix.size(), roomPrefix) == 0 &&
+                std::from_chars(entry.path.data() + roomPrefix.size(), entry.path.data() + entry.path.size(), roomId).ec == std::errc()) {
+                room_cache_.invalidateRoom(roomId);
+            }
+        } else if (response->error || response->status_code >= 500) {
+            // It may have been applied before the failure; sending it again could book twice
+            LOG_ERROR("[Offline] Queued write #" << entry.sequence << " (" << entry.method << " " << entry.path << ") failed with "
+                      << (response->error ? response->error.message : "HTTP " + std::to_string(response->status_code))
+                      << " and may or may not have been applied; not sending it again");
+        } else {
+            // The API saw it and said no (validation, conflict, gone): replaying won't change that
+            checkResponse(*response, 200); // Logs the API's reason
+            LOG_ERROR("[Offline] Queued write #" << entry.sequence << " (" << entry.method << " " << entry.path
+                      << ") was rejected with HTTP " << response->status_code << "; dropping it");
+        }
+        journal_->ack(entry.sequence);
+    }
+    return delivered;
+}
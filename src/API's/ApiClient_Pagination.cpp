@@ -0,0 +1,103 @@
+// src/ApiClient_Pagination.cpp
+#include "ApiClient.h"
+#include "DataStructures.h"
+#include "JsonStreamDecoder.h"
+#include "Logger.h"
+#include "PageCursor.h"
+#include <cpr/cpr.h>
+#include <optional>
+#include <string>
+
+// --- Pagination Implementation ---
+
+namespace {
+
+// Set (or replace) a query parameter on a relative path
+std::string withQueryParam(const std::string& path, const std::string& name, int value) {
+    std::string needle = name + "=";
+    size_t query = path.find('?');
+    if (query != std::string::npos) {
+        size_t pos = path.find(needle, query);
+        while (pos != std::string::npos && path[pos - 1] != '?' && path[pos - 1] != '&') {
+            pos = path.find(needle, pos + 1);
+        }
+        if (pos != std::string::npos) {
+            size_t end = path.find('&', pos);
+            return path.substr(0, pos) + needle + std::to_string(value) +
+                   (end == std::string::npos ? "" : path.substr(end));
+        }
+    }
+    return path + (query == std::string::npos ? "?" : "&") + needle + std::to_string(value);
+}
+
+std::string firstPagePath(const std::string& path, int perPage) {
+    return perPage > 0 ? withQueryParam(path, "per_page", perPage) : path;
+}
+
+} // namespace
+
+// Relative path of the page after `path`, from links.next or, failing that, meta
+std::string ApiClient::nextPagePath(const std::string& path, const PageInfo& info) const {
+    if (!info.next.empty()) {
+        // Laravel returns absolute URLs; keep only the part below our base URL
+        if (info.next.compare(0, base_url_.size(), base_url_) == 0) {
+            return info.next.substr(base_url_.size());
+        }
+        if (info.next.front() == '/') {
+            return info.next;
+        }
+        LOG_WARN("[Pagination Warning] links.next points outside " << base_url_ << ": " << info.next);
+    }
+    if (info.currentPage > 0 && info.currentPage < info.lastPage) {
+        return withQueryParam(path, "page", info.currentPage + 1);
+    }
+    return ""; // Last page
+}
+
+template <typename T>
+Page<T> ApiClient::fetchPage(const std::string& path, bool requiresAuth) {
+    Page<T> page;
+    LOG_DEBUG("[API Request] GET " << path);
+    std::optional<cpr::Response> response = performRawRequest(HttpMethod::Get, path, 200, requiresAuth);
+    if (!response) return page; // Error logged by performRawRequest
+
+    std::string decodeError;
+    RequestMetrics::ParseTimer parseTimer(metrics_, "GET", path);
+    if (!decodeDataArray(response->text, page.items, decodeError, &page.info)) {
+        LOG_ERROR("[JSON Error] Failed to convert page " << path << ": " << decodeError);
+        return page;
+    }
+    page.ok = true;
+    page.nextPath = nextPagePath(path, page.info);
+    return page;
+}
+
+PageCursor<Booking> ApiClient::bookingPages(int perPage) {
+    return PageCursor<Booking>(
+        [this](const std::string& path) { return fetchPage<Booking>(path, true); },
+        firstPagePath("/bookings", perPage), &workers_);
+}
+
+PageCursor<Booking> ApiClient::adminBookingPages(int perPage) {
+    return PageCursor<Booking>(
+        [this](const std::string& path) { return fetchPage<Booking>(path, true); },
+        firstPagePath("/admin/bookings", perPage), &workers_);
+}
+
+PageCursor<Room> ApiClient::adminRoomPages(int perPage) {
+    return PageCursor<Room>(
+        [this](const std::string& path) { return fetchPage<Room>(path, true); },
+        firstPagePath("/admin/rooms", perPage), &workers_);
+}
+
+PageCursor<Booking> ApiClient::reservationPages(int perPage) {
+    return PageCursor<Booking>(
+        [this](const std::string& path) { return fetchPage<Booking>(path, endpoints::listReservations.requiresAuth); },
+        firstPagePath(std::string(endpoints::listReservations.pattern), perPage), &workers_);
+}
+
+PageCursor<MaintenanceTask> ApiClient::maintenanceTaskPages(int perPage) {
+    return PageCursor<MaintenanceTask>(
+        [this](const std::string& path) { return fetchPage<MaintenanceTask>(path, endpoints::listMaintenanceTasks.requiresAuth); },
+        firstPagePath(std::string(endpoints::listMaintenanceTasks.pattern), perPage), &workers_);
+}
@@ -0,0 +1,48 @@
+// src/ApiClient_Payments.cpp
+#include "ApiClient.h"
+#include "DataStructures.h"
+#include "EndpointCall.h"
+#include "Logger.h"
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+
+using json = nlohmann::json;
+
+// --- Payments Implementation ---
+
+std::optional<Payment> ApiClient::createPayment(const PaymentData& payment) {
+    std::string& body = RequestBuilder::forThisThread().body();
+    JsonWriter writer(body);
+    writeJson(writer, payment);
+
+    std::optional<Payment> created = call<endpoints::createPayment>(endpoints::createPayment.pattern, body);
+    if (!created) {
+        LOG_ERROR("[Payment Error] Payment for booking ID " << payment.booking_id << " failed.");
+        return std::nullopt;
+    }
+    LOG_INFO("[Payment] Transaction " << created->transaction_id << " for booking ID " << payment.booking_id
+             << ": " << created->status);
+    return created;
+}
+
+std::optional<Payment> ApiClient::getPayment(const std::string& transactionId) {
+    return call<endpoints::getPayment>(endpointPath<endpoints::getPayment>(transactionId));
+}
+
+bool ApiClient::refundPayment(const std::string& transactionId, const std::string& reason, std::optional<double> amount) {
+    std::string& body = RequestBuilder::forThisThread().body();
+    JsonWriter writer(body);
+    writer.beginObject().field("reason", reason);
+    if (amount) writer.field("amount", amount.value());
+    writer.endObject();
+
+    // The gateway's verdict is in {"success": bool}, even on HTTP 200
+    std::optional<json> response = call<endpoints::refundPayment>(endpointPath<endpoints::refundPayment>(transactionId), body);
+    if (!response || !response->is_object() || !response->value("success", false)) {
+        LOG_ERROR("[Payment Error] Refund of transaction " << transactionId << " failed.");
+        return false;
+    }
+    LOG_INFO("[Payment] Refunded transaction " << transactionId << ".");
+    return true;
+}
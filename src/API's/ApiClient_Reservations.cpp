@@ -0,0 +1,31 @@
+// src/ApiClient_Reservations.cpp
+#include "ApiClient.h"
+#include "DataStructures.h"
+#include "EndpointCall.h"
+#include "Logger.h"
+#include <optional>
+
+// --- Reservations Implementation ---
+// The listing is in ApiClient_Pagination.cpp (reservationPages)
+
+std::optional<Booking> ApiClient::getReservation(int id) {
+    return call<endpoints::getReservation>(endpointPath<endpoints::getReservation>(id));
+}
+
+std::optional<Booking> ApiClient::checkInReservation(int id) {
+    std::optional<Booking> reservation = call<endpoints::checkInReservation>(endpointPath<endpoints::checkInReservation>(id));
+    if (reservation) LOG_INFO("[Reservation] Checked in reservation ID: " << id);
+    return reservation;
+}
+
+std::optional<Booking> ApiClient::checkOutReservation(int id) {
+    std::optional<Booking> reservation = call<endpoints::checkOutReservation>(endpointPath<endpoints::checkOutReservation>(id));
+    if (reservation) LOG_INFO("[Reservation] Checked out reservation ID: " << id);
+    return reservation;
+}
+
+std::optional<Booking> ApiClient::cancelReservation(int id) {
+    std::optional<Booking> reservation = call<endpoints::cancelReservation>(endpointPath<endpoints::cancelReservation>(id));
+    if (reservation) LOG_INFO("[Reservation] Cancelled reservation ID: " << id);
+    return reservation;
+}
@@ -1,168 +1,173 @@
 // src/ApiClient_Rooms.cpp
 #include "ApiClient.h"
 #include "DataStructures.h"
+#include "EndpointCall.h"
+#include "JsonStreamDecoder.h"
+#include "Logger.h"
+#include <cpr/cpr.h>
 #include <nlohmann/json.hpp>
 #include <vector>
 #include <optional>
-#include <iostream>
+#include <string> // Needed for std::to_string
 
 using json = nlohmann::json;
 
-// --- Rooms Implementation ---
+namespace {
 
-std::vector<Room> ApiClient::getRooms() {
-    std::cout << "[API Request] GET /rooms" << std::endl;
-    std::optional<json> response_json_opt = performRequest("GET", "/rooms", 200, false);
-
-    if (!response_json_opt) return {};
-
-    json response_json = response_json_opt.value();
-    if (response_json.contains("data") && response_json["data"].is_array()) {
-        try {
-            return response_json["data"].get<std::vector<Room>>();
-        } catch (json::exception& e) {
-             std::cerr << "[JSON Error] Failed to convert room list data: " << e.what() << std::endl;
-             return {};
-        }
-    } else {
-        std::cerr << "[API Error] Expected 'data' array in /rooms response." << std::endl;
-        return {};
-    }
+// If-None-Match / If-Modified-Since from what the cache holds
+cpr::Header conditionalHeaders(const RoomCache::Validators& validators) {
+    cpr::Header headers;
+    if (!validators.etag.empty()) headers["If-None-Match"] = validators.etag;
+    if (!validators.lastModified.empty()) headers["If-Modified-Since"] = validators.lastModified;
+    return headers;
 }
 
-std::optional<Room> ApiClient::getRoomById(int id) {
-    std::string path = "/rooms/" + std::to_string(id);
-    std::cout << "[API Request] GET " << path << std::endl;
-    std::optional<json> response_json_opt = performRequest("GET", path, 200, false);
-
-    if (!response_json_opt) return std::nullopt;
-
-    json response_json = response_json_opt.value();
-    if (response_json.contains("data") && response_json["data"].is_object()) {
-         try {
-            return response_json["data"].get<Room>();
-        } catch (json::exception& e) {
-             std::cerr << "[JSON Error] Failed to convert room data for ID " << id << ": " << e.what() << std::endl;
-             return std::nullopt;
-        }
-    } else {
-        std::cerr << "[API Error] Expected 'data' object in " << path << " response." << std::endl;
-        return std::nullopt;
-    }
+RoomCache::Validators validatorsFrom(const cpr::Response& response) {
+    RoomCache::Validators validators;
+    auto etag = response.header.find("ETag");
+    if (etag != response.header.end()) validators.etag = etag->second;
+    auto lastModified = response.header.find("Last-Modified");
+    if (lastModified != response.header.end()) validators.lastModified = lastModified->second;
+    return validators;
 }
 
-// src/ApiClient_Rooms.cpp
-#include "ApiClient.h"
-#include "DataStructures.h"
-#include <nlohmann/json.hpp>
-#include <vector>
-#include <optional>
-#include <iostream>
-#include <string> // Needed for std::to_string
-
-using json = nlohmann::json;
+} // namespace
 
 // --- Existing Rooms Implementation (GET methods) ---
 
 std::vector<Room> ApiClient::getRooms() {
-    std::cout << "[API Request] GET /rooms" << std::endl;
-    std::optional<json> response_json_opt = performRequest("GET", "/rooms", 200, false);
-
-    if (!response_json_opt) return {};
-
-    json response_json = response_json_opt.value();
-    if (response_json.contains("data") && response_json["data"].is_array()) {
-        try {
-            return response_json["data"].get<std::vector<Room>>();
-        } catch (json::exception& e) {
-             std::cerr << "[JSON Error] Failed to convert room list data: " << e.what() << std::endl;
-             return {};
+    if (auto cached = room_cache_.freshList()) {
+        LOG_DEBUG("[Room Cache] Serving /rooms from cache (" << cached->size() << " rooms).");
+        return std::move(cached.value());
+    }
+    // Concurrent misses (e.g. right after the TTL expires) share one request and decode
+    return *room_list_flights_.run(flightKey(HttpMethod::Get, "/rooms", false), [this] { return fetchRooms(); });
+}
+
+std::vector<Room> ApiClient::fetchRooms() {
+    uint64_t generation = room_cache_.generation();
+    cpr::Header conditional = conditionalHeaders(room_cache_.listValidators());
+    LOG_DEBUG("[API Request] GET /rooms");
+    std::optional<cpr::Response> response = sendSerialized(HttpMethod::Get, endpoints::listRooms.pattern, false, {}, &conditional);
+    if (!response) return {};
+
+    if (response->error || response->status_code >= 500) {
+        // API unreachable: an old catalog (e.g. from the startup snapshot) beats none
+        if (auto stale = room_cache_.catalog()) {
+            LOG_WARN("[Room Cache] API unreachable, serving the last known catalog (" << stale->rooms.size() << " rooms).");
+            return std::move(stale->rooms);
         }
-    } else {
-        std::cerr << "[API Error] Expected 'data' array in /rooms response." << std::endl;
-        return {};
     }
+
+    if (response->status_code == 304) {
+        if (auto cached = room_cache_.revalidateList()) {
+            LOG_DEBUG("[Room Cache] /rooms not modified, reusing cached catalog.");
+            return std::move(cached.value());
+        }
+        // Invalidated while the request was in flight; fetch without validators
+        response = sendSerialized(HttpMethod::Get, endpoints::listRooms.pattern, false, {});
+        if (!response) return {};
+    }
+
+    // Decode straight from the response bytes into Room structs (no json DOM)
+    std::optional<std::vector<Room>> rooms = receive<endpoints::listRooms>(response, endpoints::listRooms.pattern);
+    if (!rooms) return {};
+    room_cache_.storeList(rooms.value(), validatorsFrom(response.value()), generation);
+    return std::move(rooms.value());
 }
 
 std::optional<Room> ApiClient::getRoomById(int id) {
-    std::string path = "/rooms/" + std::to_string(id);
-    std::cout << "[API Request] GET " << path << std::endl;
-    std::optional<json> response_json_opt = performRequest("GET", path, 200, false);
-
-    if (!response_json_opt) return std::nullopt;
-
-    json response_json = response_json_opt.value();
-    if (response_json.contains("data") && response_json["data"].is_object()) {
-         try {
-            return response_json["data"].get<Room>();
-        } catch (json::exception& e) {
-             std::cerr << "[JSON Error] Failed to convert room data for ID " << id << ": " << e.what() << std::endl;
-             return std::nullopt;
-        }
-    } else {
-        std::cerr << "[API Error] Expected 'data' object in " << path << " response." << std::endl;
-        return std::nullopt;
+    if (auto cached = room_cache_.freshRoom(id)) {
+        LOG_DEBUG("[Room Cache] Serving room ID " << id << " from cache.");
+        return cached;
     }
+    RequestPath path("/rooms/", id);
+    return *room_flights_.run(flightKey(HttpMethod::Get, path, false), [this, id] { return fetchRoomById(id); });
 }
 
+std::optional<Room> ApiClient::fetchRoomById(int id) {
+    RequestPath path = endpointPath<endpoints::getRoom>(id);
+    uint64_t generation = room_cache_.generation();
+    cpr::Header conditional = conditionalHeaders(room_cache_.roomValidators(id));
+    LOG_DEBUG("[API Request] GET " << path);
+    // Hedged: a stalled backend node shouldn't hold up a single-room lookup
+    std::optional<cpr::Response> response = sendSerialized(HttpMethod::Get, path, false, {}, &conditional, endpoints::getRoom.hedged);
+    if (!response) return std::nullopt;
+
+    if (response->status_code == 304) {
+        if (auto cached = room_cache_.revalidateRoom(id)) {
+            LOG_DEBUG("[Room Cache] " << path << " not modified, reusing cached room.");
+            return cached;
+        }
+        response = sendSerialized(HttpMethod::Get, path, false, {}, nullptr, endpoints::getRoom.hedged);
+        if (!response) return std::nullopt;
+    }
 
-// --- NEW Rooms Implementation (POST, PUT, DELETE) ---
+    std::optional<Room> room = receive<endpoints::getRoom>(response, path);
+    if (!room) return std::nullopt;
+    room_cache_.storeRoom(room.value(), validatorsFrom(response.value()), generation);
+    return room;
+}
 
-std::optional<Room> ApiClient::createRoom(const RoomData& roomData) {
-    if (!isAuthenticated()) {
-        std::cerr << "[Room Error] Authentication required to create a room." << std::endl;
-        return std::nullopt;
-    }
-    // Add role/permission check here if client has that info, otherwise rely on backend
-    std::cout << "[API Request] POST /rooms" << std::endl;
+void ApiClient::setRoomCacheTtl(std::chrono::seconds ttl) {
+    room_cache_.setTtl(ttl);
+}
 
-    json payload = roomData; // Convert RoomData struct to JSON
+RoomCache::Stats ApiClient::roomCacheStats() const {
+    return room_cache_.stats();
+}
 
-    std::optional<json> response_json_opt = performRequest("POST", "/rooms", 201, true, payload);
+std::optional<RoomCache::Catalog> ApiClient::roomCatalog() const {
+    return room_cache_.catalog();
+}
 
-    if (!response_json_opt) {
-        return std::nullopt; // Error handled/logged in performRequest
-    }
+void ApiClient::seedRoomCatalog(const RoomCache::Catalog& catalog) {
+    room_cache_.seedList(catalog);
+}
 
-    json response_json = response_json_opt.value();
 
-    // Expect the created room object wrapped in 'data'
-    if (response_json.contains("data") && response_json["data"].is_object()) {
-        try {
-            // Parse the response back into a full Room struct (which includes the new ID)
-            return response_json["data"].get<Room>();
-        } catch (json::exception& e) {
-            std::cerr << "[JSON Error] Failed to parse created room response: " << e.what() << std::endl;
-            return std::nullopt;
-        }
-    } else {
-        std::cerr << "[API Error] Expected 'data' object in room creation response." << std::endl;
+// --- NEW Rooms Implementation (POST, PUT, DELETE) ---
+
+std::optional<Room> ApiClient::createRoom(const RoomData& roomData) {
+    if (!isAuthenticated()) {
+        LOG_ERROR("[Room Error] Authentication required to create a room.");
         return std::nullopt;
     }
+    // Add role/permission check here if client has that info, otherwise rely on backend
+    std::string& body = RequestBuilder::forThisThread().body();
+    JsonWriter writer(body);
+    writeJson(writer, roomData);
+
+    // Expect the created room object wrapped in 'data' (includes the new ID)
+    std::optional<Room> room = call<endpoints::createRoom>(endpoints::createRoom.pattern, body);
+    if (room) room_cache_.invalidateList(); // The cached catalog no longer has every room
+    return room;
 }
 
 
 bool ApiClient::updateRoom(int id, const RoomData& roomData) {
     if (!isAuthenticated()) {
-        std::cerr << "[Room Error] Authentication required to update a room." << std::endl;
+        LOG_ERROR("[Room Error] Authentication required to update a room.");
         return false;
     }
     // Add role/permission check here if possible
-    std::string path = "/rooms/" + std::to_string(id);
-    std::cout << "[API Request] PUT " << path << std::endl;
+    RequestPath path = endpointPath<endpoints::updateRoom>(id);
+    LOG_DEBUG("[API Request] PUT " << path);
 
-    json payload = roomData; // Convert RoomData struct to JSON
+    std::string& body = RequestBuilder::forThisThread().body();
+    JsonWriter writer(body);
+    writeJson(writer, roomData);
 
-    // Expect 200 OK on successful update
-    std::optional<json> response_json_opt = performRequest("PUT", path, 200, true, payload);
+    // Expect 200 OK on successful update; queued in the journal if the API is unreachable
+    std::optional<cpr::Response> response = sendMutation(endpoints::updateRoom.method, path, body);
+    if (lastWriteQueued()) return false;
 
-    // Check if the request was successful (returned a value, implying status 200 OK)
-    if (response_json_opt.has_value()) {
-        std::cout << "[Room] Update successful for room ID: " << id << std::endl;
-        // Optionally, parse response_json_opt.value() if the API returns the updated room data
+    if (receive<endpoints::updateRoom>(response, path)) {
+        room_cache_.invalidateRoom(id);
+        LOG_INFO("[Room] Update successful for room ID: " << id);
         return true;
     } else {
-        std::cerr << "[Room Error] Update failed for room ID: " << id << std::endl;
+        LOG_ERROR("[Room Error] Update failed for room ID: " << id);
         return false;
     }
 }
@@ -170,29 +175,17 @@ bool ApiClient::updateRoom(int id, const RoomData& roomData) {
 
 bool ApiClient::deleteRoom(int id) {
     if (!isAuthenticated()) {
-        std::cerr << "[Room Error] Authentication required to delete a room." << std::endl;
+        LOG_ERROR("[Room Error] Authentication required to delete a room.");
         return false;
     }
     // Add role/permission check here if possible
-    std::string path = "/rooms/" + std::to_string(id);
-    std::cout << "[API Request] DELETE " << path << std::endl;
-
     // Expect 204 No Content or 200 OK for successful deletion
-    // Let's check for 204 first as it's common for DELETE.
-    std::optional<json> response_json_opt = performRequest("DELETE", path, 204, true);
-
-    if (!response_json_opt) {
-         // If 204 failed, maybe the backend returns 200 OK?
-         std::cout << "[Room Info] Delete didn't return 204, checking for 200..." << std::endl;
-         response_json_opt = performRequest("DELETE", path, 200, true);
-    }
-
-    // Check if either attempt resulted in success (returned a value)
-    if (response_json_opt.has_value()) {
-         std::cout << "[Room] Successfully deleted room ID: " << id << std::endl;
+    if (call<endpoints::deleteRoom>(endpointPath<endpoints::deleteRoom>(id))) {
+         room_cache_.invalidateRoom(id);
+         LOG_INFO("[Room] Successfully deleted room ID: " << id);
          return true;
     } else {
-         std::cerr << "[Room Error] Failed to delete room ID: " << id << std::endl;
+         LOG_ERROR("[Room Error] Failed to delete room ID: " << id);
          return false;
     }
 }
\ No newline at end of file
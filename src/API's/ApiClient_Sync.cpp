@@ -0,0 +1,105 @@
+// src/ApiClient_Sync.cpp
+#include "ApiClient.h"
+#include "DataStructures.h"
+#include "JsonStreamDecoder.h"
+#include "Logger.h"
+#include <cpr/cpr.h>
+#include <cctype>
+#include <iterator>
+#include <optional>
+#include <string>
+
+// --- Delta Sync Implementation ---
+
+namespace {
+
+// The cursor is opaque (a timestamp today); escape anything a query value can't hold as-is
+std::string encodeQueryValue(const std::string& value) {
+    static const char hex[] = "0123456789ABCDEF";
+    std::string out;
+    for (char c : value) {
+        auto u = static_cast<unsigned char>(c);
+        if (std::isalnum(u) || c == '-' || c == '.' || c == '_' || c == '~' || c == ':') {
+            out.push_back(c);
+        } else {
+            out.push_back('%');
+            out.push_back(hex[u >> 4]);
+            out.push_back(hex[u & 0xF]);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+template <typename T>
+SyncDiff ApiClient::syncInto(SyncReplica<T>& replica, const char* path, bool requiresAuth) {
+    // Taken before the request: if the user changes meanwhile, the result is dropped
+    std::string scope;
+    if (requiresAuth) {
+        std::shared_ptr<const AuthSnapshot> auth = tokens_.current();
+        scope = replicaScope(auth->token, auth->userId);
+    }
+    std::string cursor = replica.cursor();
+    // No cursor yet, or an API that never hands one out: ask for the plain listing
+    std::string target = cursor.empty() ? std::string(path)
+                                        : std::string(path) + "?updated_since=" + encodeQueryValue(cursor);
+
+    std::vector<T> changed;
+    SyncInfo info;
+    size_t pages = 0;
+    while (!target.empty()) {
+        LOG_DEBUG("[API Request] GET " << target);
+        std::optional<cpr::Response> response = performRawRequest(HttpMethod::Get, target, 200, requiresAuth);
+        if (!response) return SyncDiff(); // Error logged by performRawRequest
+
+        std::vector<T> batch;
+        PageInfo page;
+        std::string decodeError;
+        RequestMetrics::ParseTimer parseTimer(metrics_, "GET", path);
+        if (!decodeSyncArray(response->text, batch, decodeError, info, &page)) {
+            LOG_ERROR("[JSON Error] Failed to convert " << path << " sync response: " << decodeError);
+            return SyncDiff();
+        }
+        parseTimer.stop();
+        if (changed.empty()) {
+            changed = std::move(batch);
+        } else {
+            changed.insert(changed.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+        }
+        ++pages;
+
+        // A delta comes whole; a plain listing (no cursor) may be paginated
+        std::string next = info.cursor.empty() ? nextPagePath(target, page) : std::string();
+        target = next != target ? std::move(next) : std::string();
+    }
+
+    // Without a cursor the API doesn't do deltas: what came back is the whole collection
+    bool full = info.full || info.cursor.empty();
+    size_t received = changed.size();
+    SyncDiff diff = replica.apply(std::move(changed), info.deleted, full, std::move(info.cursor), scope);
+    if (!diff.ok) {
+        LOG_DEBUG("[Sync] " << path << " result dropped: signed in as someone else since the request.");
+        return diff;
+    }
+    LOG_DEBUG("[Sync] " << path << (diff.reset ? " full" : " delta") << ": " << received << " received in " << pages
+              << " page(s), +" << diff.inserted.size() << " ~" << diff.updated.size() << " -" << diff.deleted.size());
+    return diff;
+}
+
+SyncDiff ApiClient::syncRooms() {
+    return *sync_flights_.run(flightKey(HttpMethod::Get, "/rooms?updated_since", false), [this] {
+        SyncDiff diff = syncInto(room_replica_, "/rooms", false);
+        // Keep getRooms/getRoomById from serving what the sync just replaced
+        for (int id : diff.updated) room_cache_.invalidateRoom(id);
+        for (int id : diff.deleted) room_cache_.invalidateRoom(id);
+        if (!diff.empty()) room_cache_.invalidateList(); // Any change makes the cached list stale
+        return diff;
+    });
+}
+
+SyncDiff ApiClient::syncBookings() {
+    return *sync_flights_.run(flightKey(HttpMethod::Get, "/bookings?updated_since", true), [this] {
+        return syncInto(booking_replica_, "/bookings", true);
+    });
+}
@@ -1,10 +1,13 @@
 // src/ApiClient_User.cpp
 #include "ApiClient.h"
 #include "DataStructures.h"
+#include "EndpointCall.h"
+#include "JsonStreamDecoder.h"
+#include "Logger.h"
+#include <cpr/cpr.h>
 #include <nlohmann/json.hpp>
 #include <vector>
 #include <optional>
-#include <iostream>
 #include <string> // Needed for std::to_string
 
 using json = nlohmann::json;
@@ -13,63 +16,48 @@ using json = nlohmann::json;
 
 std::optional<User> ApiClient::getUserProfile(int id) {
      if (!isAuthenticated()) {
-        std::cerr << "[User Error] Authentication required to view user profiles." << std::endl;
+        LOG_ERROR("[User Error] Authentication required to view user profiles.");
         return std::nullopt;
     }
-     std::string path = "/user/" + std::to_string(id);
-     std::cout << "[API Request] GET " << path << std::endl;
-     // Note: Backend must enforce authorization (can current user view profile 'id'?)
-
-     // Expect 200 OK
-     std::optional<json> response_json_opt = performRequest("GET", path, 200, true);
-
-    if (!response_json_opt) return std::nullopt; // Error logged already
+    RequestPath path("/user/", id);
+    return *user_flights_.run(flightKey(HttpMethod::Get, path, true), [this, id] { return fetchUserProfile(id); });
+}
 
-    json response_json = response_json_opt.value();
-    // Expect Laravel single resource format: { "data": { ... } }
-    if (response_json.contains("data") && response_json["data"].is_object()) {
-         try {
-            return response_json["data"].get<User>();
-        } catch (json::exception& e) {
-             std::cerr << "[JSON Error] Failed to convert user profile data for ID " << id << ": " << e.what() << std::endl;
-             return std::nullopt;
-        }
-    } else {
-        std::cerr << "[API Error] Expected 'data' object in " << path << " response." << std::endl;
-        return std::nullopt;
-    }
+std::optional<User> ApiClient::fetchUserProfile(int id) {
+     // Note: Backend must enforce authorization (can current user view profile 'id'?)
+     // Expect Laravel single resource format: { "data": { ... } }
+     return call<endpoints::getUser>(endpointPath<endpoints::getUser>(id));
 }
 
 bool ApiClient::updateUserProfile(int id, const User& userData) {
      if (!isAuthenticated()) {
-        std::cerr << "[User Error] Authentication required to update user profiles." << std::endl;
+        LOG_ERROR("[User Error] Authentication required to update user profiles.");
         return false;
     }
-     std::string path = "/user/" + std::to_string(id);
-     std::cout << "[API Request] PUT " << path << std::endl;
+     RequestPath path = endpointPath<endpoints::updateUser>(id);
+     LOG_DEBUG("[API Request] PUT " << path);
      // Note: Backend must enforce authorization (can current user update profile 'id'?)
 
     // Construct payload carefully - avoid sending sensitive fields like ID, role, password
     // Ensure the keys match what the backend expects for an update request
-    json payload = {
-        {"username", userData.username}, // or "name"
-        {"email", userData.email},
-        {"phone", userData.phone},
-        {"age", userData.age}
+    std::string& body = RequestBuilder::forThisThread().body();
+    JsonWriter(body).beginObject()
+        .field("username", userData.username) // or "name"
+        .field("email", userData.email)
+        .field("phone", userData.phone)
+        .field("age", userData.age)
         // Do NOT include id, role, or password unless API specifically requires them for update
-    };
+        .endObject();
 
-    // Expect 200 OK on successful update
-    std::optional<json> response_json_opt = performRequest("PUT", path, 200, true, payload);
+    // Expect 200 OK on successful update; queued in the journal if the API is unreachable
+    std::optional<cpr::Response> response = sendMutation(endpoints::updateUser.method, path, body);
+    if (lastWriteQueued()) return false;
 
-    // Check if the request was successful (returned a value, implying status 200 OK)
-    if (response_json_opt.has_value()) {
-         std::cout << "[User] Profile update successful for ID: " << id << std::endl;
-         // The response might contain the updated user data in response_json_opt.value()["data"]
-         // You could parse and use it if needed, e.g., update the local loggedInUser object.
+    if (receive<endpoints::updateUser>(response, path)) {
+         LOG_INFO("[User] Profile update successful for ID: " << id);
          return true;
     } else {
-         std::cerr << "[User Error] Profile update failed for ID: " << id << std::endl;
+         LOG_ERROR("[User Error] Profile update failed for ID: " << id);
          return false;
     }
 }
\ No newline at end of file
@@ -0,0 +1,158 @@
+// src/AvailabilityIndex.cpp
+#include "AvailabilityIndex.h"
+#include <algorithm>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+int lowestBit(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+}
+
+// --- Building ---
+
+bool AvailabilityIndex::build(const std::vector<Room>& rooms, const std::vector<Booking>& bookings, Date from, Date to) {
+    slots_.clear();
+    slot_of_room_.clear();
+    stays_.clear();
+    booking_slots_.clear();
+    occupancy_.clear();
+    day_base_ = 0;
+    day_count_ = 0;
+
+    slots_.reserve(rooms.size());
+    for (const auto& room : rooms) slots_.push_back(Slot{room.id, room.capacity});
+    std::sort(slots_.begin(), slots_.end(), [](const Slot& a, const Slot& b) {
+        return a.capacity != b.capacity ? a.capacity > b.capacity : a.roomId < b.roomId;
+    });
+
+    words_ = (slots_.size() + 63) / 64;
+    in_service_.assign(words_, 0);
+    stays_.resize(slots_.size());
+    for (size_t slot = 0; slot < slots_.size(); ++slot) slot_of_room_[slots_[slot].roomId] = slot;
+    for (const auto& room : rooms) {
+        if (!room.available) continue;
+        size_t slot = slot_of_room_[room.id];
+        in_service_[slot / 64] |= uint64_t{1} << (slot % 64);
+    }
+
+    if (!from.isSet() || !to.isSet() || to <= from || to.days() - from.days() > kMaxWindowDays) return false;
+    day_base_ = from.days();
+    day_count_ = to.days() - from.days();
+    occupancy_.assign(static_cast<size_t>(day_count_) * words_, 0);
+
+    for (const auto& booking : bookings) addBooking(booking);
+    return true;
+}
+
+bool AvailabilityIndex::addBooking(const Booking& booking) {
+    if (booking.status == "cancelled") return false;
+    auto slotIt = slot_of_room_.find(booking.roomId);
+    if (slotIt == slot_of_room_.end()) return false;
+
+    if (!booking.checkIn.isSet() || !booking.checkOut.isSet() || booking.checkOut <= booking.checkIn) return false;
+    if (booking_slots_.count(booking.id)) removeBooking(booking.id);
+    // Only the nights inside the window are kept
+    int32_t checkIn = std::max(booking.checkIn.days(), day_base_);
+    int32_t checkOut = std::min(booking.checkOut.days(), day_base_ + day_count_);
+    if (checkIn >= checkOut) return true;
+
+    size_t slot = slotIt->second;
+    stays_[slot].push_back(Stay{booking.id, checkIn, checkOut});
+    booking_slots_[booking.id] = slot;
+    markNights(slot, checkIn, checkOut, true);
+    return true;
+}
+
+void AvailabilityIndex::removeBooking(int bookingId) {
+    auto it = booking_slots_.find(bookingId);
+    if (it == booking_slots_.end()) return;
+    size_t slot = it->second;
+    booking_slots_.erase(it);
+
+    std::vector<Stay>& stays = stays_[slot];
+    auto stay = std::find_if(stays.begin(), stays.end(), [bookingId](const Stay& s) { return s.bookingId == bookingId; });
+    if (stay == stays.end()) return;
+    Stay removed = *stay;
+    stays.erase(stay);
+
+    // Clear the nights, then restore any that another (overlapping) stay still holds
+    markNights(slot, removed.checkIn, removed.checkOut, false);
+    for (const auto& other : stays) {
+        int32_t first = std::max(other.checkIn, removed.checkIn);
+        int32_t last = std::min(other.checkOut, removed.checkOut);
+        if (first < last) markNights(slot, first, last, true);
+    }
+}
+
+void AvailabilityIndex::markNights(size_t slot, int32_t first, int32_t last, bool taken) {
+    uint64_t bit = uint64_t{1} << (slot % 64);
+    size_t word = slot / 64;
+    for (int32_t day = first; day < last; ++day) {
+        uint64_t& cell = row(day)[word];
+        cell = taken ? (cell | bit) : (cell & ~bit);
+    }
+}
+
+// --- Queries ---
+
+size_t AvailabilityIndex::slotsWithCapacity(int minCapacity) const {
+    auto end = std::partition_point(slots_.begin(), slots_.end(),
+                                    [minCapacity](const Slot& s) { return s.capacity >= minCapacity; });
+    return static_cast<size_t>(end - slots_.begin());
+}
+
+std::vector<int> AvailabilityIndex::freeRooms(Date checkIn, Date checkOut, int minCapacity) const {
+    std::vector<int> result;
+    if (!covers(checkIn, checkOut)) return result;
+    int32_t first = checkIn.days();
+    int32_t last = checkOut.days();
+
+    size_t candidates = slotsWithCapacity(minCapacity);
+    size_t words = (candidates + 63) / 64;
+    std::vector<uint64_t> taken(words, 0);
+
+    for (int32_t day = first; day < last; ++day) {
+        const uint64_t* nights = row(day);
+        for (size_t w = 0; w < words; ++w) taken[w] |= nights[w];
+    }
+
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t free = ~taken[w] & in_service_[w];
+        if (w == words - 1 && candidates % 64 != 0) free &= (uint64_t{1} << (candidates % 64)) - 1;
+        while (free) {
+            int bit = lowestBit(free);
+            result.push_back(slots_[w * 64 + static_cast<size_t>(bit)].roomId);
+            free &= free - 1;
+        }
+    }
+    return result;
+}
+
+bool AvailabilityIndex::isFree(int roomId, Date checkIn, Date checkOut) const {
+    auto slotIt = slot_of_room_.find(roomId);
+    if (slotIt == slot_of_room_.end() || !covers(checkIn, checkOut)) return false;
+    int32_t first = checkIn.days();
+    int32_t last = checkOut.days();
+    size_t slot = slotIt->second;
+    uint64_t bit = uint64_t{1} << (slot % 64);
+    if (!(in_service_[slot / 64] & bit)) return false;
+
+    for (int32_t day = first; day < last; ++day) {
+        if (row(day)[slot / 64] & bit) return false;
+    }
+    return true;
+}
+
+bool AvailabilityIndex::covers(Date checkIn, Date checkOut) const {
+    if (!checkIn.isSet() || !checkOut.isSet() || checkOut <= checkIn) return false;
+    return checkIn.days() >= day_base_ && checkOut.days() <= day_base_ + day_count_;
+}
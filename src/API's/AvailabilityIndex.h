@@ -0,0 +1,75 @@
+// src/AvailabilityIndex.h
+#ifndef AVAILABILITY_INDEX_H
+#define AVAILABILITY_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "DataStructures.h"
+
+// --- AvailabilityIndex ---
+// Local answer to "which rooms with capacity >= G are free from D1 to D2",
+// built from Room and Booking records so the UI can filter candidates before
+// asking the server. Occupancy is kept as one bitset of rooms per night;
+// rooms are ordered by capacity (largest first) so a capacity filter is just
+// a prefix of each bitset, and a query ORs one row per night of the stay.
+// Only the nights of a fixed window [from, to) are indexed, so a long booking
+// history costs nothing beyond the window and every booking can be taken into
+// account. Queries reaching outside the window find nothing free: those nights
+// are unknown, and reporting a booked room as free is the mistake to avoid.
+// Not thread-safe: rebuild or update from one thread, or guard externally.
+class AvailabilityIndex {
+public:
+    // Replace everything with a fresh room list and booking set, indexing the
+    // nights from `from` up to (not including) `to`. False, with nothing
+    // indexed, if the window is empty or longer than kMaxWindowDays.
+    bool build(const std::vector<Room>& rooms, const std::vector<Booking>& bookings, Date from, Date to);
+
+    // Mark a booking's nights [checkIn, checkOut) inside the window as taken.
+    // Cancelled bookings, unknown rooms and missing dates are ignored (returns
+    // false); a booking entirely outside the window is accepted and changes nothing.
+    // A booking id that is already indexed is replaced.
+    bool addBooking(const Booking& booking);
+    void removeBooking(int bookingId);
+
+    // Room ids (largest capacity first) that are in service and free for every
+    // night from checkIn up to (not including) checkOut; none if the stay isn't inside the window
+    std::vector<int> freeRooms(Date checkIn, Date checkOut, int minCapacity) const;
+    bool isFree(int roomId, Date checkIn, Date checkOut) const;
+    bool covers(Date checkIn, Date checkOut) const; // Every night of the stay is in the window
+
+    static constexpr int32_t kMaxWindowDays = 3660; // ~10 years of nights
+
+    size_t roomCount() const { return slots_.size(); }
+    size_t bookingCount() const { return booking_slots_.size(); }
+
+private:
+    struct Slot {
+        int roomId = 0;
+        int capacity = 0;
+    };
+    struct Stay {
+        int bookingId = 0;
+        int32_t checkIn = 0;  // First night
+        int32_t checkOut = 0; // Departure day (not a night)
+    };
+
+    void markNights(size_t slot, int32_t first, int32_t last, bool taken);
+    size_t slotsWithCapacity(int minCapacity) const;
+    const uint64_t* row(int32_t day) const { return &occupancy_[static_cast<size_t>(day - day_base_) * words_]; }
+    uint64_t* row(int32_t day) { return &occupancy_[static_cast<size_t>(day - day_base_) * words_]; }
+
+    std::vector<Slot> slots_;                        // Sorted by capacity desc, then room id
+    std::unordered_map<int, size_t> slot_of_room_;
+    std::vector<uint64_t> in_service_;               // Room::available, one bit per slot
+    std::vector<std::vector<Stay>> stays_;           // Per slot, to rebuild bits after a removal
+    std::unordered_map<int, size_t> booking_slots_;  // Booking id -> slot
+
+    size_t words_ = 0;                               // uint64 words per night row
+    int32_t day_base_ = 0;                           // Day number of row 0 (the window's first night)
+    int32_t day_count_ = 0;                          // Nights in the window
+    std::vector<uint64_t> occupancy_;                // day_count_ rows of words_ words
+};
+
+#endif // AVAILABILITY_INDEX_H
@@ -0,0 +1,204 @@
+// src/ConnectionPool.cpp
+#include "ConnectionPool.h"
+#include <cpr/cpr.h>
+#include <curl/curl.h>
+#include <array>
+#include <utility>
+
+// --- Shared Caches ---
+
+// A curl share handle; curl calls back into these mutexes around every access
+// to the shared DNS, TLS session and connection caches
+struct ConnectionPool::SharedCaches {
+    CURLSH* handle = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> locks;
+
+    SharedCaches() {
+        handle = curl_share_init();
+        if (!handle) return;
+        curl_share_setopt(handle, CURLSHOPT_LOCKFUNC, &SharedCaches::lock);
+        curl_share_setopt(handle, CURLSHOPT_UNLOCKFUNC, &SharedCaches::unlock);
+        curl_share_setopt(handle, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    }
+    ~SharedCaches() {
+        if (handle) curl_share_cleanup(handle);
+    }
+    SharedCaches(const SharedCaches&) = delete;
+    SharedCaches& operator=(const SharedCaches&) = delete;
+
+    static void lock(CURL*, curl_lock_data data, curl_lock_access, void* self) {
+        static_cast<SharedCaches*>(self)->locks[static_cast<size_t>(data) % CURL_LOCK_DATA_LAST].lock();
+    }
+    static void unlock(CURL*, curl_lock_data data, void* self) {
+        static_cast<SharedCaches*>(self)->locks[static_cast<size_t>(data) % CURL_LOCK_DATA_LAST].unlock();
+    }
+};
+
+// --- Lease ---
+
+ConnectionPool::Lease::Lease(ConnectionPool* pool, HostSlot* slot, std::unique_ptr<cpr::Session> session)
+    : pool_(pool), slot_(slot), session_(std::move(session)) {}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), slot_(other.slot_), session_(std::move(other.session_)) {
+    other.pool_ = nullptr;
+    other.slot_ = nullptr;
+}
+
+ConnectionPool::Lease::~Lease() {
+    if (pool_ && session_) {
+        pool_->release(slot_, std::move(session_));
+    }
+}
+
+void ConnectionPool::Lease::recordTransfer(const cpr::Response& response) {
+    if (response.error) return;
+    CURL* handle = session_->GetCurlHolder()->handle;
+
+    long httpVersion = 0;
+    if (curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &httpVersion) == CURLE_OK && httpVersion >= CURL_HTTP_VERSION_2_0) {
+        pool_->http2_transfers_.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto encoding = response.header.find("Content-Encoding");
+    if (encoding != response.header.end() && !encoding->second.empty() && encoding->second != "identity") {
+        pool_->compressed_transfers_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // CURLINFO_NUM_CONNECTS is the number of new connections curl had to open for
+    // the last transfer on this handle; 0 means an existing connection was reused.
+    long newConnections = 0;
+    if (curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &newConnections) != CURLE_OK) {
+        return;
+    }
+    if (newConnections > 0) {
+        pool_->connections_opened_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        pool_->connections_reused_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+// --- ConnectionPool ---
+
+ConnectionPool::ConnectionPool(size_t maxSessionsPerHost, const TransportOptions& options)
+    : shared_(std::make_unique<SharedCaches>()),
+      max_per_host_(maxSessionsPerHost == 0 ? 1 : maxSessionsPerHost), options_(options) {}
+
+ConnectionPool::~ConnectionPool() = default;
+
+void ConnectionPool::setTransportOptions(const TransportOptions& options) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+}
+
+ConnectionPool::Lease ConnectionPool::acquire(std::string_view host) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    HostSlot* slot = slotFor(host);
+
+    if (slot->idle.empty() && slot->total >= max_per_host_) {
+        waits_.fetch_add(1, std::memory_order_relaxed);
+        // A slot also frees up when another thread fails to build its session
+        available_.wait(lock, [this, slot] { return !slot->idle.empty() || slot->total < max_per_host_; });
+    }
+    return take(slot, lock);
+}
+
+std::optional<ConnectionPool::Lease> ConnectionPool::tryAcquire(std::string_view host) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    HostSlot* slot = slotFor(host);
+    if (slot->idle.empty() && slot->total >= max_per_host_) return std::nullopt;
+    return take(slot, lock);
+}
+
+ConnectionPool::HostSlot* ConnectionPool::slotFor(std::string_view host) {
+    auto it = hosts_.find(host);
+    if (it == hosts_.end()) {
+        it = hosts_.emplace(std::string(host), HostSlot{}).first;
+    }
+    return &it->second;
+}
+
+ConnectionPool::Lease ConnectionPool::take(HostSlot* slot, std::unique_lock<std::mutex>& lock) {
+    if (!slot->idle.empty()) {
+        std::unique_ptr<cpr::Session> session = std::move(slot->idle.back());
+        slot->idle.pop_back();
+        sessions_reused_.fetch_add(1, std::memory_order_relaxed);
+        return Lease(this, slot, std::move(session));
+    }
+
+    // Below the per-host limit: create a new handle outside of the lock
+    slot->total++;
+    TransportOptions options = options_;
+    lock.unlock();
+
+    // If building the session throws, hand the reserved slot back; otherwise
+    // `total` stays above what exists and acquire() eventually waits forever
+    struct Reservation {
+        ConnectionPool* pool;
+        HostSlot* slot;
+        bool kept = false;
+        ~Reservation() {
+            if (kept) return;
+            {
+                std::lock_guard<std::mutex> relock(pool->mutex_);
+                slot->total--;
+            }
+            pool->available_.notify_one();
+        }
+    } reservation{this, slot};
+
+    auto session = std::make_unique<cpr::Session>();
+    // Through cpr rather than curl_easy_setopt: cpr re-applies both before every request
+    switch (options.httpVersion) {
+        case TransportOptions::HttpVersion::Http1:
+            session->SetHttpVersion(cpr::HttpVersion{cpr::HttpVersionCode::VERSION_1_1});
+            break;
+        case TransportOptions::HttpVersion::Http2OverTls:
+            session->SetHttpVersion(cpr::HttpVersion{cpr::HttpVersionCode::VERSION_2_0_TLS});
+            break;
+        case TransportOptions::HttpVersion::Http2PriorKnowledge:
+            session->SetHttpVersion(cpr::HttpVersion{cpr::HttpVersionCode::VERSION_2_0_PRIOR_KNOWLEDGE});
+            break;
+    }
+    // An empty list makes curl offer all of its decoders; "disabled" sends no Accept-Encoding
+    session->SetAcceptEncoding(options.compression ? cpr::AcceptEncoding{}
+                                                   : cpr::AcceptEncoding{cpr::AcceptEncodingMethods::disabled});
+
+    // Ask the OS to keep idle connections alive between front-desk polls
+    CURL* handle = session->GetCurlHolder()->handle;
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    if (options.shareCaches && shared_->handle) curl_easy_setopt(handle, CURLOPT_SHARE, shared_->handle);
+    sessions_created_.fetch_add(1, std::memory_order_relaxed);
+    reservation.kept = true;
+    return Lease(this, slot, std::move(session));
+}
+
+void ConnectionPool::release(HostSlot* slot, std::unique_ptr<cpr::Session> session) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slot->idle.push_back(std::move(session));
+    }
+    available_.notify_one();
+}
+
+ConnectionStats ConnectionPool::stats() const {
+    ConnectionStats s;
+    s.sessionsCreated = sessions_created_.load(std::memory_order_relaxed);
+    s.sessionsReused = sessions_reused_.load(std::memory_order_relaxed);
+    s.connectionsOpened = connections_opened_.load(std::memory_order_relaxed);
+    s.connectionsReused = connections_reused_.load(std::memory_order_relaxed);
+    s.waits = waits_.load(std::memory_order_relaxed);
+    s.http2Transfers = http2_transfers_.load(std::memory_order_relaxed);
+    s.compressedTransfers = compressed_transfers_.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::string ConnectionPool::hostKey(const std::string& url) {
+    size_t start = url.find("://");
+    start = (start == std::string::npos) ? 0 : start + 3;
+    size_t end = url.find('/', start);
+    return url.substr(0, end); // npos -> whole string
+}
@@ -0,0 +1,135 @@
+// src/ConnectionPool.h
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Forward declare cpr types so users of the pool don't need the cpr headers
+namespace cpr {
+    class Session;
+    class Response;
+}
+
+// --- Transport Options ---
+// Protocol settings applied to every session the pool creates
+struct TransportOptions {
+    enum class HttpVersion {
+        Http1,                 // HTTP/1.1 only
+        Http2OverTls,          // HTTP/2 where TLS ALPN offers it (https), HTTP/1.1 otherwise
+        Http2PriorKnowledge    // HTTP/2 without negotiation (h2c), for plain-http backends known to speak it
+    };
+    HttpVersion httpVersion = HttpVersion::Http2OverTls;
+    // Advertise every Content-Encoding curl was built with (gzip, deflate, br, zstd);
+    // curl decodes chunks as they arrive, so response.text is always plain JSON
+    bool compression = true;
+    // One DNS cache, TLS session cache and connection cache for all the pool's
+    // handles, so a handle reuses a connection or TLS session another one opened
+    bool shareCaches = true;
+};
+
+// --- Connection Statistics ---
+// Snapshot of the pool counters, used to confirm keep-alive savings in production
+struct ConnectionStats {
+    uint64_t sessionsCreated = 0;    // curl handles created by the pool
+    uint64_t sessionsReused = 0;     // leases served from an idle pooled handle
+    uint64_t connectionsOpened = 0;  // requests that had to open a new TCP/TLS connection
+    uint64_t connectionsReused = 0;  // requests served over a kept-alive connection
+    uint64_t waits = 0;              // leases that had to wait for a free handle
+    uint64_t http2Transfers = 0;     // requests answered over HTTP/2 (or newer)
+    uint64_t compressedTransfers = 0; // responses that came with a Content-Encoding
+};
+
+
+// --- ConnectionPool ---
+// Keeps reusable cpr::Session objects (one curl easy handle each) per host.
+// A curl handle keeps its connection alive between transfers, so handing the
+// same session back out skips the TCP handshake (and TLS, when used).
+class ConnectionPool {
+private:
+    struct HostSlot {
+        std::vector<std::unique_ptr<cpr::Session>> idle;
+        size_t total = 0; // idle + leased sessions for this host
+    };
+
+public:
+    // RAII handle for a pooled session; returns the session to the pool when destroyed
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        cpr::Session& session() { return *session_; }
+
+        // Call after each transfer so the pool can count new vs reused connections,
+        // the negotiated HTTP version and compressed responses
+        void recordTransfer(const cpr::Response& response);
+
+    private:
+        friend class ConnectionPool;
+        Lease(ConnectionPool* pool, HostSlot* slot, std::unique_ptr<cpr::Session> session);
+
+        ConnectionPool* pool_;
+        HostSlot* slot_;
+        std::unique_ptr<cpr::Session> session_;
+    };
+
+    explicit ConnectionPool(size_t maxSessionsPerHost = 4, const TransportOptions& options = {});
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Borrow a session for the given host key (see hostKey()). Blocks while the
+    // host already has maxSessionsPerHost sessions leased out.
+    Lease acquire(std::string_view host);
+    // Like acquire(), but gives up instead of waiting when the host is at its limit
+    std::optional<Lease> tryAcquire(std::string_view host);
+
+    ConnectionStats stats() const;
+    size_t maxSessionsPerHost() const { return max_per_host_; }
+    // Affects sessions created from now on; set it before the first acquire()
+    void setTransportOptions(const TransportOptions& options);
+
+    // "scheme://host:port" part of a URL, used as the pool key
+    static std::string hostKey(const std::string& url);
+
+private:
+    HostSlot* slotFor(std::string_view host);                        // Call with mutex_ held
+    Lease take(HostSlot* slot, std::unique_lock<std::mutex>& lock);  // Idle or new session; may unlock
+    void release(HostSlot* slot, std::unique_ptr<cpr::Session> session);
+
+    // curl share handle behind TransportOptions::shareCaches (ConnectionPool.cpp).
+    // Declared before hosts_ so it outlives every session attached to it.
+    struct SharedCaches;
+    std::unique_ptr<SharedCaches> shared_;
+
+    const size_t max_per_host_;
+    TransportOptions options_; // Guarded by mutex_
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::map<std::string, HostSlot, std::less<>> hosts_; // std::map keeps HostSlot addresses stable
+
+    std::atomic<uint64_t> sessions_created_{0};
+    std::atomic<uint64_t> sessions_reused_{0};
+    std::atomic<uint64_t> connections_opened_{0};
+    std::atomic<uint64_t> connections_reused_{0};
+    std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> http2_transfers_{0};
+    std::atomic<uint64_t> compressed_transfers_{0};
+};
+
+#endif // CONNECTION_POOL_H
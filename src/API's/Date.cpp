@@ -0,0 +1,148 @@
+// src/Date.cpp
+#include "Date.h"
+#include <ostream>
+
+namespace {
+
+// Two ASCII digits starting at p, or -1
+inline int twoDigits(const char* p) {
+    unsigned hi = static_cast<unsigned>(p[0] - '0');
+    unsigned lo = static_cast<unsigned>(p[1] - '0');
+    return hi < 10 && lo < 10 ? static_cast<int>(hi * 10 + lo) : -1;
+}
+
+inline void putTwoDigits(char* out, int value) {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+constexpr bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(int year, int month) {
+    static const int kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : kDays[month - 1];
+}
+
+} // namespace
+
+// --- Date ---
+
+bool Date::parse(std::string_view text, Date& out) {
+    if (text.size() < 10 || text[4] != '-' || text[7] != '-') return false;
+    if (text.size() > 10 && text[10] != 'T' && text[10] != ' ') return false;
+
+    const char* p = text.data();
+    int century = twoDigits(p);
+    int yearOfCentury = twoDigits(p + 2);
+    int month = twoDigits(p + 5);
+    int day = twoDigits(p + 8);
+    if (century < 0 || yearOfCentury < 0 || month < 1 || month > 12 || day < 1) return false;
+    int year = century * 100 + yearOfCentury;
+    if (day > daysInMonth(year, month)) return false;
+
+    out = fromCivil(year, month, day);
+    return true;
+}
+
+// Howard Hinnant's civil_from_days
+void Date::toCivil(int& year, int& month, int& day) const {
+    int32_t z = days_ + 719468;
+    int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int32_t doe = z - era * 146097;
+    int32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int32_t mp = (5 * doy + 2) / 153;
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(yoe + era * 400 + (month <= 2));
+}
+
+char* Date::format(char* out) const {
+    if (!isSet()) return out;
+    int year, month, day;
+    toCivil(year, month, day);
+    putTwoDigits(out, year / 100 % 100);
+    putTwoDigits(out + 2, year % 100);
+    out[4] = '-';
+    putTwoDigits(out + 5, month);
+    out[7] = '-';
+    putTwoDigits(out + 8, day);
+    return out + 10;
+}
+
+std::string Date::toString() const {
+    char buffer[10];
+    return std::string(buffer, format(buffer));
+}
+
+// --- TimeOfDay ---
+
+bool TimeOfDay::parse(std::string_view text, TimeOfDay& out) {
+    if ((text.size() != 5 && text.size() != 8) || text[2] != ':') return false;
+    int hour = twoDigits(text.data());
+    int minute = twoDigits(text.data() + 3);
+    int second = 0;
+    if (text.size() == 8) {
+        if (text[5] != ':') return false;
+        second = twoDigits(text.data() + 6);
+    }
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) return false;
+
+    out.seconds_ = hour * 3600 + minute * 60 + second;
+    out.with_seconds_ = text.size() == 8;
+    return true;
+}
+
+char* TimeOfDay::format(char* out) const {
+    if (!isSet()) return out;
+    putTwoDigits(out, hour());
+    out[2] = ':';
+    putTwoDigits(out + 3, minute());
+    if (!with_seconds_) return out + 5;
+    out[5] = ':';
+    putTwoDigits(out + 6, seconds_ % 60);
+    return out + 8;
+}
+
+std::string TimeOfDay::toString() const {
+    char buffer[8];
+    return std::string(buffer, format(buffer));
+}
+
+// --- Streams & JSON ---
+
+std::ostream& operator<<(std::ostream& out, const Date& date) {
+    return out << date.toString();
+}
+
+std::ostream& operator<<(std::ostream& out, const TimeOfDay& time) {
+    return out << time.toString();
+}
+
+void to_json(nlohmann::json& j, const Date& date) {
+    j = date.toString();
+}
+
+void from_json(const nlohmann::json& j, Date& date) {
+    date = Date();
+    if (j.is_null()) return;
+    const std::string& text = j.get_ref<const std::string&>(); // type_error if not a string
+    if (!text.empty() && !Date::parse(text, date)) {
+        throw nlohmann::json::type_error::create(302, "invalid date '" + text + "', expected YYYY-MM-DD", &j);
+    }
+}
+
+void to_json(nlohmann::json& j, const TimeOfDay& time) {
+    j = time.toString();
+}
+
+void from_json(const nlohmann::json& j, TimeOfDay& time) {
+    time = TimeOfDay();
+    if (j.is_null()) return;
+    const std::string& text = j.get_ref<const std::string&>();
+    if (!text.empty() && !TimeOfDay::parse(text, time)) {
+        throw nlohmann::json::type_error::create(302, "invalid time '" + text + "', expected HH:MM", &j);
+    }
+}
@@ -0,0 +1,112 @@
+// src/Date.h
+#ifndef DATE_H
+#define DATE_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+
+// --- Date ---
+// Calendar date stored as a day number (days since 1970-01-01), parsed once
+// from the API's "YYYY-MM-DD" so comparisons, overlap checks and night counts
+// are integer operations. A default-constructed Date is unset and serializes
+// as "" like the empty strings it replaces.
+class Date {
+public:
+    constexpr Date() = default;
+
+    static constexpr Date fromDays(int32_t days) {
+        Date date;
+        date.days_ = days;
+        return date;
+    }
+
+    // Howard Hinnant's days_from_civil; arguments must form a valid date
+    static constexpr Date fromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        int32_t era = (year >= 0 ? year : year - 399) / 400;
+        int32_t yoe = year - era * 400;
+        int32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return fromDays(era * 146097 + doe - 719468);
+    }
+
+    // Strict "YYYY-MM-DD". A trailing time ("YYYY-MM-DDTHH:MM..." or with a
+    // space) is accepted and dropped. Returns false and leaves `out` alone otherwise.
+    static bool parse(std::string_view text, Date& out);
+
+    constexpr bool isSet() const { return days_ != kUnset; }
+    constexpr int32_t days() const { return days_; }
+
+    void toCivil(int& year, int& month, int& day) const;
+    std::string toString() const;   // "YYYY-MM-DD", or "" when unset
+    char* format(char* out) const;  // Writes 10 chars (nothing when unset); returns the end
+
+    constexpr Date operator+(int32_t days) const { return fromDays(days_ + days); }
+    constexpr Date operator-(int32_t days) const { return fromDays(days_ - days); }
+    friend constexpr int32_t operator-(Date a, Date b) { return a.days_ - b.days_; } // Nights from b to a
+
+    friend constexpr bool operator==(Date a, Date b) { return a.days_ == b.days_; }
+    friend constexpr bool operator!=(Date a, Date b) { return a.days_ != b.days_; }
+    friend constexpr bool operator<(Date a, Date b) { return a.days_ < b.days_; }
+    friend constexpr bool operator<=(Date a, Date b) { return a.days_ <= b.days_; }
+    friend constexpr bool operator>(Date a, Date b) { return a.days_ > b.days_; }
+    friend constexpr bool operator>=(Date a, Date b) { return a.days_ >= b.days_; }
+
+private:
+    static constexpr int32_t kUnset = std::numeric_limits<int32_t>::min();
+    int32_t days_ = kUnset;
+};
+
+// --- TimeOfDay ---
+// Wall-clock time such as a housekeeping slot, stored as seconds since
+// midnight. Accepts "HH:MM" and "HH:MM:SS" and writes back the same form.
+class TimeOfDay {
+public:
+    constexpr TimeOfDay() = default;
+
+    static constexpr TimeOfDay fromMinutes(int minutes) {
+        TimeOfDay time;
+        time.seconds_ = minutes * 60;
+        return time;
+    }
+    // Negative means unset; written back as "HH:MM:SS" only when the seconds aren't zero
+    static constexpr TimeOfDay fromSeconds(int32_t seconds) {
+        TimeOfDay time;
+        time.seconds_ = seconds < 0 ? -1 : seconds;
+        time.with_seconds_ = seconds > 0 && seconds % 60 != 0;
+        return time;
+    }
+
+    static bool parse(std::string_view text, TimeOfDay& out);
+
+    constexpr bool isSet() const { return seconds_ >= 0; }
+    constexpr int32_t secondsOfDay() const { return seconds_; }
+    constexpr int hour() const { return seconds_ / 3600; }
+    constexpr int minute() const { return seconds_ / 60 % 60; }
+
+    std::string toString() const; // "HH:MM" or "HH:MM:SS", or "" when unset
+    char* format(char* out) const; // Writes 5 or 8 chars (nothing when unset); returns the end
+
+    friend constexpr bool operator==(TimeOfDay a, TimeOfDay b) { return a.seconds_ == b.seconds_; }
+    friend constexpr bool operator!=(TimeOfDay a, TimeOfDay b) { return a.seconds_ != b.seconds_; }
+    friend constexpr bool operator<(TimeOfDay a, TimeOfDay b) { return a.seconds_ < b.seconds_; }
+
+private:
+    int32_t seconds_ = -1;
+    bool with_seconds_ = false;
+};
+
+std::ostream& operator<<(std::ostream& out, const Date& date);
+std::ostream& operator<<(std::ostream& out, const TimeOfDay& time);
+
+// JSON as the original strings: "" for unset (null also reads as unset), malformed input is a type_error
+void to_json(nlohmann::json& j, const Date& date);
+void from_json(const nlohmann::json& j, Date& date);
+void to_json(nlohmann::json& j, const TimeOfDay& time);
+void from_json(const nlohmann::json& j, TimeOfDay& time);
+
+#endif // DATE_H
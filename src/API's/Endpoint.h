@@ -0,0 +1,188 @@
+// src/Endpoint.h
+#ifndef ENDPOINT_H
+#define ENDPOINT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "DataStructures.h"
+#include "RequestBuilder.h"
+
+// --- HTTP Methods ---
+enum class HttpMethod : uint8_t { Get, Post, Put, Delete };
+
+constexpr std::string_view methodName(HttpMethod method) {
+    switch (method) {
+        case HttpMethod::Get: return "GET";
+        case HttpMethod::Post: return "POST";
+        case HttpMethod::Put: return "PUT";
+        case HttpMethod::Delete: return "DELETE";
+    }
+    return "GET";
+}
+
+// For methods stored as text (journal entries); std::nullopt if unsupported
+constexpr std::optional<HttpMethod> parseMethod(std::string_view name) {
+    if (name == "GET") return HttpMethod::Get;
+    if (name == "POST") return HttpMethod::Post;
+    if (name == "PUT") return HttpMethod::Put;
+    if (name == "DELETE") return HttpMethod::Delete;
+    return std::nullopt;
+}
+
+
+// --- Expected Statuses ---
+// The HTTP statuses a call accepts as success, e.g. {200, 204} for a delete
+// that may or may not return a body. A single int converts implicitly.
+class StatusSet {
+public:
+    constexpr StatusSet(int status) : statuses_{status}, count_(1) {}
+    constexpr StatusSet(std::initializer_list<int> statuses) {
+        for (int status : statuses) {
+            if (count_ < statuses_.size()) statuses_[count_++] = status;
+        }
+    }
+
+    constexpr bool contains(long status) const {
+        for (size_t i = 0; i < count_; ++i) {
+            if (statuses_[i] == status) return true;
+        }
+        return false;
+    }
+
+    std::string toString() const { // "200 or 204"
+        std::string text;
+        for (size_t i = 0; i < count_; ++i) {
+            if (i) text += " or ";
+            text += std::to_string(statuses_[i]);
+        }
+        return text;
+    }
+
+private:
+    std::array<int, 4> statuses_{};
+    size_t count_ = 0;
+};
+
+
+// --- Response Shapes ---
+// What a successful response body holds, and what a call returns for it
+enum class ShapeKind { Status, Document, One, Many };
+
+namespace shape {
+
+struct Status {   // Nothing worth decoding: bool
+    static constexpr ShapeKind kind = ShapeKind::Status;
+    using Result = bool;
+};
+struct Document { // Not a resource envelope (login, refunds): the parsed body
+    static constexpr ShapeKind kind = ShapeKind::Document;
+    using Result = std::optional<nlohmann::json>;
+};
+template <typename T>
+struct One {      // {"data": {...}}, stream-decoded into T
+    static constexpr ShapeKind kind = ShapeKind::One;
+    using Record = T;
+    using Result = std::optional<T>;
+};
+template <typename T>
+struct Many {     // {"data": [...]}, stream-decoded into T
+    static constexpr ShapeKind kind = ShapeKind::Many;
+    using Record = T;
+    using Result = std::optional<std::vector<T>>;
+};
+
+} // namespace shape
+
+
+// --- Endpoint ---
+// Everything fixed about a route, known at compile time. ApiClient::call<E>
+// takes the descriptor as a template argument, so each endpoint gets its own
+// request and decode path with the method, statuses and shape built in rather
+// than looked up per call. The pattern holds at most one "{id}" placeholder.
+template <typename ShapeT>
+struct Endpoint {
+    using Shape = ShapeT;
+    using Result = typename ShapeT::Result;
+
+    HttpMethod method;
+    std::string_view pattern; // e.g. "/rooms/{id}"
+    StatusSet expected;
+    bool requiresAuth;
+    bool hedged = false;      // GETs only: race a second copy when slow (HedgePolicy)
+
+    constexpr bool hasId() const { return pattern.find("{id}") != std::string_view::npos; }
+    constexpr std::string_view prefix() const { return pattern.substr(0, pattern.find("{id}")); }
+    constexpr std::string_view suffix() const { return hasId() ? pattern.substr(pattern.find("{id}") + 4) : std::string_view(); }
+};
+
+// The result type of ApiClient::call<E>
+template <const auto& E>
+using EndpointResult = typename std::decay_t<decltype(E)>::Result;
+
+// E's pattern with "{id}" filled in: endpointPath<endpoints::getRoom>(42) is "/rooms/42"
+template <const auto& E, typename Id>
+RequestPath endpointPath(const Id& id) {
+    static_assert(E.hasId(), "endpoint pattern has no {id} placeholder");
+    RequestPath path;
+    path.append(E.prefix());
+    if constexpr (std::is_integral_v<Id>) path.append(static_cast<long long>(id));
+    else path.append(std::string_view(id));
+    return path.append(E.suffix());
+}
+
+
+// --- Endpoint Table ---
+// The Laravel routes the client uses. Adding one is a line here plus, if it
+// returns a new record type, an assignField overload (JsonStreamDecoder.h).
+namespace endpoints {
+
+// Auth
+inline constexpr Endpoint<shape::Document> login{HttpMethod::Post, "/login", 200, false};
+inline constexpr Endpoint<shape::Document> signup{HttpMethod::Post, "/signup", 201, false};
+inline constexpr Endpoint<shape::Status> logout{HttpMethod::Post, "/logout", {200, 204}, true};
+
+// Rooms
+inline constexpr Endpoint<shape::Many<Room>> listRooms{HttpMethod::Get, "/rooms", 200, false};
+inline constexpr Endpoint<shape::One<Room>> getRoom{HttpMethod::Get, "/rooms/{id}", 200, false, true};
+inline constexpr Endpoint<shape::One<Room>> createRoom{HttpMethod::Post, "/rooms", 201, true};
+inline constexpr Endpoint<shape::Status> updateRoom{HttpMethod::Put, "/rooms/{id}", 200, true};
+inline constexpr Endpoint<shape::Status> deleteRoom{HttpMethod::Delete, "/rooms/{id}", {200, 204}, true};
+inline constexpr Endpoint<shape::One<Room>> setRoomMaintenance{HttpMethod::Post, "/admin/rooms/{id}/maintenance", 200, true};
+
+// Bookings
+inline constexpr Endpoint<shape::One<Booking>> createBooking{HttpMethod::Post, "/bookings", 201, true};
+inline constexpr Endpoint<shape::One<Booking>> getBooking{HttpMethod::Get, "/bookings/{id}", 200, true, true};
+inline constexpr Endpoint<shape::Status> deleteBooking{HttpMethod::Delete, "/bookings/{id}", {200, 204}, true};
+
+// Reservations (front desk view of bookings)
+inline constexpr Endpoint<shape::Many<Booking>> listReservations{HttpMethod::Get, "/reservations", 200, true};
+inline constexpr Endpoint<shape::One<Booking>> getReservation{HttpMethod::Get, "/reservations/{id}", 200, true, true};
+inline constexpr Endpoint<shape::One<Booking>> checkInReservation{HttpMethod::Post, "/reservations/{id}/check-in", 200, true};
+inline constexpr Endpoint<shape::One<Booking>> checkOutReservation{HttpMethod::Post, "/reservations/{id}/check-out", 200, true};
+inline constexpr Endpoint<shape::One<Booking>> cancelReservation{HttpMethod::Post, "/reservations/{id}/cancel", 200, true};
+
+// Maintenance
+inline constexpr Endpoint<shape::Many<MaintenanceTask>> listMaintenanceTasks{HttpMethod::Get, "/maintenance/tasks", 200, true};
+inline constexpr Endpoint<shape::One<MaintenanceTask>> getMaintenanceTask{HttpMethod::Get, "/maintenance/tasks/{id}", 200, true};
+inline constexpr Endpoint<shape::Status> completeMaintenanceTask{HttpMethod::Post, "/maintenance/tasks/{id}/complete", 200, true};
+
+// Payments ({id} is the transaction id)
+inline constexpr Endpoint<shape::One<Payment>> createPayment{HttpMethod::Post, "/payments", {200, 201}, true};
+inline constexpr Endpoint<shape::One<Payment>> getPayment{HttpMethod::Get, "/payments/{id}", 200, true};
+inline constexpr Endpoint<shape::Document> refundPayment{HttpMethod::Post, "/payments/{id}/refund", 200, true};
+
+// User
+inline constexpr Endpoint<shape::One<User>> getUser{HttpMethod::Get, "/user/{id}", 200, true};
+inline constexpr Endpoint<shape::Status> updateUser{HttpMethod::Put, "/user/{id}", 200, true};
+
+} // namespace endpoints
+
+#endif // ENDPOINT_H
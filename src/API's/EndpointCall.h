@@ -0,0 +1,65 @@
+// src/EndpointCall.h
+#ifndef ENDPOINT_CALL_H
+#define ENDPOINT_CALL_H
+
+// Definitions of ApiClient::call and ApiClient::receive. Included by the
+// ApiClient_*.cpp files that use them, so ApiClient.h stays free of cpr and
+// the decoders. Each endpoint descriptor instantiates its own copy, with the
+// method, auth, statuses and shape as constants.
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpr/cpr.h>
+#include "ApiClient.h"
+#include "Endpoint.h"
+#include "JsonStreamDecoder.h"
+#include "Logger.h"
+
+template <const auto& E>
+EndpointResult<E> ApiClient::call(std::string_view path, std::string_view body) {
+    if constexpr (E.requiresAuth) {
+        if (!isAuthenticated()) {
+            LOG_ERROR("[API Error] Authentication required for " << methodName(E.method) << " " << E.pattern << ".");
+            return EndpointResult<E>();
+        }
+    }
+    if constexpr (E.method == HttpMethod::Post || E.method == HttpMethod::Put) {
+        if (body.empty()) body = "{}"; // Actions without fields (check-in, cancel) still send an object
+    }
+    LOG_DEBUG("[API Request] " << methodName(E.method) << " " << path);
+    constexpr bool hedged = E.hedged && E.method == HttpMethod::Get;
+    return receive<E>(sendSerialized(E.method, path, E.requiresAuth, body, nullptr, hedged), path);
+}
+
+template <const auto& E>
+EndpointResult<E> ApiClient::receive(const std::optional<cpr::Response>& response, std::string_view path) {
+    using Shape = typename std::decay_t<decltype(E)>::Shape;
+    constexpr std::string_view method = methodName(E.method);
+    if (!response || !checkResponse(*response, E.expected)) return EndpointResult<E>(); // Logged by checkResponse
+
+    if constexpr (Shape::kind == ShapeKind::Status) {
+        return true;
+    } else {
+        RequestMetrics::ParseTimer parseTimer(metrics_, method, path);
+        if constexpr (Shape::kind == ShapeKind::Document) {
+            return parseDocument(*response);
+        } else {
+            // Stream-decoded straight from the response bytes (no json DOM)
+            std::string decodeError;
+            if constexpr (Shape::kind == ShapeKind::One) {
+                typename Shape::Record record;
+                if (decodeDataObject(response->text, record, decodeError)) return record;
+            } else {
+                std::vector<typename Shape::Record> records;
+                if (decodeDataArray(response->text, records, decodeError)) return records;
+            }
+            LOG_ERROR("[JSON Error] Failed to convert " << method << " " << path << " response: " << decodeError);
+            return std::nullopt;
+        }
+    }
+}
+
+#endif // ENDPOINT_CALL_H
@@ -0,0 +1,50 @@
+// src/JournalReplayer.cpp
+#include "JournalReplayer.h"
+#include "ApiClient.h"
+#include "Logger.h"
+#include <algorithm>
+
+JournalReplayer::JournalReplayer(ApiClient& client, std::chrono::milliseconds interval,
+                                 std::chrono::milliseconds maxInterval)
+    : client_(client), interval_(interval), max_interval_(std::max(interval, maxInterval)),
+      thread_([this] { run(); }) {}
+
+JournalReplayer::~JournalReplayer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    thread_.join();
+}
+
+void JournalReplayer::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        woken_ = true;
+    }
+    wakeup_.notify_all();
+}
+
+void JournalReplayer::run() {
+    std::chrono::milliseconds delay = interval_;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wakeup_.wait_for(lock, delay, [this] { return stopping_ || woken_; });
+        if (stopping_) break;
+        woken_ = false;
+        if (client_.queuedWrites() == 0) { // Also 0 when logged out
+            delay = interval_;
+            continue;
+        }
+
+        lock.unlock();
+        size_t delivered = client_.replayJournal();
+        size_t left = client_.queuedWrites();
+        lock.lock();
+
+        if (delivered > 0) LOG_INFO("[Offline] Synced " << delivered << " queued write(s), " << left << " left");
+        // Back off while the API is down; keep the normal pace once it takes writes again
+        delay = (left > 0 && delivered == 0) ? std::min(delay * 2, max_interval_) : interval_;
+    }
+}
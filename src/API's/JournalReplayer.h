@@ -0,0 +1,44 @@
+// src/JournalReplayer.h
+#ifndef JOURNAL_REPLAYER_H
+#define JOURNAL_REPLAYER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class ApiClient;
+
+// --- JournalReplayer ---
+// Background thread that drains a MutationJournal through ApiClient::replayJournal()
+// whenever the logged-in user has writes queued. While the API stays
+// unreachable the wait between rounds doubles, up to maxInterval; a round that
+// empties the journal resets it. Once the API is back the whole backlog goes
+// out in one round over the client's kept-alive connections.
+class JournalReplayer {
+public:
+    explicit JournalReplayer(ApiClient& client,
+                             std::chrono::milliseconds interval = std::chrono::seconds(2),
+                             std::chrono::milliseconds maxInterval = std::chrono::seconds(60));
+    ~JournalReplayer(); // Stops after the current round
+
+    JournalReplayer(const JournalReplayer&) = delete;
+    JournalReplayer& operator=(const JournalReplayer&) = delete;
+
+    void wake(); // Try now, e.g. right after a login
+
+private:
+    void run();
+
+    ApiClient& client_;
+    std::chrono::milliseconds interval_;
+    std::chrono::milliseconds max_interval_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeup_;
+    bool woken_ = false;
+    bool stopping_ = false;
+    std::thread thread_; // Last, so it starts after the members above
+};
+
+#endif // JOURNAL_REPLAYER_H
@@ -0,0 +1,153 @@
+// src/JsonStreamDecoder.cpp
+#include "JsonStreamDecoder.h"
+#include <charconv>
+#include <system_error>
+#include <utility>
+
+// Keys mirror the NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE lists in DataStructures.h
+
+namespace {
+
+bool setInt(int& field, const SaxScalar& value) {
+    if (value.kind == SaxScalar::Kind::Null) return true;
+    if (!value.isNumber()) return false;
+    field = static_cast<int>(value.asInteger());
+    return true;
+}
+
+bool setDouble(double& field, const SaxScalar& value) {
+    if (value.kind == SaxScalar::Kind::Null) return true;
+    if (!value.isNumber()) return false;
+    field = value.asDouble();
+    return true;
+}
+
+// Laravel sends decimal:2 columns as strings ("120.00"). The whole string must be
+// the number, and it is read with '.' whatever the C locale says
+bool setDecimal(double& field, const SaxScalar& value) {
+    if (value.kind != SaxScalar::Kind::String) return setDouble(field, value);
+    const char* first = value.text->data();
+    const char* last = first + value.text->size();
+    double parsed = 0.0;
+    std::from_chars_result result = std::from_chars(first, last, parsed);
+    if (result.ec != std::errc() || result.ptr != last) return false;
+    field = parsed;
+    return true;
+}
+
+bool setBool(bool& field, const SaxScalar& value) {
+    if (value.kind == SaxScalar::Kind::Null) return true;
+    if (value.kind != SaxScalar::Kind::Boolean) return false;
+    field = value.boolean;
+    return true;
+}
+
+bool setString(std::string& field, SaxScalar& value) {
+    if (value.kind == SaxScalar::Kind::Null) return true;
+    if (value.kind != SaxScalar::Kind::String) return false;
+    field = std::move(*value.text); // Take the parser's buffer instead of copying
+    return true;
+}
+
+// Categorical fields are interned straight from the parser's buffer
+bool setSymbol(Symbol& field, const SaxScalar& value) {
+    if (value.kind == SaxScalar::Kind::Null) return true;
+    if (value.kind != SaxScalar::Kind::String) return false;
+    field = Symbol(*value.text);
+    return true;
+}
+
+// Dates and times are parsed straight from the parser's buffer; "" and null stay unset
+bool setDate(Date& field, const SaxScalar& value) {
+    if (value.kind == SaxScalar::Kind::Null) return true;
+    if (value.kind != SaxScalar::Kind::String) return false;
+    return value.text->empty() || Date::parse(*value.text, field);
+}
+
+bool setTime(TimeOfDay& field, const SaxScalar& value) {
+    if (value.kind == SaxScalar::Kind::Null) return true;
+    if (value.kind != SaxScalar::Kind::String) return false;
+    return value.text->empty() || TimeOfDay::parse(*value.text, field);
+}
+
+} // namespace
+
+// --- Room ---
+bool assignField(Room& room, std::string_view key, SaxScalar& value, bool element) {
+    if (element) {
+        if (key == "amenities") {
+            if (value.kind != SaxScalar::Kind::String) return false;
+            room.amenities.insert(std::string_view(*value.text));
+        }
+        return true;
+    }
+    if (key == "id") return setInt(room.id, value);
+    if (key == "name") return setString(room.name, value);
+    if (key == "type") return setSymbol(room.type, value);
+    if (key == "price") return setDouble(room.price, value);
+    if (key == "bedSize") return setSymbol(room.bedSize, value);
+    if (key == "view") return setSymbol(room.view, value);
+    if (key == "capacity") return setInt(room.capacity, value);
+    if (key == "description") return setString(room.description, value);
+    if (key == "image") return setString(room.image, value);
+    if (key == "available") return setBool(room.available, value);
+    return true; // amenities: null, or an unknown key
+}
+
+// --- Booking ---
+bool assignField(Booking& booking, std::string_view key, SaxScalar& value, bool element) {
+    if (element) return true; // Booking has no array fields
+    if (key == "id") return setInt(booking.id, value);
+    if (key == "userId") return setInt(booking.userId, value);
+    if (key == "roomId") return setInt(booking.roomId, value);
+    if (key == "checkIn") return setDate(booking.checkIn, value);
+    if (key == "checkOut") return setDate(booking.checkOut, value);
+    if (key == "guests") return setInt(booking.guests, value);
+    if (key == "status") return setString(booking.status, value);
+    if (key == "package") return setString(booking.package, value);
+    if (key == "housekeeping") return setBool(booking.housekeeping, value);
+    if (key == "housekeepingTime") return setTime(booking.housekeepingTime, value);
+    if (key == "parking") return setBool(booking.parking, value);
+    if (key == "totalPrice") return setDecimal(booking.totalPrice, value);
+    return true;
+}
+
+// --- User ---
+bool assignField(User& user, std::string_view key, SaxScalar& value, bool element) {
+    if (element) return true;
+    if (key == "id") return setInt(user.id, value);
+    if (key == "username") return setString(user.username, value);
+    if (key == "email") return setString(user.email, value);
+    if (key == "phone") return setString(user.phone, value);
+    if (key == "age") return setInt(user.age, value);
+    if (key == "role") return setString(user.role, value);
+    return true;
+}
+
+// --- MaintenanceTask ---
+bool assignField(MaintenanceTask& task, std::string_view key, SaxScalar& value, bool element) {
+    if (element) return true; // items_used, child_tasks, ...: not kept
+    if (key == "id") return setInt(task.id, value);
+    if (key == "status") return setString(task.status, value);
+    if (key == "scheduled_date") return setString(task.scheduled_date, value);
+    if (key == "completed_at") return setString(task.completed_at, value);
+    if (key == "notes") return setString(task.notes, value);
+    if (key == "actual_duration") return setInt(task.actual_duration, value);
+    if (key == "parent_task_id") return setInt(task.parent_task_id, value);
+    if (key == "recurrence_rule") return setString(task.recurrence_rule, value);
+    return true;
+}
+
+// --- Payment ---
+bool assignField(Payment& payment, std::string_view key, SaxScalar& value, bool element) {
+    if (element) return true;
+    if (key == "id") return setInt(payment.id, value);
+    if (key == "transaction_id") return setString(payment.transaction_id, value);
+    if (key == "amount") return setDecimal(payment.amount, value);
+    if (key == "currency") return setString(payment.currency, value);
+    if (key == "booking_id") return setInt(payment.booking_id, value);
+    if (key == "payment_method") return setString(payment.payment_method, value);
+    if (key == "status") return setString(payment.status, value);
+    if (key == "refund_reason") return setString(payment.refund_reason, value);
+    return true;
+}
@@ -0,0 +1,269 @@
+// src/JsonStreamDecoder.h
+#ifndef JSON_STREAM_DECODER_H
+#define JSON_STREAM_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "DataStructures.h"
+
+using json = nlohmann::json;
+
+// --- Streaming (SAX) decoding of Laravel resource envelopes ---
+// Fills Room/Booking/User structs straight from the response bytes, without
+// building an intermediate nlohmann::json tree. Only the "data" member of the
+// top-level object is decoded, plus the paginator's "links.next" and "meta"
+// counters when a PageInfo is supplied, and the delta-sync "deleted" ids and
+// "meta" cursor when a SyncInfo is; everything else is skipped.
+// String values are moved out of the parser's token buffer, so every string is
+// allocated once, in its final place.
+
+// One scalar JSON value as delivered by the SAX parser
+struct SaxScalar {
+    enum class Kind { Null, Boolean, Integer, Float, String };
+    Kind kind = Kind::Null;
+    bool boolean = false;
+    int64_t integer = 0;
+    double number = 0.0;
+    std::string* text = nullptr; // Owned by the parser; fields may move from it
+
+    bool isNumber() const { return kind == Kind::Integer || kind == Kind::Float; }
+    double asDouble() const { return kind == Kind::Integer ? static_cast<double>(integer) : number; }
+    int64_t asInteger() const { return kind == Kind::Integer ? integer : static_cast<int64_t>(number); }
+};
+
+// Laravel paginator fields ("links" / "meta") found next to "data"
+struct PageInfo {
+    std::string next;     // links.next (absolute URL), empty on the last page
+    int currentPage = 0;  // meta.current_page
+    int lastPage = 0;     // meta.last_page
+    int perPage = 0;      // meta.per_page
+    int total = 0;        // meta.total
+};
+
+// Delta-sync fields of a ?updated_since= response, found next to "data"
+struct SyncInfo {
+    std::string cursor;       // meta.sync_cursor: pass back as updated_since next time
+    bool full = false;        // meta.full_sync: "data" is the whole collection, not a delta
+    std::vector<int> deleted; // Top-level "deleted": ids removed since the cursor
+};
+
+// Assign `value` to the field named `key`. `element` is true for items of an
+// array-valued field (e.g. Room::amenities). Unknown keys and nulls are ignored
+// (fields keep their defaults); false means a type mismatch.
+bool assignField(Room& room, std::string_view key, SaxScalar& value, bool element);
+bool assignField(Booking& booking, std::string_view key, SaxScalar& value, bool element);
+bool assignField(User& user, std::string_view key, SaxScalar& value, bool element);
+bool assignField(MaintenanceTask& task, std::string_view key, SaxScalar& value, bool element);
+bool assignField(Payment& payment, std::string_view key, SaxScalar& value, bool element);
+
+
+// SAX handler that decodes {"data": [...]} into a vector, or {"data": {...}} into one record
+template <typename T>
+class DataEnvelopeDecoder {
+public:
+    using number_integer_t = json::number_integer_t;
+    using number_unsigned_t = json::number_unsigned_t;
+    using number_float_t = json::number_float_t;
+    using string_t = json::string_t;
+    using binary_t = json::binary_t;
+
+    explicit DataEnvelopeDecoder(std::vector<T>& out, PageInfo* page = nullptr, SyncInfo* sync = nullptr)
+        : records_(out), page_(page), sync_(sync) {}
+
+    bool foundData() const { return found_data_; }
+    bool dataWasArray() const { return data_was_array_; }
+    const std::string& error() const { return error_; }
+
+    // --- Scalars ---
+    bool null() { SaxScalar v; return scalar(v); }
+    bool boolean(bool b) { SaxScalar v; v.kind = SaxScalar::Kind::Boolean; v.boolean = b; return scalar(v); }
+    bool number_integer(number_integer_t n) { SaxScalar v; v.kind = SaxScalar::Kind::Integer; v.integer = n; return scalar(v); }
+    bool number_unsigned(number_unsigned_t n) { SaxScalar v; v.kind = SaxScalar::Kind::Integer; v.integer = static_cast<int64_t>(n); return scalar(v); }
+    bool number_float(number_float_t n, const string_t&) { SaxScalar v; v.kind = SaxScalar::Kind::Float; v.number = n; return scalar(v); }
+    bool string(string_t& s) { SaxScalar v; v.kind = SaxScalar::Kind::String; v.text = &s; return scalar(v); }
+    bool binary(binary_t&) { SaxScalar v; return scalar(v); }
+
+    // --- Structure ---
+    bool key(string_t& k) {
+        if (depth_ == 1) {
+            data_pending_ = (k == "data");
+            section_ = (k == "links") ? Section::Links : (k == "meta") ? Section::Meta
+                     : (k == "deleted") ? Section::Deleted : Section::Other;
+        } else if (depth_ == 2 && section_ != Section::Other) {
+            key_.swap(k);
+        } else if (depth_ == record_depth_) {
+            key_.swap(k); // Reuse buffers instead of copying each key
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        ++depth_;
+        if (depth_ == 2 && data_pending_) {
+            // "data": { ... } -> a single record
+            data_pending_ = false;
+            found_data_ = true;
+            beginRecord();
+        } else if (array_depth_ > 0 && depth_ == array_depth_ + 1) {
+            beginRecord(); // One element of "data": [ ... ]
+        }
+        return true;
+    }
+
+    bool end_object() {
+        if (depth_ == record_depth_) record_depth_ = -1;
+        --depth_;
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        ++depth_;
+        if (depth_ == 2 && data_pending_) {
+            data_pending_ = false;
+            found_data_ = true;
+            data_was_array_ = true;
+            array_depth_ = depth_;
+        } else if (record_depth_ > 0 && depth_ == record_depth_ + 1) {
+            in_field_array_ = true; // e.g. "amenities": [ ... ]
+        }
+        return true;
+    }
+
+    bool end_array() {
+        if (depth_ == array_depth_) array_depth_ = -1;
+        if (in_field_array_ && depth_ == record_depth_ + 1) in_field_array_ = false;
+        --depth_;
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) {
+        error_ = "parse error at byte " + std::to_string(position) + ": " + e.what();
+        return false;
+    }
+
+private:
+    void beginRecord() {
+        records_.emplace_back();
+        record_depth_ = depth_;
+        key_.clear();
+    }
+
+    bool scalar(SaxScalar& value) {
+        if (depth_ == 1) {
+            if (data_pending_) { data_pending_ = false; found_data_ = true; } // "data": null/scalar
+            return true;
+        }
+        if (depth_ == 2 && section_ != Section::Other) {
+            if (section_ == Section::Deleted) {
+                if (sync_ && value.isNumber()) sync_->deleted.push_back(static_cast<int>(value.asInteger()));
+            } else {
+                if (page_) pageField(value);
+                if (sync_ && section_ == Section::Meta) syncField(value);
+            }
+            return true;
+        }
+        bool ok = true;
+        if (record_depth_ > 0 && depth_ == record_depth_) {
+            ok = assignField(records_.back(), key_, value, false);
+        } else if (in_field_array_ && depth_ == record_depth_ + 1) {
+            ok = assignField(records_.back(), key_, value, true);
+        }
+        if (!ok) error_ = "unexpected type for field '" + key_ + "'";
+        return ok;
+    }
+
+    void pageField(SaxScalar& value) {
+        if (section_ == Section::Links) {
+            if (key_ == "next") {
+                if (value.kind == SaxScalar::Kind::String) page_->next = std::move(*value.text);
+                else page_->next.clear(); // null on the last page
+            }
+            return;
+        }
+        if (!value.isNumber()) return;
+        int n = static_cast<int>(value.asInteger());
+        if (key_ == "current_page") page_->currentPage = n;
+        else if (key_ == "last_page") page_->lastPage = n;
+        else if (key_ == "per_page") page_->perPage = n;
+        else if (key_ == "total") page_->total = n;
+    }
+
+    void syncField(SaxScalar& value) {
+        if (key_ == "sync_cursor" && value.kind == SaxScalar::Kind::String) sync_->cursor = std::move(*value.text);
+        else if (key_ == "full_sync" && value.kind == SaxScalar::Kind::Boolean) sync_->full = value.boolean;
+    }
+
+    enum class Section { Other, Links, Meta, Deleted }; // Top-level member being read
+
+    std::vector<T>& records_;
+    PageInfo* page_;
+    SyncInfo* sync_;
+    Section section_ = Section::Other;
+    std::string key_;          // Current key inside the record (or links/meta) being read
+    std::string error_;
+    int depth_ = 0;            // Current object/array nesting
+    int array_depth_ = -1;     // Depth of the "data" array while inside it
+    int record_depth_ = -1;    // Depth of the record object being filled
+    bool in_field_array_ = false;
+    bool data_pending_ = false; // The next value belongs to top-level "data"
+    bool found_data_ = false;
+    bool data_was_array_ = false;
+};
+
+
+namespace detail_decode {
+
+template <typename T>
+bool decodeEnvelope(const std::string& body, std::vector<T>& out, std::string& error, bool expectArray,
+                    PageInfo* page = nullptr, SyncInfo* sync = nullptr) {
+    out.clear();
+    DataEnvelopeDecoder<T> decoder(out, page, sync);
+    if (!json::sax_parse(body, &decoder)) {
+        error = decoder.error().empty() ? "malformed JSON" : decoder.error();
+        out.clear();
+        return false;
+    }
+    if (!decoder.foundData() || decoder.dataWasArray() != expectArray || (!expectArray && out.size() != 1)) {
+        error = expectArray ? "expected 'data' array" : "expected 'data' object";
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace detail_decode
+
+// Decode {"data": [ ... ]} from `body` into `out`. Returns false and sets `error`
+// on malformed JSON, a missing "data" array or a field type mismatch.
+// Pass `page` to also collect Laravel pagination links/meta.
+template <typename T>
+bool decodeDataArray(const std::string& body, std::vector<T>& out, std::string& error, PageInfo* page = nullptr) {
+    return detail_decode::decodeEnvelope(body, out, error, true, page);
+}
+
+// Decode a delta-sync response {"data": [ ... ], "deleted": [ids], "meta": {...}}:
+// the changed records into `out`, the deleted ids and the cursor into `sync`.
+// Pass `page` too when the reply may be a plain paginated listing instead.
+template <typename T>
+bool decodeSyncArray(const std::string& body, std::vector<T>& out, std::string& error, SyncInfo& sync,
+                     PageInfo* page = nullptr) {
+    sync = SyncInfo();
+    return detail_decode::decodeEnvelope(body, out, error, true, page, &sync);
+}
+
+// Decode {"data": { ... }} from `body` into `out`
+template <typename T>
+bool decodeDataObject(const std::string& body, T& out, std::string& error) {
+    std::vector<T> records;
+    records.reserve(1);
+    if (!detail_decode::decodeEnvelope(body, records, error, false)) return false;
+    out = std::move(records.front());
+    return true;
+}
+
+#endif // JSON_STREAM_DECODER_H
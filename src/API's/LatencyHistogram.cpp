@@ -0,0 +1,67 @@
+// src/LatencyHistogram.cpp
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+int highestBit(uint64_t v) {
+    int bit = 0;
+    while (v >>= 1) ++bit;
+    return bit;
+}
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < static_cast<uint64_t>(kSubBuckets)) {
+        return static_cast<size_t>(micros); // Exact below 32us
+    }
+    int shift = highestBit(micros) - kSubBucketBits;     // >= 0
+    if (shift >= kMagnitudes - 1) return kBucketCount - 1; // Clamp absurdly long samples
+    // (micros >> shift) is in [32, 63]: the linear sub-bucket within this power of two
+    return static_cast<size_t>(shift) * kSubBuckets + static_cast<size_t>(micros >> shift);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    size_t magnitude = index / kSubBuckets;
+    uint64_t sub = index % kSubBuckets;
+    if (magnitude == 0) return sub;
+    int shift = static_cast<int>(magnitude) - 1;
+    uint64_t lower = (static_cast<uint64_t>(kSubBuckets) + sub) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    buckets_[bucketIndex(micros)]++;
+    count_++;
+    sum_ += micros;
+    min_ = std::min(min_, micros);
+    max_ = std::max(max_, micros);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketCount; ++i) buckets_[i] += other.buckets_[i];
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::reset() {
+    *this = LatencyHistogram{};
+}
+
+uint64_t LatencyHistogram::percentile(double pct) const {
+    if (count_ == 0) return 0;
+    pct = std::min(std::max(pct, 0.0), 100.0);
+    uint64_t rank = static_cast<uint64_t>(std::ceil(pct / 100.0 * static_cast<double>(count_)));
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max_);
+        }
+    }
+    return max_;
+}
@@ -0,0 +1,44 @@
+// src/LatencyHistogram.h
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// --- LatencyHistogram ---
+// Log-linear histogram of durations in microseconds (HdrHistogram-style):
+// each power of two is split into kSubBuckets linear buckets, so any recorded
+// value is reported within ~3% of its true value, from 1us to hours, in a
+// fixed 8 KB table. Not thread-safe: keep one per thread and merge() them.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits; // 32 per power of two
+    static constexpr int kMagnitudes = 32;                  // up to 2^36 us (~19 hours)
+    static constexpr size_t kBucketCount = static_cast<size_t>(kSubBuckets) * kMagnitudes;
+
+    void record(uint64_t micros);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+
+    // Value at the given percentile (0-100], e.g. 99.9 for p999
+    uint64_t percentile(double pct) const;
+
+private:
+    static size_t bucketIndex(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t index);
+
+    std::array<uint64_t, kBucketCount> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,321 @@
+// src/LoadBenchmark.cpp
+// hotel_bench: drives a configurable mix of ApiClient calls from N concurrent
+// clients and reports throughput plus p50/p95/p99/p999 latency per operation.
+//
+// Example (against the local mock server):
+//   hotel_bench --url=http://127.0.0.1:8080/api --clients=16 --duration=30
+//               --mix=60,25,10,5 --email=bench@example.com --password=secret
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ApiClient.h"
+#include "DataStructures.h"
+#include "LatencyHistogram.h"
+#include "Logger.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// --- Operations in the request mix ---
+enum Operation : size_t { GetRooms = 0, GetRoomById, GetBookings, CreateBooking, kOperationCount };
+
+const char* operationName(size_t op) {
+    switch (op) {
+        case GetRooms: return "GET /rooms";
+        case GetRoomById: return "GET /rooms/{id}";
+        case GetBookings: return "GET /bookings";
+        case CreateBooking: return "POST /bookings";
+        default: return "?";
+    }
+}
+
+bool requiresAuth(size_t op) {
+    return op == GetBookings || op == CreateBooking;
+}
+
+struct BenchConfig {
+    std::string baseUrl;
+    size_t clients = 4;
+    double durationSeconds = 10.0;
+    double warmupSeconds = 1.0;                      // Samples before this are not recorded
+    uint64_t requestsPerClient = 0;                  // If set, stop after this many instead of duration
+    std::array<unsigned, kOperationCount> weights{{60, 25, 10, 5}};
+    int roomIdMin = 1;
+    int roomIdMax = 20;
+    std::string email;
+    std::string password;
+    int cacheTtlSeconds = 0;                         // 0: every read revalidates with the server
+    size_t connectionsPerClient = 1;
+    int attempts = 3;                                // Per GET, including the first (RetryPolicy)
+    bool hedge = false;                              // Hedged getRoomById (HedgePolicy)
+    TransportOptions transport;                      // HTTP version and compression
+    bool verbose = false;                            // Keep the client's own request logging
+};
+
+struct ClientStats {
+    std::array<LatencyHistogram, kOperationCount> latency;
+    std::array<uint64_t, kOperationCount> errors{};
+    ConnectionStats connections;
+    RetryStats retries;
+    bool authenticated = false;
+};
+
+void printUsage() {
+    std::cout << "Usage: hotel_bench [options]\n"
+              << "  --url=URL             API base URL (default: $API_BASE_URL or http://127.0.0.1:8000/api)\n"
+              << "  --clients=N           Concurrent clients, each with its own ApiClient (default 4)\n"
+              << "  --duration=SECONDS    Measured run time (default 10)\n"
+              << "  --warmup=SECONDS      Unrecorded warm-up before measuring (default 1)\n"
+              << "  --requests=N          Stop each client after N requests instead of --duration\n"
+              << "  --mix=R,I,B,C         Weights for getRooms,getRoomById,getBookings,createBooking (default 60,25,10,5)\n"
+              << "  --room-ids=MIN-MAX    Room ids used by getRoomById/createBooking (default 1-20)\n"
+              << "  --email=E --password=P  Credentials for the authenticated operations\n"
+              << "  --cache-ttl=SECONDS   Room cache TTL inside each client (default 0)\n"
+              << "  --connections=N       Pooled connections per client (default 1)\n"
+              << "  --attempts=N          Attempts per GET on transient failures, 1 = no retries (default 3)\n"
+              << "  --hedge               Hedge getRoomById after the route's p95 latency\n"
+              << "  --http1               HTTP/1.1 only (default: HTTP/2 where TLS negotiates it)\n"
+              << "  --h2c                 HTTP/2 without negotiation, for plain-http servers that speak it\n"
+              << "  --no-compression      Don't send Accept-Encoding\n"
+              << "  --verbose             Keep the client's per-request logging\n";
+}
+
+bool parseArgs(int argc, char** argv, BenchConfig& config) {
+    const char* envUrl = std::getenv("API_BASE_URL");
+    config.baseUrl = envUrl ? envUrl : "http://127.0.0.1:8000/api";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        size_t eq = arg.find('=');
+        if (eq != std::string::npos) {
+            value = arg.substr(eq + 1);
+            arg = arg.substr(0, eq);
+        }
+        try {
+            if (arg == "--help" || arg == "-h") { printUsage(); return false; }
+            else if (arg == "--url") config.baseUrl = value;
+            else if (arg == "--clients") config.clients = std::max(1, std::stoi(value));
+            else if (arg == "--duration") config.durationSeconds = std::stod(value);
+            else if (arg == "--warmup") config.warmupSeconds = std::stod(value);
+            else if (arg == "--requests") config.requestsPerClient = std::stoull(value);
+            else if (arg == "--email") config.email = value;
+            else if (arg == "--password") config.password = value;
+            else if (arg == "--cache-ttl") config.cacheTtlSeconds = std::stoi(value);
+            else if (arg == "--connections") config.connectionsPerClient = std::max(1, std::stoi(value));
+            else if (arg == "--attempts") config.attempts = std::max(1, std::stoi(value));
+            else if (arg == "--hedge") config.hedge = true;
+            else if (arg == "--http1") config.transport.httpVersion = TransportOptions::HttpVersion::Http1;
+            else if (arg == "--h2c") config.transport.httpVersion = TransportOptions::HttpVersion::Http2PriorKnowledge;
+            else if (arg == "--no-compression") config.transport.compression = false;
+            else if (arg == "--verbose") config.verbose = true;
+            else if (arg == "--room-ids") {
+                size_t dash = value.find('-');
+                config.roomIdMin = std::stoi(value.substr(0, dash));
+                config.roomIdMax = dash == std::string::npos ? config.roomIdMin : std::stoi(value.substr(dash + 1));
+                if (config.roomIdMax < config.roomIdMin) std::swap(config.roomIdMin, config.roomIdMax);
+            } else if (arg == "--mix") {
+                std::stringstream parts(value);
+                std::string part;
+                for (size_t op = 0; op < kOperationCount; ++op) {
+                    config.weights[op] = std::getline(parts, part, ',') ? static_cast<unsigned>(std::stoul(part)) : 0;
+                }
+            } else {
+                std::cerr << "[Bench Error] Unknown option: " << arg << std::endl;
+                printUsage();
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "[Bench Error] Invalid value for " << arg << ": '" << value << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+BookingData randomBooking(std::mt19937_64& rng, const BenchConfig& config) {
+    std::uniform_int_distribution<int> room(config.roomIdMin, config.roomIdMax);
+    std::uniform_int_distribution<int> month(1, 12);
+    std::uniform_int_distribution<int> day(1, 20);
+    std::uniform_int_distribution<int> nights(1, 7);
+    std::uniform_int_distribution<int> guests(1, 3);
+
+    Date checkIn = Date::fromCivil(2027, month(rng), day(rng));
+
+    BookingData booking;
+    booking.room_id = room(rng);
+    booking.check_in = checkIn;
+    booking.check_out = checkIn + nights(rng);
+    booking.guests = guests(rng);
+    booking.package = "Silver";
+    booking.housekeeping = false;
+    booking.housekeeping_time = TimeOfDay();
+    booking.parking = false;
+    return booking;
+}
+
+// One simulated terminal: logs in, waits for the start signal, then loops over the mix
+void runClient(const BenchConfig& config, size_t index, ClientStats& stats,
+               std::atomic<size_t>& ready, const std::atomic<bool>& go,
+               const Clock::time_point& recordFrom, const Clock::time_point& deadline) {
+    ApiClient client(config.baseUrl, config.connectionsPerClient);
+    client.setRoomCacheTtl(std::chrono::seconds(config.cacheTtlSeconds));
+    RetryPolicy retry;
+    retry.maxAttempts = config.attempts;
+    client.setRetryPolicy(retry);
+    HedgePolicy hedge;
+    hedge.enabled = config.hedge;
+    client.setHedgePolicy(hedge);
+    client.setTransportOptions(config.transport);
+    if (!config.email.empty()) {
+        stats.authenticated = client.login(config.email, config.password).has_value();
+    }
+
+    std::array<unsigned, kOperationCount> weights = config.weights;
+    if (!stats.authenticated) {
+        for (size_t op = 0; op < kOperationCount; ++op) {
+            if (requiresAuth(op)) weights[op] = 0;
+        }
+    }
+    std::mt19937_64 rng(0x5eed0000ULL + index);
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+    std::uniform_int_distribution<int> roomId(config.roomIdMin, config.roomIdMax);
+
+    ready.fetch_add(1);
+    while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+    for (uint64_t sent = 0; config.requestsPerClient == 0 || sent < config.requestsPerClient; ++sent) {
+        auto started = Clock::now();
+        if (config.requestsPerClient == 0 && started >= deadline) break;
+
+        size_t op = pick(rng);
+        bool ok = false;
+        switch (op) {
+            case GetRooms: ok = !client.getRooms().empty(); break; // An empty catalog counts as an error
+            case GetRoomById: ok = client.getRoomById(roomId(rng)).has_value(); break;
+            case GetBookings: ok = !client.getBookings().empty(); break;
+            case CreateBooking: ok = client.createBooking(randomBooking(rng, config)).has_value(); break;
+        }
+        auto finished = Clock::now();
+
+        if (started >= recordFrom) {
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(finished - started).count();
+            stats.latency[op].record(static_cast<uint64_t>(micros));
+            if (!ok) stats.errors[op]++;
+        }
+    }
+    stats.connections = client.connectionStats();
+    stats.retries = client.retryStats();
+}
+
+void printRow(const std::string& name, const LatencyHistogram& h, uint64_t errors, double seconds) {
+    auto ms = [](uint64_t micros) { return static_cast<double>(micros) / 1000.0; };
+    std::cout << std::left << std::setw(18) << name << std::right
+              << std::setw(10) << h.count()
+              << std::setw(8) << errors
+              << std::setw(11) << std::fixed << std::setprecision(1) << (seconds > 0 ? h.count() / seconds : 0.0)
+              << std::setprecision(2)
+              << std::setw(10) << ms(h.percentile(50))
+              << std::setw(10) << ms(h.percentile(95))
+              << std::setw(10) << ms(h.percentile(99))
+              << std::setw(10) << ms(h.percentile(99.9))
+              << std::setw(10) << ms(h.max()) << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) return 1;
+
+    std::cout << "hotel_bench: " << config.clients << " clients against " << config.baseUrl << std::endl;
+    if (config.email.empty()) {
+        std::cout << "[Bench Info] No --email given; getBookings/createBooking are left out of the mix." << std::endl;
+    }
+
+    // Silence the client's logging unless asked for it; verbose runs keep
+    // HOTEL_LOG_LEVEL and go through the asynchronous writer
+    if (!config.verbose) Logger::instance().setLevel(LogLevel::Off);
+
+    std::vector<ClientStats> stats(config.clients);
+    std::vector<std::thread> threads;
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    Clock::time_point recordFrom = Clock::time_point::max();
+    Clock::time_point deadline = Clock::time_point::max();
+
+    for (size_t i = 0; i < config.clients; ++i) {
+        threads.emplace_back(runClient, std::cref(config), i, std::ref(stats[i]), std::ref(ready),
+                             std::cref(go), std::cref(recordFrom), std::cref(deadline));
+    }
+    while (ready.load() < config.clients) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    // Everyone is logged in: start the clock
+    auto start = Clock::now();
+    recordFrom = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.warmupSeconds));
+    deadline = recordFrom + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.durationSeconds));
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    auto end = Clock::now();
+
+    Logger::instance().flush();
+
+    // --- Report ---
+    double measured = std::chrono::duration<double>(end - std::min(recordFrom, end)).count();
+    LatencyHistogram total;
+    std::array<LatencyHistogram, kOperationCount> perOperation;
+    std::array<uint64_t, kOperationCount> errors{};
+    uint64_t totalErrors = 0;
+    ConnectionStats connections;
+    RetryStats retries;
+    size_t authenticated = 0;
+    for (const auto& s : stats) {
+        for (size_t op = 0; op < kOperationCount; ++op) {
+            perOperation[op].merge(s.latency[op]);
+            total.merge(s.latency[op]);
+            errors[op] += s.errors[op];
+            totalErrors += s.errors[op];
+        }
+        connections.sessionsCreated += s.connections.sessionsCreated;
+        connections.connectionsOpened += s.connections.connectionsOpened;
+        connections.connectionsReused += s.connections.connectionsReused;
+        connections.http2Transfers += s.connections.http2Transfers;
+        connections.compressedTransfers += s.connections.compressedTransfers;
+        retries.retries += s.retries.retries;
+        retries.hedgesSent += s.retries.hedgesSent;
+        retries.hedgesWon += s.retries.hedgesWon;
+        if (s.authenticated) ++authenticated;
+    }
+
+    std::cout << "\n--- Results (" << std::fixed << std::setprecision(1) << measured << "s measured, "
+              << authenticated << "/" << config.clients << " clients authenticated) ---" << std::endl;
+    std::cout << std::left << std::setw(18) << "Operation" << std::right
+              << std::setw(10) << "Count" << std::setw(8) << "Errors" << std::setw(11) << "Req/s"
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms" << std::setw(10) << "p99 ms"
+              << std::setw(10) << "p999 ms" << std::setw(10) << "max ms" << std::endl;
+    for (size_t op = 0; op < kOperationCount; ++op) {
+        if (perOperation[op].count() > 0) printRow(operationName(op), perOperation[op], errors[op], measured);
+    }
+    printRow("TOTAL", total, totalErrors, measured);
+
+    uint64_t transfers = connections.connectionsOpened + connections.connectionsReused;
+    std::cout << "Connections: " << connections.connectionsOpened << " opened, " << connections.connectionsReused
+              << " reused (" << std::setprecision(1)
+              << (transfers ? 100.0 * static_cast<double>(connections.connectionsReused) / static_cast<double>(transfers) : 0.0)
+              << "% reuse)" << std::endl;
+    std::cout << "Transfers: " << connections.http2Transfers << " of " << transfers << " over HTTP/2, "
+              << connections.compressedTransfers << " compressed" << std::endl;
+    std::cout << "Retries: " << retries.retries << " | Hedges: " << retries.hedgesSent << " sent, "
+              << retries.hedgesWon << " won" << std::endl;
+    return totalErrors == 0 ? 0 : 2;
+}
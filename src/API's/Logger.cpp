@@ -0,0 +1,242 @@
+// src/Logger.cpp
+#include "Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+std::atomic<int> Logger::level_{Logger::kUnconfigured};
+std::atomic<bool> Logger::body_dumps_{true};
+
+namespace {
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO";
+        case LogLevel::Warn:  return "WARN";
+        case LogLevel::Error: return "ERROR";
+        case LogLevel::Off:   break;
+    }
+    return "OFF";
+}
+
+std::string lowerEnv(const char* name) {
+    const char* value = std::getenv(name);
+    std::string text = value ? value : "";
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+} // namespace
+
+// Owns the calling thread's ring; when the thread exits the ring is handed to
+// the writer, which drains it and then drops it
+struct RingHandle {
+    std::shared_ptr<Logger::Ring> ring;
+    ~RingHandle() {
+        if (ring) ring->orphaned.store(true, std::memory_order_release);
+    }
+};
+
+// --- Ring ---
+
+Logger::Ring::Ring(size_t capacity, uint32_t threadIndex)
+    : slots_(capacity), mask_(capacity - 1), thread_index_(threadIndex) {}
+
+bool Logger::Ring::push(Record&& record) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == slots_.size()) return false;
+    slots_[tail & mask_] = std::move(record);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool Logger::Ring::pop(Record& record) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) return false;
+    record = std::move(slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool Logger::Ring::empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+}
+
+// --- Logger ---
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() {
+    configureFromEnvironment();
+    writer_ = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    wake_.notify_one();
+    if (writer_.joinable()) writer_.join();
+    drain(); // Anything logged while the writer was stopping
+}
+
+void Logger::setLevel(LogLevel level) {
+    level_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void Logger::setBodyDumps(bool enabled) {
+    body_dumps_.store(enabled, std::memory_order_relaxed);
+}
+
+void Logger::configureFromEnvironment() {
+    std::string level = lowerEnv("HOTEL_LOG_LEVEL");
+    LogLevel parsed = LogLevel::Info;
+    if (level == "trace") parsed = LogLevel::Trace;
+    else if (level == "debug") parsed = LogLevel::Debug;
+    else if (level == "warn" || level == "warning") parsed = LogLevel::Warn;
+    else if (level == "error") parsed = LogLevel::Error;
+    else if (level == "off" || level == "none") parsed = LogLevel::Off;
+    setLevel(parsed);
+
+    std::string bodies = lowerEnv("HOTEL_LOG_BODIES");
+    setBodyDumps(!(bodies == "0" || bodies == "false" || bodies == "off"));
+    std::string async = lowerEnv("HOTEL_LOG_ASYNC");
+    setAsync(!(async == "0" || async == "false" || async == "off"));
+
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    full_format_ = lowerEnv("HOTEL_LOG_FORMAT") == "full";
+    const char* path = std::getenv("HOTEL_LOG_FILE");
+    if (file_.is_open()) file_.close();
+    if (path && *path) {
+        file_.open(path, std::ios::app);
+        if (!file_) std::cerr << "[Log] Could not open " << path << ", logging to the console" << std::endl;
+    }
+}
+
+Logger::Ring& Logger::threadRing() {
+    thread_local RingHandle handle;
+    if (!handle.ring) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handle.ring = std::make_shared<Ring>(kRingCapacity, next_thread_index_++);
+        rings_.push_back(handle.ring);
+    }
+    return *handle.ring;
+}
+
+void Logger::write(LogLevel level, std::string message) {
+    Record record;
+    record.level = level;
+    record.time = std::chrono::system_clock::now();
+    record.message = std::move(message);
+    if (!async_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> sink(sink_mutex_);
+        emit(record, threadRing().threadIndex());
+        if (file_.is_open()) file_.flush();
+        else (record.level >= LogLevel::Warn ? std::cerr : std::cout).flush();
+        return;
+    }
+    Ring& ring = threadRing();
+    if (!ring.push(std::move(record))) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // Problems should show up promptly, and a burst shouldn't wait for the
+    // next tick to start draining; everything else is picked up on the tick
+    if (level >= LogLevel::Warn || ring.size() == kRingCapacity / 2) wake_.notify_one();
+}
+
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_) return;
+    uint64_t ticket = ++flush_requests_;
+    wake_.notify_one();
+    flushed_cv_.wait(lock, [&] { return flushes_done_ >= ticket || !running_; });
+}
+
+void Logger::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        wake_.wait_for(lock, std::chrono::milliseconds(20));
+        uint64_t requested = flush_requests_;
+        lock.unlock();
+        drain();
+        lock.lock();
+        flushes_done_ = requested;
+        flushed_cv_.notify_all();
+    }
+    flushed_cv_.notify_all();
+}
+
+bool Logger::drain() {
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings = rings_;
+    }
+
+    std::lock_guard<std::mutex> sink(sink_mutex_);
+    bool wrote = false;
+    Record record;
+    for (const auto& ring : rings) {
+        // Read orphaned first: once it is set, nothing more can be pushed
+        bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+        while (ring->pop(record)) {
+            emit(record, ring->threadIndex());
+            wrote = true;
+        }
+        if (orphaned) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            rings_.erase(std::remove(rings_.begin(), rings_.end(), ring), rings_.end());
+        }
+    }
+
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != dropped_reported_) {
+        Record note;
+        note.level = LogLevel::Warn;
+        note.time = std::chrono::system_clock::now();
+        note.message = "[Log] Dropped " + std::to_string(dropped - dropped_reported_) + " records (buffer full)";
+        dropped_reported_ = dropped;
+        emit(note, 0);
+        wrote = true;
+    }
+
+    if (wrote) {
+        if (file_.is_open()) file_.flush();
+        else {
+            std::cout.flush();
+            std::cerr.flush();
+        }
+    }
+    return wrote;
+}
+
+void Logger::emit(const Record& record, uint32_t threadIndex) {
+    std::ostream& out = file_.is_open() ? static_cast<std::ostream&>(file_)
+                      : record.level >= LogLevel::Warn ? std::cerr : std::cout;
+    if (full_format_) {
+        auto since = record.time.time_since_epoch();
+        std::time_t seconds = std::chrono::system_clock::to_time_t(record.time);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(since).count() % 1000;
+        std::tm utc{};
+#ifdef _WIN32
+        gmtime_s(&utc, &seconds);
+#else
+        gmtime_r(&seconds, &utc);
+#endif
+        out << std::put_time(&utc, "%Y-%m-%dT%H:%M:%S") << '.' << std::setw(3) << std::setfill('0') << millis
+            << std::setfill(' ') << "Z " << std::left << std::setw(5) << levelName(record.level) << std::right
+            << " t" << threadIndex << ' ';
+    }
+    out << record.message << '\n';
+}
@@ -0,0 +1,137 @@
+// src/Logger.h
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class LogLevel : int { Trace = 0, Debug, Info, Warn, Error, Off };
+
+// --- Logger ---
+// Level-gated asynchronous logging. A call site whose level is disabled costs
+// one relaxed atomic load. Enabled records are formatted on the calling thread,
+// pushed into that thread's own lock-free ring buffer and written out by a
+// background thread, so request threads never block on console or file I/O.
+// If a ring is full the record is dropped and counted rather than waiting.
+//
+// Configured from the environment (re-read by configureFromEnvironment()):
+//   HOTEL_LOG_LEVEL   trace|debug|info|warn|error|off   (default info)
+//   HOTEL_LOG_BODIES  0|1  include response bodies in debug output (default 1)
+//   HOTEL_LOG_FORMAT  plain|full  full adds time, level and thread (default plain)
+//   HOTEL_LOG_FILE    path  write everything there instead of stdout/stderr
+//   HOTEL_LOG_ASYNC   0|1  0 writes on the calling thread, keeping log lines in
+//                          order with other console output (default 1)
+class Logger {
+public:
+    static Logger& instance();
+
+    static bool enabled(LogLevel level) {
+        int current = level_.load(std::memory_order_relaxed);
+        if (current == kUnconfigured) current = static_cast<int>(instance().configuredLevel());
+        return static_cast<int>(level) >= current;
+    }
+    static bool bodyDumps() { return body_dumps_.load(std::memory_order_relaxed); }
+
+    void setLevel(LogLevel level);
+    void setBodyDumps(bool enabled);
+    void setAsync(bool async) { async_.store(async, std::memory_order_relaxed); }
+    void configureFromEnvironment();
+
+    // Queue one formatted record (normally called through the LOG_* macros)
+    void write(LogLevel level, std::string message);
+
+    // Block until everything logged before this call has been written
+    void flush();
+
+    uint64_t droppedRecords() const { return dropped_.load(std::memory_order_relaxed); }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    struct Record {
+        LogLevel level = LogLevel::Info;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+
+    // Single-producer (the owning thread) / single-consumer (the writer) ring
+    class Ring {
+    public:
+        Ring(size_t capacity, uint32_t threadIndex);
+        bool push(Record&& record);
+        bool pop(Record& record);
+        bool empty() const;
+        size_t size() const { return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed); }
+        uint32_t threadIndex() const { return thread_index_; }
+        std::atomic<bool> orphaned{false}; // Owning thread has exited
+
+    private:
+        std::vector<Record> slots_;
+        size_t mask_;
+        uint32_t thread_index_;
+        alignas(64) std::atomic<size_t> head_{0}; // Next slot to read (writer thread)
+        alignas(64) std::atomic<size_t> tail_{0}; // Next slot to fill (owning thread)
+    };
+    friend struct RingHandle;
+
+    static constexpr int kUnconfigured = -1;
+    static constexpr size_t kRingCapacity = 1024; // Records per thread
+
+    Logger();
+    ~Logger();
+
+    LogLevel configuredLevel() const { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+    Ring& threadRing();
+    void run();
+    bool drain();
+    void emit(const Record& record, uint32_t threadIndex);
+
+    static std::atomic<int> level_;
+    static std::atomic<bool> body_dumps_;
+
+    std::mutex mutex_;                   // Ring registration and the flush handshake
+    std::mutex sink_mutex_;              // Output file and format
+    std::condition_variable wake_;
+    std::condition_variable flushed_cv_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+    uint32_t next_thread_index_ = 0;
+    uint64_t flush_requests_ = 0;
+    uint64_t flushes_done_ = 0;
+    bool running_ = true;
+    bool full_format_ = false;
+    std::ofstream file_;
+    std::atomic<bool> async_{true};
+    std::atomic<uint64_t> dropped_{0};
+    uint64_t dropped_reported_ = 0;
+    std::thread writer_;
+};
+
+// --- Macros ---
+// The stream expression is only evaluated when the level is enabled:
+//   LOG_INFO("[Auth] Login successful for " << email);
+#define HOTEL_LOG(level, expr)                                       \
+    do {                                                             \
+        if (Logger::enabled(level)) {                                \
+            std::ostringstream hotel_log_stream_;                    \
+            hotel_log_stream_ << expr;                               \
+            Logger::instance().write(level, hotel_log_stream_.str()); \
+        }                                                            \
+    } while (0)
+
+#define LOG_TRACE(expr) HOTEL_LOG(LogLevel::Trace, expr)
+#define LOG_DEBUG(expr) HOTEL_LOG(LogLevel::Debug, expr)
+#define LOG_INFO(expr) HOTEL_LOG(LogLevel::Info, expr)
+#define LOG_WARN(expr) HOTEL_LOG(LogLevel::Warn, expr)
+#define LOG_ERROR(expr) HOTEL_LOG(LogLevel::Error, expr)
+
+#endif // LOGGER_H
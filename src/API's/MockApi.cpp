@@ -0,0 +1,687 @@
+// src/MockApi.cpp
+#include "MockApi.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// --- Helpers ---
+
+namespace {
+
+MockResponse jsonResponse(int status, const json& body) {
+    MockResponse response;
+    response.status = status;
+    response.body = body.dump();
+    response.headers.emplace_back("Content-Type", "application/json");
+    return response;
+}
+
+MockResponse message(int status, const std::string& text) {
+    return jsonResponse(status, json{{"message", text}});
+}
+
+MockResponse validationError(const std::string& field, const std::string& text) {
+    return jsonResponse(422, json{{"message", text}, {"errors", {{field, {text}}}}});
+}
+
+MockResponse noContent() {
+    MockResponse response;
+    response.status = 204;
+    return response;
+}
+
+MockResponse notModified(const std::string& etag) {
+    MockResponse response;
+    response.status = 304;
+    response.headers.emplace_back("ETag", etag);
+    return response;
+}
+
+bool parseInt(const std::string& text, int& value) {
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(text.data(), end, value);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+// If-None-Match may carry several tags or "*"
+bool etagMatches(const std::string& ifNoneMatch, const std::string& etag) {
+    return !ifNoneMatch.empty() && (ifNoneMatch == "*" || ifNoneMatch.find(etag) != std::string::npos);
+}
+
+std::string bearerToken(const std::string& authorization) {
+    const std::string prefix = "Bearer ";
+    return authorization.compare(0, prefix.size(), prefix) == 0 ? authorization.substr(prefix.size()) : "";
+}
+
+// %XX escapes and '+' as space, as PHP decodes query strings
+std::string percentDecode(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '+') {
+            out.push_back(' ');
+        } else if (text[i] == '%' && i + 2 < text.size()) {
+            unsigned value = 0;
+            auto result = std::from_chars(text.data() + i + 1, text.data() + i + 3, value, 16);
+            if (result.ec != std::errc() || result.ptr != text.data() + i + 3) {
+                out.push_back(text[i]);
+                continue;
+            }
+            out.push_back(static_cast<char>(value));
+            i += 2;
+        } else {
+            out.push_back(text[i]);
+        }
+    }
+    return out;
+}
+
+std::map<std::string, std::string> parseQuery(const std::string& query) {
+    std::map<std::string, std::string> params;
+    size_t start = 0;
+    while (start < query.size()) {
+        size_t end = query.find('&', start);
+        if (end == std::string::npos) end = query.size();
+        std::string pair = query.substr(start, end - start);
+        size_t eq = pair.find('=');
+        params[pair.substr(0, eq)] = eq == std::string::npos ? "" : percentDecode(pair.substr(eq + 1));
+        start = end + 1;
+    }
+    return params;
+}
+
+// Sync cursors are change stamps written as UTC timestamps with microseconds,
+// like Laravel's updated_at: "2026-10-17T09:30:00.000123Z"
+constexpr uint64_t kMicrosPerDay = 86400ULL * 1000000ULL;
+
+std::string formatStamp(uint64_t micros) {
+    char date[10];
+    Date::fromDays(static_cast<int32_t>(micros / kMicrosPerDay)).format(date);
+    uint64_t inDay = micros % kMicrosPerDay;
+    char buffer[40];
+    std::snprintf(buffer, sizeof(buffer), "%.10sT%02u:%02u:%02u.%06uZ", date,
+                  static_cast<unsigned>(inDay / 3600000000ULL), static_cast<unsigned>(inDay / 60000000ULL % 60),
+                  static_cast<unsigned>(inDay / 1000000ULL % 60), static_cast<unsigned>(inDay % 1000000ULL));
+    return buffer;
+}
+
+bool parseStamp(const std::string& text, uint64_t& micros) {
+    Date date;
+    if (text.size() != 27 || text[10] != 'T' || text[13] != ':' || text[16] != ':' || text[19] != '.' ||
+        text[26] != 'Z' || !Date::parse(std::string_view(text).substr(0, 10), date) || date.days() < 0) {
+        return false;
+    }
+    auto field = [&text](size_t at, size_t length, unsigned& value) {
+        const char* end = text.data() + at + length;
+        auto result = std::from_chars(text.data() + at, end, value);
+        return result.ec == std::errc() && result.ptr == end;
+    };
+    unsigned hours, minutes, seconds, fraction;
+    if (!field(11, 2, hours) || !field(14, 2, minutes) || !field(17, 2, seconds) || !field(20, 6, fraction) ||
+        hours > 23 || minutes > 59 || seconds > 59) {
+        return false;
+    }
+    micros = static_cast<uint64_t>(date.days()) * kMicrosPerDay +
+             ((hours * 60ULL + minutes) * 60ULL + seconds) * 1000000ULL + fraction;
+    return true;
+}
+
+std::vector<std::string> splitPath(const std::string& path) {
+    std::vector<std::string> segments;
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos) end = path.size();
+        if (end > start) segments.push_back(path.substr(start, end - start));
+        start = end + 1;
+    }
+    return segments;
+}
+
+} // namespace
+
+// --- Construction & seeding ---
+
+MockApi::MockApi(const MockOptions& options) : options_(options), rng_(std::random_device{}()) {
+    static const char* kTypes[] = {"Standard", "Deluxe", "Suite"};
+    static const char* kViews[] = {"City", "Garden", "Sea"};
+    static const char* kBeds[] = {"Queen", "King", "Twin"};
+
+    for (int i = 0; i < options_.roomCount; ++i) {
+        RoomData data;
+        data.name = "Room " + std::to_string(100 + i);
+        data.type = kTypes[i % 3];
+        data.price = 80.0 + 25.0 * (i % 7);
+        data.bed_size = kBeds[i % 3];
+        data.view = kViews[(i / 3) % 3];
+        data.capacity = 1 + i % 4;
+        data.description = "A " + data.type + " room with a " + data.view + " view.";
+        data.amenities = {"WiFi", "TV"};
+        if (i % 2 == 0) data.amenities.push_back("Minibar");
+        if (i % 5 == 0) data.amenities.push_back("Balcony");
+        data.available = true;
+        int id = next_room_id_++;
+        rooms_[id] = RoomEntry{makeRoom(id, data), 1, nextStamp()};
+    }
+
+    // Fixed accounts; any other email is registered on first login
+    for (const auto& seed : {std::make_pair("admin@hotel.local", "admin"), std::make_pair("guest@hotel.local", "user")}) {
+        Account account;
+        account.user.id = next_user_id_++;
+        account.user.username = std::string(seed.first).substr(0, std::string(seed.first).find('@'));
+        account.user.email = seed.first;
+        account.user.role = seed.second;
+        account.password = "password";
+        emails_[account.user.email] = account.user.id;
+        accounts_[account.user.id] = account;
+    }
+}
+
+Room MockApi::makeRoom(int id, const RoomData& data) const {
+    Room room;
+    room.id = id;
+    room.name = data.name;
+    room.type = Symbol(data.type);
+    room.price = data.price;
+    room.bedSize = Symbol(data.bed_size);
+    room.view = Symbol(data.view);
+    room.capacity = data.capacity;
+    room.description = data.description;
+    if (room.description.size() < options_.payloadBytes) {
+        room.description.append(options_.payloadBytes - room.description.size(), '.');
+    }
+    for (const auto& amenity : data.amenities) room.amenities.insert(std::string_view(amenity));
+    room.image = data.image.empty() ? "/images/rooms/" + std::to_string(id) + ".jpg" : data.image;
+    room.available = data.available;
+    return room;
+}
+
+// --- Dispatch ---
+
+MockResponse MockApi::handle(const MockRequest& request) {
+    size_t queryStart = request.target.find('?');
+    std::string path = request.target.substr(0, queryStart);
+    std::map<std::string, std::string> query;
+    if (queryStart != std::string::npos) query = parseQuery(request.target.substr(queryStart + 1));
+
+    MockResponse response;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Writes carrying an Idempotency-Key run once; repeats get the first response back
+        std::string scope = idempotencyScope(request);
+        std::string fingerprint = scope.empty() ? "" : request.method + " " + request.target + "\n" + request.body;
+        auto seen = scope.empty() ? idempotent_.end() : idempotent_.find(scope);
+        if (seen != idempotent_.end()) {
+            if (seen->second.request != fingerprint) {
+                response = message(422, "The idempotency key was already used for a different request.");
+            } else {
+                response = seen->second.response;
+                response.headers.emplace_back("Idempotent-Replayed", "true");
+            }
+        } else {
+            response = route(request, path, query);
+            if (!scope.empty() && response.status < 500) { // Server errors may be retried for real
+                idempotent_.emplace(scope, IdempotentResult{fingerprint, response});
+                idempotent_order_.push_back(scope);
+                if (idempotent_order_.size() > kMaxIdempotencyKeys) {
+                    idempotent_.erase(idempotent_order_.front());
+                    idempotent_order_.pop_front();
+                }
+            }
+        }
+    }
+    injectLatency(); // Outside the lock so slow responses still overlap
+    return response;
+}
+
+MockResponse MockApi::route(const MockRequest& request, const std::string& path,
+                            const std::map<std::string, std::string>& query) {
+    std::vector<std::string> segments = splitPath(path);
+    const std::string& method = request.method;
+    if (segments.empty()) return message(404, "Not Found");
+
+    json body;
+    if (method == "POST" || method == "PUT") {
+        body = json::parse(request.body, nullptr, false);
+        if (body.is_discarded() || !body.is_object()) return message(400, "Malformed JSON body.");
+    }
+
+    int id = 0;
+    bool hasId = segments.size() == 2 && parseInt(segments[1], id);
+    const std::string& resource = segments[0];
+
+    // --- Public routes ---
+    if (segments.size() == 1 && method == "POST") {
+        if (resource == "login") return login(body);
+        if (resource == "signup") return signup(body);
+    }
+    if (resource == "rooms" && method == "GET") {
+        if (segments.size() == 1) {
+            auto since = query.find("updated_since");
+            if (since != query.end()) return syncRooms(since->second);
+            return listRooms(request.ifNoneMatch);
+        }
+        if (hasId) return getRoom(id, request.ifNoneMatch);
+    }
+
+    // --- Authenticated routes ---
+    const User* user = authenticate(request.authorization);
+    if (!user) return message(401, "Unauthenticated.");
+    bool admin = user->role == "admin";
+
+    if (resource == "logout" && segments.size() == 1 && method == "POST") {
+        return logout(bearerToken(request.authorization));
+    }
+    if (resource == "rooms") {
+        if (!admin) return message(403, "This action is unauthorized.");
+        if (segments.size() == 1 && method == "POST") return createRoom(body);
+        if (hasId && method == "PUT") return updateRoom(id, body);
+        if (hasId && method == "DELETE") return deleteRoom(id);
+    }
+    if (resource == "bookings") {
+        if (segments.size() == 1 && method == "GET") {
+            auto since = query.find("updated_since");
+            if (since != query.end()) return syncBookings(*user, since->second);
+            std::vector<Booking> mine;
+            for (const auto& entry : bookings_) {
+                if (entry.second.booking.userId == user->id) mine.push_back(entry.second.booking);
+            }
+            return paginate(mine, path, query, request.baseUrl);
+        }
+        if (segments.size() == 1 && method == "POST") return createBooking(*user, body);
+        if (hasId && method == "GET") return getBooking(*user, id);
+        if (hasId && method == "DELETE") return deleteBooking(*user, id);
+    }
+    if (resource == "user" && hasId) {
+        if (method == "GET") return getUser(*user, id);
+        if (method == "PUT") return updateUser(*user, id, body);
+    }
+    if (resource == "admin" && segments.size() == 2 && method == "GET") {
+        if (!admin) return message(403, "This action is unauthorized.");
+        if (segments[1] == "bookings") {
+            std::vector<Booking> all;
+            for (const auto& entry : bookings_) all.push_back(entry.second.booking);
+            return paginate(all, path, query, request.baseUrl);
+        }
+        if (segments[1] == "rooms") {
+            std::vector<Room> all;
+            for (const auto& entry : rooms_) all.push_back(entry.second.room);
+            return paginate(all, path, query, request.baseUrl);
+        }
+    }
+    return message(404, "The route " + path + " could not be found.");
+}
+
+// --- Idempotency ---
+
+// Keys are per user, so two clients can't collide; empty when the request isn't a keyed write
+std::string MockApi::idempotencyScope(const MockRequest& request) const {
+    if (request.idempotencyKey.empty() || (request.method != "POST" && request.method != "PUT")) return "";
+    const User* user = authenticate(request.authorization);
+    return user ? std::to_string(user->id) + ":" + request.idempotencyKey : "";
+}
+
+// --- Auth ---
+
+const User* MockApi::authenticate(const std::string& authorization) const {
+    auto token = tokens_.find(bearerToken(authorization));
+    if (token == tokens_.end()) return nullptr;
+    auto account = accounts_.find(token->second);
+    return account == accounts_.end() ? nullptr : &account->second.user;
+}
+
+std::string MockApi::issueToken(int userId) {
+    std::uniform_int_distribution<uint64_t> dist;
+    uint64_t salt;
+    {
+        std::lock_guard<std::mutex> lock(rng_mutex_);
+        salt = dist(rng_);
+    }
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%llu|%016llx", static_cast<unsigned long long>(++token_counter_),
+                  static_cast<unsigned long long>(salt));
+    tokens_[buffer] = userId;
+    return buffer;
+}
+
+MockResponse MockApi::login(const json& body) {
+    std::string email = body.value("email", "");
+    std::string password = body.value("password", "");
+    if (email.empty() || password.empty()) return validationError("email", "The email and password fields are required.");
+
+    auto known = emails_.find(email);
+    if (known == emails_.end()) {
+        // Unknown accounts are created on the fly so load tests can use any credentials
+        Account account;
+        account.user.id = next_user_id_++;
+        account.user.username = email.substr(0, email.find('@'));
+        account.user.email = email;
+        account.user.role = body.value("role", "user");
+        account.password = password;
+        known = emails_.emplace(email, account.user.id).first;
+        accounts_[account.user.id] = account;
+    }
+    const Account& account = accounts_[known->second];
+    if (account.password != password) return message(401, "Invalid credentials.");
+    return jsonResponse(200, json{{"token", issueToken(account.user.id)}, {"user", account.user}});
+}
+
+MockResponse MockApi::signup(const json& body) {
+    std::string email = body.value("email", "");
+    std::string password = body.value("password", "");
+    if (email.empty() || password.empty()) return validationError("email", "The email and password fields are required.");
+    if (emails_.count(email)) return validationError("email", "The email has already been taken.");
+
+    Account account;
+    account.user.id = next_user_id_++;
+    account.user.username = body.value("username", "");
+    account.user.email = email;
+    account.user.phone = body.value("phone", "");
+    account.user.age = body.value("age", 0);
+    account.user.role = "user";
+    account.password = password;
+    emails_[email] = account.user.id;
+    accounts_[account.user.id] = account;
+    return jsonResponse(201, json{{"token", issueToken(account.user.id)}, {"user", account.user}});
+}
+
+MockResponse MockApi::logout(const std::string& token) {
+    tokens_.erase(token);
+    return noContent();
+}
+
+// --- Rooms ---
+
+std::string MockApi::roomListEtag() const {
+    return "\"rooms-" + std::to_string(rooms_version_) + "\"";
+}
+
+MockResponse MockApi::listRooms(const std::string& ifNoneMatch) {
+    std::string etag = roomListEtag();
+    if (etagMatches(ifNoneMatch, etag)) return notModified(etag);
+
+    json data = json::array();
+    for (const auto& entry : rooms_) data.push_back(entry.second.room);
+    MockResponse response = jsonResponse(200, json{{"data", data}});
+    response.headers.emplace_back("ETag", etag);
+    return response;
+}
+
+MockResponse MockApi::syncRooms(const std::string& since) {
+    uint64_t stamp;
+    bool full;
+    if (!sinceStamp(since, stamp, full)) return validationError("updated_since", "The updated since is not a valid cursor.");
+
+    json data = json::array();
+    for (const auto& entry : rooms_) {
+        if (full || entry.second.updatedAt > stamp) data.push_back(entry.second.room);
+    }
+    json deleted = json::array();
+    if (!full) {
+        for (const Tombstone& tombstone : tombstones_) {
+            if (tombstone.kind == Tombstone::Kind::Room && tombstone.deletedAt > stamp) deleted.push_back(tombstone.id);
+        }
+    }
+    return syncResponse(std::move(data), deleted, full);
+}
+
+MockResponse MockApi::getRoom(int id, const std::string& ifNoneMatch) {
+    auto it = rooms_.find(id);
+    if (it == rooms_.end()) return message(404, "Room not found.");
+    std::string etag = "\"room-" + std::to_string(id) + "-" + std::to_string(it->second.revision) + "\"";
+    if (etagMatches(ifNoneMatch, etag)) return notModified(etag);
+
+    MockResponse response = jsonResponse(200, json{{"data", it->second.room}});
+    response.headers.emplace_back("ETag", etag);
+    return response;
+}
+
+MockResponse MockApi::createRoom(const json& body) {
+    RoomData data;
+    try {
+        data = body.get<RoomData>();
+    } catch (const json::exception& e) {
+        return validationError("room", e.what());
+    }
+    if (data.name.empty()) return validationError("name", "The name field is required.");
+    int id = next_room_id_++;
+    rooms_[id] = RoomEntry{makeRoom(id, data), 1, nextStamp()};
+    rooms_version_++;
+    return jsonResponse(201, json{{"data", rooms_[id].room}});
+}
+
+MockResponse MockApi::updateRoom(int id, const json& body) {
+    auto it = rooms_.find(id);
+    if (it == rooms_.end()) return message(404, "Room not found.");
+    RoomData data;
+    try {
+        data = body.get<RoomData>();
+    } catch (const json::exception& e) {
+        return validationError("room", e.what());
+    }
+    it->second.room = makeRoom(id, data);
+    it->second.revision++;
+    it->second.updatedAt = nextStamp();
+    rooms_version_++;
+    return jsonResponse(200, json{{"data", it->second.room}});
+}
+
+MockResponse MockApi::deleteRoom(int id) {
+    if (rooms_.erase(id) == 0) return message(404, "Room not found.");
+    bury(Tombstone::Kind::Room, id, 0);
+    rooms_version_++;
+    return noContent();
+}
+
+// --- Bookings ---
+
+MockResponse MockApi::createBooking(const User& user, const json& body) {
+    BookingData data;
+    try {
+        data = body.get<BookingData>();
+    } catch (const json::exception& e) {
+        return validationError("booking", e.what());
+    }
+    auto room = rooms_.find(data.room_id);
+    if (room == rooms_.end()) return validationError("room_id", "The selected room id is invalid.");
+
+    if (!data.check_in.isSet()) return validationError("check_in", "The check in is not a valid date.");
+    if (!data.check_out.isSet() || data.check_out <= data.check_in) {
+        return validationError("check_out", "The check out must be a date after check in.");
+    }
+    if (data.guests < 1 || data.guests > room->second.room.capacity) {
+        return validationError("guests", "The number of guests exceeds the room capacity.");
+    }
+    if (options_.rejectOverlaps) {
+        for (const auto& entry : bookings_) {
+            const Booking& other = entry.second.booking;
+            if (other.roomId != data.room_id || other.status == "cancelled") continue;
+            if (other.checkIn < data.check_out && data.check_in < other.checkOut) {
+                return validationError("room_id", "The room is not available for the selected dates.");
+            }
+        }
+    }
+
+    Booking booking;
+    booking.id = next_booking_id_++;
+    booking.userId = user.id;
+    booking.roomId = data.room_id;
+    booking.checkIn = data.check_in;
+    booking.checkOut = data.check_out;
+    booking.guests = data.guests;
+    booking.status = "confirmed";
+    booking.package = data.package;
+    booking.housekeeping = data.housekeeping;
+    booking.housekeepingTime = data.housekeeping_time;
+    booking.parking = data.parking;
+    booking.totalPrice = static_cast<double>(data.check_out - data.check_in) * room->second.room.price;
+    bookings_[booking.id] = BookingEntry{booking, nextStamp()};
+    return jsonResponse(201, json{{"data", booking}});
+}
+
+MockResponse MockApi::getBooking(const User& user, int id) {
+    auto it = bookings_.find(id);
+    if (it == bookings_.end()) return message(404, "Booking not found.");
+    if (it->second.booking.userId != user.id && user.role != "admin") return message(403, "This action is unauthorized.");
+    return jsonResponse(200, json{{"data", it->second.booking}});
+}
+
+MockResponse MockApi::deleteBooking(const User& user, int id) {
+    auto it = bookings_.find(id);
+    if (it == bookings_.end()) return message(404, "Booking not found.");
+    if (it->second.booking.userId != user.id && user.role != "admin") return message(403, "This action is unauthorized.");
+    bury(Tombstone::Kind::Booking, id, it->second.booking.userId);
+    bookings_.erase(it);
+    return noContent();
+}
+
+MockResponse MockApi::syncBookings(const User& user, const std::string& since) {
+    uint64_t stamp;
+    bool full;
+    if (!sinceStamp(since, stamp, full)) return validationError("updated_since", "The updated since is not a valid cursor.");
+
+    json data = json::array();
+    for (const auto& entry : bookings_) {
+        if (entry.second.booking.userId == user.id && (full || entry.second.updatedAt > stamp)) {
+            data.push_back(entry.second.booking);
+        }
+    }
+    json deleted = json::array();
+    if (!full) {
+        for (const Tombstone& tombstone : tombstones_) {
+            if (tombstone.kind == Tombstone::Kind::Booking && tombstone.userId == user.id && tombstone.deletedAt > stamp) {
+                deleted.push_back(tombstone.id);
+            }
+        }
+    }
+    return syncResponse(std::move(data), deleted, full);
+}
+
+// --- Users ---
+
+MockResponse MockApi::getUser(const User& user, int id) {
+    if (id != user.id && user.role != "admin") return message(403, "This action is unauthorized.");
+    auto it = accounts_.find(id);
+    if (it == accounts_.end()) return message(404, "User not found.");
+    return jsonResponse(200, json{{"data", it->second.user}});
+}
+
+MockResponse MockApi::updateUser(const User& user, int id, const json& body) {
+    if (id != user.id && user.role != "admin") return message(403, "This action is unauthorized.");
+    auto it = accounts_.find(id);
+    if (it == accounts_.end()) return message(404, "User not found.");
+
+    User& target = it->second.user;
+    std::string email = body.value("email", target.email);
+    if (email != target.email) {
+        if (emails_.count(email)) return validationError("email", "The email has already been taken.");
+        emails_.erase(target.email);
+        emails_[email] = id;
+        target.email = email;
+    }
+    target.username = body.value("username", target.username);
+    target.phone = body.value("phone", target.phone);
+    target.age = body.value("age", target.age);
+    return jsonResponse(200, json{{"data", target}});
+}
+
+// --- Delta sync ---
+// Every write takes a new stamp; a sync returns the records stamped after the
+// client's cursor plus the ids deleted after it, and hands back the current
+// stamp as the next cursor. Deletions are remembered in a bounded list; a
+// cursor older than the oldest one forgotten gets everything (full_sync).
+
+uint64_t MockApi::nextStamp() {
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    last_stamp_ = std::max(static_cast<uint64_t>(now), last_stamp_ + 1); // Unique even within one microsecond
+    return last_stamp_;
+}
+
+void MockApi::bury(Tombstone::Kind kind, int id, int userId) {
+    tombstones_.push_back(Tombstone{kind, id, userId, nextStamp()});
+    if (tombstones_.size() > kMaxTombstones) {
+        pruned_through_ = tombstones_.front().deletedAt;
+        tombstones_.pop_front();
+    }
+}
+
+// An empty cursor asks for everything; false if the cursor can't be parsed
+bool MockApi::sinceStamp(const std::string& since, uint64_t& stamp, bool& full) const {
+    stamp = 0;
+    full = since.empty();
+    if (full) return true;
+    if (!parseStamp(since, stamp)) return false;
+    full = stamp < pruned_through_; // Deletions after it may have been forgotten
+    return true;
+}
+
+MockResponse MockApi::syncResponse(json data, const json& deleted, bool full) const {
+    return jsonResponse(200, json{
+        {"data", std::move(data)},
+        {"deleted", deleted},
+        {"meta", {
+            {"sync_cursor", formatStamp(last_stamp_)},
+            {"full_sync", full}
+        }}
+    });
+}
+
+// --- Pagination ---
+
+// Laravel-style {"data", "links", "meta"} page; links are absolute like the real API
+template <typename T>
+MockResponse MockApi::paginate(const std::vector<T>& items, const std::string& path,
+                               const std::map<std::string, std::string>& query, const std::string& baseUrl) const {
+    int page = 1;
+    int perPage = options_.perPage;
+    auto param = query.find("page");
+    if (param != query.end()) parseInt(param->second, page);
+    param = query.find("per_page");
+    if (param != query.end()) parseInt(param->second, perPage);
+    perPage = std::min(std::max(perPage, 1), 100);
+
+    int total = static_cast<int>(items.size());
+    int lastPage = std::max(1, (total + perPage - 1) / perPage);
+    page = std::min(std::max(page, 1), lastPage);
+
+    auto pageUrl = [&](int n) {
+        return json(baseUrl + path + "?page=" + std::to_string(n) + "&per_page=" + std::to_string(perPage));
+    };
+
+    json data = json::array();
+    int from = (page - 1) * perPage;
+    int to = std::min(total, from + perPage);
+    for (int i = from; i < to; ++i) data.push_back(items[static_cast<size_t>(i)]);
+
+    return jsonResponse(200, json{
+        {"data", data},
+        {"links", {
+            {"first", pageUrl(1)},
+            {"last", pageUrl(lastPage)},
+            {"prev", page > 1 ? pageUrl(page - 1) : json(nullptr)},
+            {"next", page < lastPage ? pageUrl(page + 1) : json(nullptr)}
+        }},
+        {"meta", {
+            {"current_page", page},
+            {"last_page", lastPage},
+            {"per_page", perPage},
+            {"total", total},
+            {"from", total ? json(from + 1) : json(nullptr)},
+            {"to", total ? json(to) : json(nullptr)}
+        }}
+    });
+}
+
+// --- Latency injection ---
+
+void MockApi::injectLatency() {
+    int delay = options_.latencyMs;
+    if (options_.jitterMs > 0) {
+        std::lock_guard<std::mutex> lock(rng_mutex_);
+        delay += std::uniform_int_distribution<int>(0, options_.jitterMs)(rng_);
+    }
+    if (delay > 0) std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+}
@@ -0,0 +1,142 @@
+// src/MockApi.h
+#ifndef MOCK_API_H
+#define MOCK_API_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "DataStructures.h"
+
+// --- Mock server configuration ---
+struct MockOptions {
+    int latencyMs = 0;          // Added to every response
+    int jitterMs = 0;           // Uniform extra delay in [0, jitterMs]
+    size_t payloadBytes = 0;    // Pad each room description to at least this many bytes
+    int roomCount = 20;         // Rooms seeded at startup
+    int perPage = 15;           // Default page size for paginated listings
+    bool rejectOverlaps = true; // 422 when a booking overlaps an existing one for the room
+};
+
+// Transport-neutral request/response, so the routing logic doesn't depend on the HTTP library
+struct MockRequest {
+    std::string method;         // "GET", "POST", ...
+    std::string target;         // Path below the API prefix plus query, e.g. "/bookings?page=2"
+    std::string body;
+    std::string authorization;  // Raw Authorization header
+    std::string ifNoneMatch;    // Raw If-None-Match header
+    std::string idempotencyKey; // Raw Idempotency-Key header
+    std::string baseUrl;        // Absolute API base used for pagination links
+};
+
+struct MockResponse {
+    int status = 200;
+    std::string body;
+    std::vector<std::pair<std::string, std::string>> headers;
+};
+
+// --- MockApi ---
+// In-memory stand-in for the Laravel API with the same JSON shapes the client
+// decodes ({"data": ...}, links/meta pagination, ETag revalidation, delta
+// sync with ?updated_since=). Thread-safe.
+class MockApi {
+public:
+    explicit MockApi(const MockOptions& options);
+
+    // Routes one request; applies the configured latency before returning
+    MockResponse handle(const MockRequest& request);
+
+private:
+    struct RoomEntry {
+        Room room;
+        uint64_t revision = 1;
+        uint64_t updatedAt = 0; // Change stamp (see nextStamp)
+    };
+    struct BookingEntry {
+        Booking booking;
+        uint64_t updatedAt = 0;
+    };
+    // A deleted record, kept so delta syncs can report it
+    struct Tombstone {
+        enum class Kind { Room, Booking };
+        Kind kind = Kind::Room;
+        int id = 0;
+        int userId = 0;         // Owner, for bookings
+        uint64_t deletedAt = 0;
+    };
+    struct Account {
+        User user;
+        std::string password;
+    };
+    // Outcome of a keyed write, returned again when the same key comes back
+    struct IdempotentResult {
+        std::string request; // Method, target and body the key was first used with
+        MockResponse response;
+    };
+    static constexpr size_t kMaxIdempotencyKeys = 10000; // Oldest keys are forgotten first
+    static constexpr size_t kMaxTombstones = 10000;      // Older cursors get a full sync instead
+
+    MockResponse route(const MockRequest& request, const std::string& path,
+                       const std::map<std::string, std::string>& query);
+
+    // --- Handlers (called with mutex_ held) ---
+    MockResponse login(const json& body);
+    MockResponse signup(const json& body);
+    MockResponse logout(const std::string& token);
+    MockResponse listRooms(const std::string& ifNoneMatch);
+    MockResponse syncRooms(const std::string& since);
+    MockResponse getRoom(int id, const std::string& ifNoneMatch);
+    MockResponse createRoom(const json& body);
+    MockResponse updateRoom(int id, const json& body);
+    MockResponse deleteRoom(int id);
+    MockResponse createBooking(const User& user, const json& body);
+    MockResponse getBooking(const User& user, int id);
+    MockResponse deleteBooking(const User& user, int id);
+    MockResponse syncBookings(const User& user, const std::string& since);
+    MockResponse getUser(const User& user, int id);
+    MockResponse updateUser(const User& user, int id, const json& body);
+
+    template <typename T>
+    MockResponse paginate(const std::vector<T>& items, const std::string& path,
+                          const std::map<std::string, std::string>& query, const std::string& baseUrl) const;
+
+    const User* authenticate(const std::string& authorization) const;
+    std::string issueToken(int userId);
+    Room makeRoom(int id, const RoomData& data) const;
+    std::string roomListEtag() const;
+    std::string idempotencyScope(const MockRequest& request) const;
+    uint64_t nextStamp();
+    void bury(Tombstone::Kind kind, int id, int userId);
+    bool sinceStamp(const std::string& since, uint64_t& stamp, bool& full) const;
+    MockResponse syncResponse(json data, const json& deleted, bool full) const;
+    void injectLatency();
+
+    MockOptions options_;
+    mutable std::mutex mutex_;
+    std::map<int, RoomEntry> rooms_;
+    std::map<int, BookingEntry> bookings_;
+    std::map<int, Account> accounts_;
+    std::unordered_map<std::string, int> emails_; // email -> user id
+    std::unordered_map<std::string, int> tokens_; // bearer token -> user id
+    int next_room_id_ = 1;
+    int next_booking_id_ = 1;
+    int next_user_id_ = 1;
+    uint64_t rooms_version_ = 1; // Bumped on any room write; drives the list ETag
+    uint64_t token_counter_ = 0;
+    uint64_t last_stamp_ = 0;           // Microseconds since the epoch, strictly increasing
+    std::deque<Tombstone> tombstones_;  // Oldest first
+    uint64_t pruned_through_ = 0;       // deletedAt of the newest tombstone dropped
+    std::unordered_map<std::string, IdempotentResult> idempotent_; // "user id:key" -> first outcome
+    std::deque<std::string> idempotent_order_;                      // Keys of idempotent_, oldest first
+
+    std::mutex rng_mutex_;
+    std::mt19937 rng_;
+};
+
+#endif // MOCK_API_H
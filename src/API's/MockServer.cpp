@@ -0,0 +1,115 @@
+// src/MockServer.cpp
+// hotel_mock_server: serves MockApi over HTTP with Crow, so the client and
+// hotel_bench can run without the Laravel/PHP stack or any network.
+//
+// Example:
+//   hotel_mock_server --port=8080 --latency-ms=5 --jitter-ms=3 --payload-bytes=2048
+//   API_BASE_URL=http://127.0.0.1:8080/api hotel_client
+#include <crow.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "MockApi.h"
+
+namespace {
+
+const std::string kApiPrefix = "/api";
+
+struct ServerConfig {
+    std::string bindAddress = "127.0.0.1";
+    int port = 8080;
+    unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+    bool verbose = false;
+    MockOptions api;
+};
+
+void printUsage() {
+    std::cout << "Usage: hotel_mock_server [options]\n"
+              << "  --bind=ADDR           Listen address (default 127.0.0.1)\n"
+              << "  --port=N              Listen port (default 8080); API is served under /api\n"
+              << "  --threads=N           Server threads (default: hardware concurrency)\n"
+              << "  --latency-ms=N        Delay added to every response (default 0)\n"
+              << "  --jitter-ms=N         Extra uniform random delay in [0, N] ms (default 0)\n"
+              << "  --payload-bytes=N     Pad room descriptions to N bytes (default 0)\n"
+              << "  --rooms=N             Rooms seeded at startup (default 20)\n"
+              << "  --per-page=N          Default page size for paginated listings (default 15)\n"
+              << "  --allow-overlaps      Accept bookings that overlap existing ones\n"
+              << "  --verbose             Log every request\n"
+              << "Seeded accounts: admin@hotel.local / guest@hotel.local (password: password).\n"
+              << "Logging in with any other email creates that account.\n";
+}
+
+bool parseArgs(int argc, char** argv, ServerConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        size_t eq = arg.find('=');
+        if (eq != std::string::npos) {
+            value = arg.substr(eq + 1);
+            arg = arg.substr(0, eq);
+        }
+        try {
+            if (arg == "--help" || arg == "-h") { printUsage(); return false; }
+            else if (arg == "--bind") config.bindAddress = value;
+            else if (arg == "--port") config.port = std::stoi(value);
+            else if (arg == "--threads") config.threads = static_cast<unsigned>(std::max(1, std::stoi(value)));
+            else if (arg == "--latency-ms") config.api.latencyMs = std::stoi(value);
+            else if (arg == "--jitter-ms") config.api.jitterMs = std::stoi(value);
+            else if (arg == "--payload-bytes") config.api.payloadBytes = std::stoul(value);
+            else if (arg == "--rooms") config.api.roomCount = std::stoi(value);
+            else if (arg == "--per-page") config.api.perPage = std::stoi(value);
+            else if (arg == "--allow-overlaps") config.api.rejectOverlaps = false;
+            else if (arg == "--verbose") config.verbose = true;
+            else {
+                std::cerr << "[Mock Error] Unknown option: " << arg << std::endl;
+                printUsage();
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "[Mock Error] Invalid value for " << arg << ": '" << value << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ServerConfig config;
+    if (!parseArgs(argc, argv, config)) return 1;
+
+    MockApi api(config.api);
+    crow::SimpleApp app;
+    app.loglevel(config.verbose ? crow::LogLevel::Info : crow::LogLevel::Warning);
+
+    // One catch-all route: MockApi does its own routing so it can be reused without Crow
+    CROW_CATCHALL_ROUTE(app)([&api](const crow::request& req) {
+        if (req.url.compare(0, kApiPrefix.size(), kApiPrefix) != 0) {
+            return crow::response(404, "{\"message\":\"Not Found\"}");
+        }
+        MockRequest request;
+        request.method = crow::method_name(req.method);
+        request.target = req.raw_url.substr(kApiPrefix.size());
+        request.body = req.body;
+        request.authorization = req.get_header_value("Authorization");
+        request.ifNoneMatch = req.get_header_value("If-None-Match");
+        request.idempotencyKey = req.get_header_value("Idempotency-Key");
+        request.baseUrl = "http://" + req.get_header_value("Host") + kApiPrefix;
+
+        MockResponse result = api.handle(request);
+        crow::response res(result.status, result.body);
+        for (const auto& header : result.headers) res.set_header(header.first, header.second);
+        return res;
+    });
+
+    std::cout << "[Mock] Serving http://" << config.bindAddress << ":" << config.port << kApiPrefix
+              << " (" << config.api.roomCount << " rooms, latency " << config.api.latencyMs << "+"
+              << config.api.jitterMs << " ms, " << config.threads << " threads)" << std::endl;
+    app.bindaddr(config.bindAddress)
+        .port(static_cast<std::uint16_t>(config.port))
+        .concurrency(static_cast<std::uint16_t>(config.threads))
+        .run();
+    return 0;
+}
@@ -0,0 +1,311 @@
+// src/MutationJournal.cpp
+#include "MutationJournal.h"
+#include "Logger.h"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr size_t kHeaderBytes = 4 + 4 + 1 + 8;          // size, crc, type, sequence
+constexpr uint32_t kMaxPayloadBytes = 16u * 1024 * 1024; // Anything larger is treated as corruption
+constexpr size_t kCommitBytes = 64 * 1024;               // Commit early once this much is buffered
+constexpr uint64_t kCompactBytes = 1024 * 1024;          // Truncate a fully acked file past this size
+
+// CRC-32 (IEEE 802.3, reflected), the same checksum zip and PNG use
+uint32_t crc32(const char* data, size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void putLittleEndian(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+uint64_t getLittleEndian(const std::string& in, size_t offset, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(static_cast<unsigned char>(in[offset + i])) << (8 * i);
+    return value;
+}
+
+// Flushes stdio's buffer and asks the OS to put the data on disk
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#elif defined(__APPLE__)
+    return fsync(fileno(file)) == 0;
+#else
+    return fdatasync(fileno(file)) == 0;
+#endif
+}
+
+// u32 user id, then method\0path\0key\0body
+bool splitAppendPayload(std::string_view payload, JournalEntry& entry) {
+    if (payload.size() < 4) return false;
+    uint32_t userId = 0;
+    for (int i = 0; i < 4; ++i) userId |= static_cast<uint32_t>(static_cast<unsigned char>(payload[i])) << (8 * i);
+    entry.userId = static_cast<int>(userId);
+    payload.remove_prefix(4);
+    std::string* fields[] = {&entry.method, &entry.path, &entry.idempotencyKey};
+    for (std::string* field : fields) {
+        size_t end = payload.find('\0');
+        if (end == std::string_view::npos) return false;
+        field->assign(payload.substr(0, end));
+        payload.remove_prefix(end + 1);
+    }
+    entry.body.assign(payload);
+    return true;
+}
+
+} // namespace
+
+MutationJournal::MutationJournal(std::string path, std::chrono::milliseconds commitInterval)
+    : path_(std::move(path)), commit_interval_(commitInterval) {}
+
+MutationJournal::~MutationJournal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    commit_wanted_.notify_all();
+    if (committer_.joinable()) committer_.join();
+    if (file_) std::fclose(file_);
+}
+
+bool MutationJournal::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) return true;
+    if (!recover()) return false;
+    open_ = true;
+    committer_ = std::thread([this] { commitLoop(); });
+    LOG_INFO("[Journal] Opened " << path_ << " with " << pending_.size() << " pending write(s)");
+    return true;
+}
+
+bool MutationJournal::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_ && !failed_;
+}
+
+void MutationJournal::encode(std::string& out, RecordType type, uint64_t sequence, std::string_view payload) {
+    size_t start = out.size();
+    putLittleEndian(out, payload.size(), 4);
+    putLittleEndian(out, 0, 4); // CRC, filled in below
+    out.push_back(static_cast<char>(type));
+    putLittleEndian(out, sequence, 8);
+    out.append(payload.data(), payload.size());
+    uint32_t crc = crc32(out.data() + start + 8, out.size() - start - 8);
+    for (int i = 0; i < 4; ++i) out[start + 4 + i] = static_cast<char>((crc >> (8 * i)) & 0xFF);
+}
+
+void MutationJournal::encodeAppend(std::string& out, const JournalEntry& entry) {
+    std::string payload;
+    payload.reserve(4 + entry.method.size() + entry.path.size() + entry.idempotencyKey.size() + entry.body.size() + 3);
+    putLittleEndian(payload, static_cast<uint32_t>(entry.userId), 4);
+    payload.append(entry.method).push_back('\0');
+    payload.append(entry.path).push_back('\0');
+    payload.append(entry.idempotencyKey).push_back('\0');
+    payload.append(entry.body);
+    encode(out, kAppend, entry.sequence, payload);
+}
+
+uint64_t MutationJournal::append(int userId, std::string_view method, std::string_view path,
+                                 std::string_view idempotencyKey, std::string_view body) {
+    JournalEntry entry;
+    entry.userId = userId;
+    entry.method.assign(method);
+    entry.path.assign(path);
+    entry.idempotencyKey.assign(idempotencyKey);
+    entry.body.assign(body);
+
+    bool wake;
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_ || failed_ || stopping_) return 0;
+        sequence = next_sequence_++;
+        entry.sequence = sequence;
+        wake = buffer_.empty();
+        encodeAppend(buffer_, entry);
+        wake = wake || buffer_.size() >= kCommitBytes;
+        buffered_sequence_ = sequence;
+        pending_.emplace(sequence, std::move(entry));
+        ++stats_.appended;
+    }
+    if (wake) commit_wanted_.notify_one();
+    return sequence;
+}
+
+bool MutationJournal::waitDurable(uint64_t sequence) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    committed_.wait(lock, [&] { return durable_sequence_ >= sequence || failed_ || !open_; });
+    return durable_sequence_ >= sequence;
+}
+
+void MutationJournal::ack(uint64_t sequence) {
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_ || pending_.erase(sequence) == 0) return;
+        wake = buffer_.empty();
+        encode(buffer_, kAck, sequence, {});
+        ++stats_.acked;
+    }
+    if (wake) commit_wanted_.notify_one();
+}
+
+std::vector<JournalEntry> MutationJournal::pending(int userId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<JournalEntry> entries;
+    for (const auto& entry : pending_) {
+        if (entry.second.userId == userId) entries.push_back(entry.second);
+    }
+    return entries;
+}
+
+size_t MutationJournal::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+size_t MutationJournal::pendingCount(int userId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(std::count_if(pending_.begin(), pending_.end(),
+                                             [userId](const auto& entry) { return entry.second.userId == userId; }));
+}
+
+MutationJournal::Stats MutationJournal::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+// --- Committer ---
+
+void MutationJournal::commitLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        commit_wanted_.wait(lock, [this] { return stopping_ || !buffer_.empty(); });
+        if (buffer_.empty()) break; // Stopping with nothing left to write
+        // Let the batch fill for one interval unless it is already big (or we are stopping)
+        commit_wanted_.wait_for(lock, commit_interval_,
+                                [this] { return stopping_ || buffer_.size() >= kCommitBytes; });
+
+        std::string batch;
+        batch.swap(buffer_);
+        uint64_t upTo = buffered_sequence_;
+        lock.unlock();
+        bool ok = !failed_ && commit(batch); // failed_ is only written by this thread
+        lock.lock();
+
+        if (ok) {
+            durable_sequence_ = upTo;
+            ++stats_.commits;
+            stats_.syncedBytes += batch.size();
+            file_bytes_ += batch.size();
+            if (pending_.empty() && buffer_.empty() && file_bytes_ >= kCompactBytes) {
+                // Everything written so far is acked: start the file over
+                std::FILE* fresh = std::freopen(path_.c_str(), "wb", file_);
+                file_ = fresh;
+                if (fresh) file_bytes_ = 0;
+                else { failed_ = true; LOG_ERROR("[Journal] Could not truncate " << path_); }
+            }
+        } else if (!failed_) {
+            failed_ = true;
+            LOG_ERROR("[Journal] Write to " << path_ << " failed; offline writes are no longer being saved");
+        }
+        committed_.notify_all();
+    }
+}
+
+bool MutationJournal::commit(const std::string& batch) {
+    return file_ && std::fwrite(batch.data(), 1, batch.size(), file_) == batch.size() && syncFile(file_);
+}
+
+// --- Recovery ---
+
+bool MutationJournal::recover() {
+    std::string data;
+    {
+        std::ifstream in(path_, std::ios::binary);
+        if (in) data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    size_t offset = 0;
+    while (offset + kHeaderBytes <= data.size()) {
+        uint32_t size = static_cast<uint32_t>(getLittleEndian(data, offset, 4));
+        uint32_t crc = static_cast<uint32_t>(getLittleEndian(data, offset + 4, 4));
+        if (size > kMaxPayloadBytes || data.size() - offset - kHeaderBytes < size) break;
+        if (crc32(data.data() + offset + 8, kHeaderBytes - 8 + size) != crc) break;
+
+        auto type = static_cast<uint8_t>(data[offset + 8]);
+        uint64_t sequence = getLittleEndian(data, offset + 9, 8);
+        std::string_view payload(data.data() + offset + kHeaderBytes, size);
+        if (type == kAppend) {
+            JournalEntry entry;
+            entry.sequence = sequence;
+            if (!splitAppendPayload(payload, entry)) break;
+            pending_[sequence] = std::move(entry);
+        } else if (type == kAck) {
+            pending_.erase(sequence);
+        } else {
+            break;
+        }
+        next_sequence_ = std::max(next_sequence_, sequence + 1);
+        offset += kHeaderBytes + size;
+    }
+    if (offset < data.size()) {
+        // A crash mid-write leaves a partial record; anything after it can't be trusted
+        LOG_WARN("[Journal] Dropping " << data.size() - offset << " torn or corrupt bytes at the end of " << path_);
+    }
+    buffered_sequence_ = durable_sequence_ = next_sequence_ - 1;
+    return rewrite();
+}
+
+bool MutationJournal::rewrite() {
+    std::string content;
+    for (const auto& entry : pending_) encodeAppend(content, entry.second);
+
+    // Write the compacted copy beside the journal, then swap it in
+    std::string temp = path_ + ".tmp";
+    std::FILE* out = std::fopen(temp.c_str(), "wb");
+    bool ok = out && std::fwrite(content.data(), 1, content.size(), out) == content.size() && syncFile(out);
+    if (out) std::fclose(out);
+    std::error_code ec;
+    if (ok) std::filesystem::rename(temp, path_, ec);
+    if (!ok || ec) {
+        LOG_ERROR("[Journal] Could not rewrite " << path_ << (ec ? ": " + ec.message() : std::string()));
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+
+    file_ = std::fopen(path_.c_str(), "ab");
+    if (!file_) {
+        LOG_ERROR("[Journal] Could not open " << path_ << " for appending");
+        return false;
+    }
+    file_bytes_ = content.size();
+    return true;
+}
@@ -0,0 +1,106 @@
+// src/MutationJournal.h
+#ifndef MUTATION_JOURNAL_H
+#define MUTATION_JOURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// One queued mutation, replayed exactly as it was first sent
+struct JournalEntry {
+    uint64_t sequence = 0;
+    int userId = 0;             // Who made it: replayed only while they are logged in
+    std::string method;         // "POST", "PUT"
+    std::string path;           // Relative to the API base, e.g. "/bookings"
+    std::string idempotencyKey; // Sent as Idempotency-Key on every attempt
+    std::string body;           // JSON text
+};
+
+// --- MutationJournal ---
+// Append-only local file of writes that could not reach the API, so they
+// survive an outage (and a restart) until JournalReplayer delivers them.
+//
+// Records are [u32 payload size][u32 crc32][u8 type][u64 sequence][payload],
+// little-endian, with the CRC over type, sequence and payload. An append's
+// payload is u32 user id, then method\0path\0key\0body; an ack has none and
+// retires the entry with its sequence. append() only copies the record into a
+// buffer; a committer thread writes the buffer and fsyncs it every
+// commitInterval (group commit), so a burst of appends shares one fsync. Acks
+// are committed the same way but nobody waits for them: an ack lost in a crash
+// means the write is sent once more on the next start, so the window is kept
+// to one commitInterval after delivery.
+//
+// open() replays the file, cuts it at the first torn or corrupt record and
+// rewrites it with only the entries still pending.
+class MutationJournal {
+public:
+    struct Stats {
+        uint64_t appended = 0; // Entries appended since open()
+        uint64_t acked = 0;
+        uint64_t commits = 0;  // write+fsync batches
+        uint64_t syncedBytes = 0;
+    };
+
+    explicit MutationJournal(std::string path,
+                             std::chrono::milliseconds commitInterval = std::chrono::milliseconds(2));
+    ~MutationJournal(); // Commits what is still buffered
+    MutationJournal(const MutationJournal&) = delete;
+    MutationJournal& operator=(const MutationJournal&) = delete;
+
+    // Recovers pending entries and starts the committer; false if the file can't be used
+    bool open();
+    bool isOpen() const;
+    const std::string& path() const { return path_; }
+
+    // Queues `userId`'s entry and returns its sequence (0 if the journal isn't open)
+    uint64_t append(int userId, std::string_view method, std::string_view path,
+                    std::string_view idempotencyKey, std::string_view body);
+    // Blocks until `sequence` is on disk; false if the commit failed
+    bool waitDurable(uint64_t sequence);
+    // The API has the entry (or rejected it for good): stop replaying it
+    void ack(uint64_t sequence);
+
+    std::vector<JournalEntry> pending(int userId) const; // `userId`'s entries, oldest first
+    size_t pendingCount() const;                         // Everyone's
+    size_t pendingCount(int userId) const;
+    Stats stats() const;
+
+private:
+    enum RecordType : uint8_t { kAppend = 1, kAck = 2 };
+
+    static void encode(std::string& out, RecordType type, uint64_t sequence, std::string_view payload);
+    static void encodeAppend(std::string& out, const JournalEntry& entry);
+    bool recover();               // Rebuilds pending_ from the file and compacts it
+    bool rewrite();               // Replaces the file with the pending entries only
+    void commitLoop();
+    bool commit(const std::string& batch);
+
+    std::string path_;
+    std::chrono::milliseconds commit_interval_;
+    std::FILE* file_ = nullptr;   // Written by the committer only (and open()/rewrite() before it starts)
+    uint64_t file_bytes_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable commit_wanted_;
+    std::condition_variable committed_;
+    std::string buffer_;          // Encoded records not yet written
+    std::map<uint64_t, JournalEntry> pending_;
+    uint64_t next_sequence_ = 1;
+    uint64_t buffered_sequence_ = 0; // Highest appended sequence in buffer_ or earlier
+    uint64_t durable_sequence_ = 0;  // Highest appended sequence known to be on disk
+    bool open_ = false;
+    bool failed_ = false;            // A commit failed: appends can no longer be made durable
+    bool stopping_ = false;
+    Stats stats_;
+    std::thread committer_;
+};
+
+#endif // MUTATION_JOURNAL_H
@@ -0,0 +1,122 @@
+// src/PageCursor.h
+#ifndef PAGE_CURSOR_H
+#define PAGE_CURSOR_H
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "JsonStreamDecoder.h" // PageInfo
+#include "WorkerPool.h"
+
+// One decoded page of a Laravel paginated listing
+template <typename T>
+struct Page {
+    bool ok = false;
+    std::vector<T> items;
+    std::string nextPath; // Relative path of the following page, empty on the last one
+    PageInfo info;
+};
+
+// --- PageCursor ---
+// Walks a paginated listing one item at a time. Only the current page and the
+// next (prefetched) page are held in memory, so a long history costs the same
+// as a single page, and the first item is available after one round trip.
+// While the caller consumes page N, page N+1 is already being fetched on the
+// client's worker pool. Destroying the cursor or calling stop() ends the walk early.
+template <typename T>
+class PageCursor {
+public:
+    using Fetcher = std::function<Page<T>(const std::string& path)>;
+
+    PageCursor(Fetcher fetcher, std::string firstPath, WorkerPool* prefetchPool)
+        : fetcher_(std::move(fetcher)), pool_(prefetchPool), next_path_(std::move(firstPath)) {}
+
+    PageCursor(PageCursor&&) = default;
+    PageCursor& operator=(PageCursor&&) = default;
+
+    // Next item, or std::nullopt when the listing is exhausted, stopped, or a page failed
+    std::optional<T> next() {
+        while (index_ >= current_.size()) {
+            if (!advancePage()) return std::nullopt;
+        }
+        return std::move(current_[index_++]);
+    }
+
+    // Calls fn(item) for each remaining item until it returns false. Returns the count visited.
+    template <typename F>
+    size_t forEach(F&& fn) {
+        size_t visited = 0;
+        while (std::optional<T> item = next()) {
+            ++visited;
+            if (!fn(item.value())) {
+                stop();
+                break;
+            }
+        }
+        return visited;
+    }
+
+    // Stop early; a prefetch in flight finishes in the background and is discarded
+    void stop() {
+        done_ = true;
+        current_.clear();
+        index_ = 0;
+        prefetch_.reset();
+    }
+
+    bool failed() const { return failed_; }
+    size_t pagesFetched() const { return pages_fetched_; }
+    const PageInfo& pageInfo() const { return info_; } // Paginator info of the latest page
+
+private:
+    bool advancePage() {
+        if (done_) return false;
+
+        Page<T> page;
+        if (prefetch_) {
+            page = prefetch_->get();
+            prefetch_.reset();
+        } else if (!next_path_.empty()) {
+            page = fetcher_(next_path_);
+        } else {
+            done_ = true;
+            return false;
+        }
+        ++pages_fetched_;
+
+        if (!page.ok) {
+            failed_ = true;
+            stop();
+            return false;
+        }
+        current_ = std::move(page.items);
+        index_ = 0;
+        info_ = std::move(page.info);
+        next_path_ = std::move(page.nextPath);
+
+        // Overlap the next round trip with the caller's processing of this page.
+        // Never from a worker thread: waiting on our own pool could deadlock it.
+        if (!next_path_.empty() && pool_ && !pool_->isWorkerThread()) {
+            prefetch_ = pool_->submit([fetcher = fetcher_, path = next_path_] { return fetcher(path); });
+            next_path_.clear();
+        }
+        return true;
+    }
+
+    Fetcher fetcher_;
+    WorkerPool* pool_;
+    std::string next_path_;
+    std::optional<std::future<Page<T>>> prefetch_;
+    std::vector<T> current_;
+    size_t index_ = 0;
+    PageInfo info_;
+    size_t pages_fetched_ = 0;
+    bool done_ = false;
+    bool failed_ = false;
+};
+
+#endif // PAGE_CURSOR_H
@@ -0,0 +1,225 @@
+// src/RateCalendar.cpp
+#include "RateCalendar.h"
+#include "Logger.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace {
+
+int64_t toCents(double amount) {
+    return static_cast<int64_t>(std::llround(amount * 100.0));
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+// 0 = Sunday; day 0 (1970-01-01) was a Thursday
+int weekday(int32_t days) {
+    return static_cast<int>(((days % 7) + 7 + 4) % 7);
+}
+
+bool inSeason(const Season& season, int month, int day) {
+    int at = month * 100 + day;
+    int start = season.startMonth * 100 + season.startDay;
+    int end = season.endMonth * 100 + season.endDay;
+    return start <= end ? at >= start && at <= end : at >= start || at <= end;
+}
+
+// "MM-DD"
+bool parseMonthDay(const std::string& text, int& month, int& day) {
+    Date date;
+    if (!Date::parse("2000-" + text, date)) return false; // A leap year, so 02-29 is accepted
+    int year;
+    date.toCivil(year, month, day);
+    return true;
+}
+
+} // namespace
+
+// --- RateRules ---
+
+std::optional<RateRules> RateRules::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return std::nullopt;
+
+    RateRules rules;
+    try {
+        json doc = json::parse(in);
+        rules.weekendMultiplier = doc.value("weekend_multiplier", 1.0);
+        if (doc.contains("weekend_nights")) {
+            static const char* names[] = {"sun", "mon", "tue", "wed", "thu", "fri", "sat"};
+            rules.weekendNights = 0;
+            for (const json& name : doc["weekend_nights"]) {
+                auto found = std::find_if(std::begin(names), std::end(names),
+                                          [&name](const char* n) { return equalsIgnoreCase(n, name.get<std::string>().substr(0, 3)); });
+                if (found == std::end(names)) throw std::runtime_error("unknown weekday '" + name.get<std::string>() + "'");
+                rules.weekendNights |= static_cast<uint8_t>(1u << (found - std::begin(names)));
+            }
+        }
+        for (const json& entry : doc.value("seasons", json::array())) {
+            Season season;
+            if (!parseMonthDay(entry.at("start").get<std::string>(), season.startMonth, season.startDay) ||
+                !parseMonthDay(entry.at("end").get<std::string>(), season.endMonth, season.endDay)) {
+                throw std::runtime_error("season dates must be MM-DD");
+            }
+            season.multiplier = entry.at("multiplier").get<double>();
+            rules.seasons.push_back(season);
+        }
+        for (const json& entry : doc.value("special_prices", json::array())) {
+            SpecialPrice special;
+            special.roomId = entry.at("room_id").get<int>();
+            special.first = entry.at("start_date").get<Date>();
+            special.last = entry.at("end_date").get<Date>();
+            special.price = entry.at("price").get<double>();
+            rules.specialPrices.push_back(special);
+        }
+        if (doc.contains("surcharges")) {
+            const json& surcharges = doc["surcharges"];
+            json packages = surcharges.value("packages", json::object());
+            for (const auto& package : packages.items()) {
+                rules.packagePerNight.emplace_back(package.key(), package.value().get<double>());
+            }
+            rules.housekeepingPerNight = surcharges.value("housekeeping", 0.0);
+            rules.parkingPerNight = surcharges.value("parking", 0.0);
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("[Rates] Could not read " << path << ": " << e.what());
+        return std::nullopt;
+    }
+    return rules;
+}
+
+// --- Building ---
+
+void RateCalendar::build(const std::vector<Room>& rooms, const RateRules& rules, Date firstNight, int32_t nights) {
+    room_ids_.clear();
+    slot_of_room_.clear();
+    day_base_ = firstNight.isSet() ? firstNight.days() : 0;
+    day_count_ = firstNight.isSet() ? std::clamp(nights, 0, kMaxHorizonDays) : 0;
+
+    std::vector<const Room*> slotRooms; // Duplicate ids: the first one wins
+    for (const Room& room : rooms) {
+        if (!slot_of_room_.emplace(room.id, room_ids_.size()).second) continue;
+        room_ids_.push_back(room.id);
+        slotRooms.push_back(&room);
+    }
+    std::unordered_map<int, std::vector<const SpecialPrice*>> specialsOf;
+    for (const SpecialPrice& special : rules.specialPrices) {
+        if (special.first.isSet() && special.last.isSet()) specialsOf[special.roomId].push_back(&special);
+    }
+
+    // Season and weekend multipliers are the same for every room: once per night
+    std::vector<double> multiplier(static_cast<size_t>(day_count_), 1.0);
+    for (int32_t d = 0; d < day_count_; ++d) {
+        int32_t day = day_base_ + d;
+        int year, month, dayOfMonth;
+        Date::fromDays(day).toCivil(year, month, dayOfMonth);
+        for (const Season& season : rules.seasons) {
+            if (inSeason(season, month, dayOfMonth)) {
+                multiplier[d] = season.multiplier;
+                break;
+            }
+        }
+        if (rules.weekendNights & (1u << weekday(day))) multiplier[d] *= rules.weekendMultiplier;
+    }
+
+    // Base prices per night, with special prices written over them
+    size_t stride = static_cast<size_t>(day_count_) + 1;
+    std::vector<double> base(static_cast<size_t>(day_count_));
+    prefix_.assign(room_ids_.size() * stride, 0);
+    for (size_t slot = 0; slot < slotRooms.size(); ++slot) {
+        std::fill(base.begin(), base.end(), slotRooms[slot]->price);
+        auto specials = specialsOf.find(room_ids_[slot]);
+        if (specials != specialsOf.end()) {
+            for (const SpecialPrice* special : specials->second) {
+                int32_t from = std::max(special->first.days(), day_base_) - day_base_;
+                int32_t to = std::min(special->last.days(), day_base_ + day_count_ - 1) - day_base_;
+                for (int32_t d = from; d <= to; ++d) base[d] = special->price;
+            }
+        }
+
+        int64_t* totals = &prefix_[slot * stride];
+        for (int32_t d = 0; d < day_count_; ++d) {
+            totals[d + 1] = totals[d] + toCents(base[d] * multiplier[d]);
+        }
+    }
+
+    package_cents_.clear();
+    for (const auto& package : rules.packagePerNight) package_cents_.emplace_back(package.first, toCents(package.second));
+    housekeeping_cents_ = toCents(rules.housekeepingPerNight);
+    parking_cents_ = toCents(rules.parkingPerNight);
+
+    LOG_DEBUG("[Rates] Built " << room_ids_.size() << " rooms x " << day_count_ << " nights from " << firstNight);
+}
+
+// --- Queries ---
+
+bool RateCalendar::covers(Date checkIn, Date checkOut) const {
+    return checkIn.isSet() && checkOut.isSet() && checkIn < checkOut &&
+           checkIn.days() >= day_base_ && checkOut.days() <= day_base_ + day_count_;
+}
+
+int64_t RateCalendar::extrasPerNightCents(const StayOptions& options) const {
+    int64_t cents = 0;
+    if (!options.package.empty()) {
+        for (const auto& package : package_cents_) {
+            if (equalsIgnoreCase(package.first, options.package)) {
+                cents += package.second;
+                break;
+            }
+        }
+    }
+    if (options.housekeeping) cents += housekeeping_cents_;
+    if (options.parking) cents += parking_cents_;
+    return cents;
+}
+
+RateCalendar::Quote RateCalendar::makeQuote(size_t slot, int32_t first, int32_t end, int64_t extrasPerNight) const {
+    const int64_t* totals = row(slot);
+    Quote quote;
+    quote.roomId = room_ids_[slot];
+    quote.nights = end - first;
+    quote.roomTotal = static_cast<double>(totals[end - day_base_] - totals[first - day_base_]) / 100.0;
+    quote.extras = static_cast<double>(extrasPerNight * quote.nights) / 100.0;
+    return quote;
+}
+
+std::optional<RateCalendar::Quote> RateCalendar::quote(int roomId, Date checkIn, Date checkOut,
+                                                       const StayOptions& options) const {
+    auto slot = slot_of_room_.find(roomId);
+    if (slot == slot_of_room_.end() || !covers(checkIn, checkOut)) return std::nullopt;
+    return makeQuote(slot->second, checkIn.days(), checkOut.days(), extrasPerNightCents(options));
+}
+
+std::optional<RateCalendar::Quote> RateCalendar::quote(const BookingData& booking) const {
+    StayOptions options;
+    options.package = booking.package;
+    options.housekeeping = booking.housekeeping;
+    options.parking = booking.parking;
+    return quote(booking.room_id, booking.check_in, booking.check_out, options);
+}
+
+std::vector<RateCalendar::Quote> RateCalendar::quoteAll(Date checkIn, Date checkOut, const StayOptions& options) const {
+    std::vector<Quote> quotes;
+    if (!covers(checkIn, checkOut)) return quotes;
+    int64_t extras = extrasPerNightCents(options);
+    quotes.reserve(room_ids_.size());
+    for (size_t slot = 0; slot < room_ids_.size(); ++slot) {
+        quotes.push_back(makeQuote(slot, checkIn.days(), checkOut.days(), extras));
+    }
+    return quotes;
+}
+
+std::optional<double> RateCalendar::nightlyRate(int roomId, Date night) const {
+    std::optional<Quote> oneNight = quote(roomId, night, night + 1);
+    if (!oneNight) return std::nullopt;
+    return oneNight->roomTotal;
+}
@@ -0,0 +1,120 @@
+// src/RateCalendar.h
+#ifndef RATE_CALENDAR_H
+#define RATE_CALENDAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "DataStructures.h"
+
+// --- Rate Rules ---
+// How a night's price is made, following the backend's
+// RoomService::calculateRoomPrice: the special price if one covers the night
+// (else Room::price), times the season's multiplier, times the weekend
+// multiplier, rounded to cents. The backend also applies an occupancy
+// multiplier (0.9 to 1.3, from how many rooms are taken that night). That is
+// not modelled here, so a quote can differ from what the API charges on busy
+// or quiet nights.
+
+// A room's event price for the nights first..last inclusive, like the API's
+// room_special_prices (start_date/end_date)
+struct SpecialPrice {
+    int roomId = 0;
+    Date first;
+    Date last;
+    double price = 0.0;
+};
+
+// Yearly recurring multiplier for month/day start..end inclusive; may wrap the
+// new year (e.g. 12-15 to 01-05)
+struct Season {
+    int startMonth = 1, startDay = 1;
+    int endMonth = 12, endDay = 31;
+    double multiplier = 1.0;
+};
+
+struct RateRules {
+    std::vector<SpecialPrice> specialPrices;
+    std::vector<Season> seasons;   // The first one covering a night applies
+    double weekendMultiplier = 1.0;
+    uint8_t weekendNights = 0x41;  // Bit per weekday (bit 0 = Sunday): Saturday and Sunday, like Carbon's isWeekend()
+
+    // Per-night extras
+    std::vector<std::pair<std::string, double>> packagePerNight; // By Booking::package, case-insensitive
+    double housekeepingPerNight = 0.0;
+    double parkingPerNight = 0.0;
+
+    // Reads a JSON rates file:
+    //   {"weekend_multiplier": 1.2, "weekend_nights": ["sat", "sun"],
+    //    "seasons": [{"start": "06-01", "end": "08-31", "multiplier": 1.5}],
+    //    "special_prices": [{"room_id": 3, "start_date": "2026-12-24", "end_date": "2026-12-26", "price": 400}],
+    //    "surcharges": {"packages": {"Gold": 30}, "housekeeping": 10, "parking": 15}}
+    // Every key is optional. std::nullopt if the file is missing or malformed (logged).
+    static std::optional<RateRules> load(const std::string& path);
+};
+
+// Extras chosen for a stay, charged per night
+struct StayOptions {
+    std::string_view package;   // Empty or unknown: no package surcharge
+    bool housekeeping = false;
+    bool parking = false;
+};
+
+// --- RateCalendar ---
+// Local stay quotes without a round trip. Nightly rates are computed once per
+// room over a fixed horizon and stored as running totals (prefix sums, in
+// cents so sums are exact), so the room charge for any check-in/check-out
+// pair is one subtraction, and extras are a per-night constant: O(1) per room
+// however long the stay. Rebuild when rooms or rules change.
+// Not thread-safe for writes: build from one thread, then query from any.
+class RateCalendar {
+public:
+    static constexpr int32_t kMaxHorizonDays = 3660; // ~10 years of nights
+
+    struct Quote {
+        int roomId = 0;
+        int nights = 0;
+        double roomTotal = 0.0;  // Sum of the nightly rates
+        double extras = 0.0;     // Package, housekeeping and parking for every night
+        double total() const { return roomTotal + extras; }
+    };
+
+    // Rates for every room for `nights` nights starting at firstNight
+    void build(const std::vector<Room>& rooms, const RateRules& rules, Date firstNight, int32_t nights);
+
+    // checkIn is the first night, checkOut the departure day (not a night).
+    // std::nullopt for unknown rooms, empty stays or nights outside the horizon.
+    std::optional<Quote> quote(int roomId, Date checkIn, Date checkOut, const StayOptions& options = {}) const;
+    std::optional<Quote> quote(const BookingData& booking) const;
+    // Every room, in the order given to build(); empty if the stay is outside the horizon
+    std::vector<Quote> quoteAll(Date checkIn, Date checkOut, const StayOptions& options = {}) const;
+
+    std::optional<double> nightlyRate(int roomId, Date night) const;
+    bool covers(Date checkIn, Date checkOut) const;
+
+    size_t roomCount() const { return room_ids_.size(); }
+    Date firstNight() const { return Date::fromDays(day_base_); }
+    Date endNight() const { return Date::fromDays(day_base_ + day_count_); } // First night not covered
+
+private:
+    int64_t extrasPerNightCents(const StayOptions& options) const;
+    const int64_t* row(size_t slot) const { return &prefix_[slot * (static_cast<size_t>(day_count_) + 1)]; }
+    Quote makeQuote(size_t slot, int32_t first, int32_t end, int64_t extrasPerNight) const;
+
+    std::vector<int> room_ids_;                       // Slot -> room id
+    std::unordered_map<int, size_t> slot_of_room_;
+    int32_t day_base_ = 0;                            // Day number of the first night
+    int32_t day_count_ = 0;
+    std::vector<int64_t> prefix_;                     // Per slot: day_count_ + 1 running totals, in cents
+
+    std::vector<std::pair<std::string, int64_t>> package_cents_;
+    int64_t housekeeping_cents_ = 0;
+    int64_t parking_cents_ = 0;
+};
+
+#endif // RATE_CALENDAR_H
@@ -0,0 +1,231 @@
+// src/RequestBuilder.cpp
+#include "RequestBuilder.h"
+#include <cpr/cpr.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <ostream>
+
+// --- RequestPath ---
+
+RequestPath& RequestPath::append(std::string_view text) {
+    size_t room = kCapacity - size_;
+    if (text.size() > room) {
+        overflowed_ = true;
+        text = text.substr(0, room);
+    }
+    std::copy(text.begin(), text.end(), buffer_.data() + size_);
+    size_ += text.size();
+    return *this;
+}
+
+RequestPath& RequestPath::append(long long value) {
+    std::to_chars_result result = std::to_chars(buffer_.data() + size_, buffer_.data() + kCapacity, value);
+    if (result.ec != std::errc()) {
+        overflowed_ = true;
+        return *this;
+    }
+    size_ = static_cast<size_t>(result.ptr - buffer_.data());
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& out, const RequestPath& path) {
+    return out << path.view();
+}
+
+// --- JsonWriter ---
+
+namespace {
+
+// Quoted and escaped the way nlohmann's dump() does it (UTF-8 passed through)
+void appendString(std::string& out, std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    out.push_back('"');
+    size_t run = 0; // Start of the current stretch that needs no escaping
+    for (size_t i = 0; i < text.size(); ++i) {
+        auto c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        out.append(text.data() + run, i - run);
+        run = i + 1;
+        out.push_back('\\');
+        switch (c) {
+            case '"':  out.push_back('"'); break;
+            case '\\': out.push_back('\\'); break;
+            case '\b': out.push_back('b'); break;
+            case '\f': out.push_back('f'); break;
+            case '\n': out.push_back('n'); break;
+            case '\r': out.push_back('r'); break;
+            case '\t': out.push_back('t'); break;
+            default:
+                out.append("u00", 3);
+                out.push_back(hex[c >> 4]);
+                out.push_back(hex[c & 0xF]);
+        }
+    }
+    out.append(text.data() + run, text.size() - run);
+    out.push_back('"');
+}
+
+} // namespace
+
+void JsonWriter::separate() {
+    if (after_key_) {
+        after_key_ = false; // The value completes a key/value pair
+        return;
+    }
+    if (depth_ == 0) return;
+    uint64_t bit = uint64_t(1) << ((depth_ - 1) & 63);
+    if (has_elements_ & bit) out_.push_back(',');
+    has_elements_ |= bit;
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    separate();
+    out_.push_back('{');
+    has_elements_ &= ~(uint64_t(1) << (depth_++ & 63));
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    --depth_;
+    out_.push_back('}');
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separate();
+    out_.push_back('[');
+    has_elements_ &= ~(uint64_t(1) << (depth_++ & 63));
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    --depth_;
+    out_.push_back(']');
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    separate();
+    appendString(out_, name);
+    out_.push_back(':');
+    after_key_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view text) {
+    separate();
+    appendString(out_, text);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(long long number) {
+    separate();
+    char buffer[24];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    if (!std::isfinite(number)) return null(); // As nlohmann writes NaN and infinities
+    separate();
+    char buffer[32];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, result.ptr);
+    // Keep integral values recognisably floating point ("150.0"), like dump()
+    if (std::find_if(buffer, result.ptr, [](char c) { return c == '.' || c == 'e'; }) == result.ptr) {
+        out_.append(".0", 2);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    if (flag) out_.append("true", 4);
+    else out_.append("false", 5);
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    separate();
+    out_.append("null", 4);
+    return *this;
+}
+
+void writeJson(JsonWriter& writer, const BookingData& booking) {
+    char checkIn[10], checkOut[10], housekeepingTime[8];
+    writer.beginObject()
+        .field("room_id", booking.room_id)
+        .field("check_in", std::string_view(checkIn, booking.check_in.format(checkIn) - checkIn))
+        .field("check_out", std::string_view(checkOut, booking.check_out.format(checkOut) - checkOut))
+        .field("guests", booking.guests)
+        .field("package", booking.package)
+        .field("housekeeping", booking.housekeeping)
+        .field("housekeeping_time",
+               std::string_view(housekeepingTime, booking.housekeeping_time.format(housekeepingTime) - housekeepingTime))
+        .field("parking", booking.parking)
+        .endObject();
+}
+
+void writeJson(JsonWriter& writer, const RoomData& room) {
+    writer.beginObject()
+        .field("name", room.name)
+        .field("type", room.type)
+        .field("price", room.price)
+        .field("bed_size", room.bed_size)
+        .field("view", room.view)
+        .field("capacity", room.capacity)
+        .field("description", room.description)
+        .key("amenities").beginArray();
+    for (const std::string& amenity : room.amenities) writer.value(amenity);
+    writer.endArray()
+        .field("image", room.image)
+        .field("available", room.available)
+        .endObject();
+}
+
+void writeJson(JsonWriter& writer, const PaymentData& payment) {
+    writer.beginObject()
+        .field("amount", payment.amount)
+        .field("currency", payment.currency)
+        .field("booking_id", payment.booking_id)
+        .field("payment_method", payment.payment_method)
+        .endObject();
+}
+
+// --- HeaderBlocks ---
+
+HeaderBlocks::HeaderBlocks()
+    : public_(std::make_shared<const cpr::Header>(cpr::Header{
+          {"Content-Type", "application/json"},
+          {"Accept", "application/json"}
+      })) {}
+
+void HeaderBlocks::setToken(const std::string& token) {
+    if (token.empty()) {
+        auth_.reset();
+        return;
+    }
+    auto headers = std::make_shared<cpr::Header>(*public_);
+    (*headers)["Authorization"] = "Bearer " + token;
+    auth_ = std::move(headers);
+}
+
+// --- RequestBuilder ---
+
+RequestBuilder& RequestBuilder::forThisThread() {
+    thread_local RequestBuilder builder;
+    return builder;
+}
+
+std::string_view RequestBuilder::url(std::string_view base, std::string_view path) {
+    url_.assign(base.data(), base.size());
+    url_.append(path.data(), path.size());
+    return url_;
+}
+
+std::string& RequestBuilder::body() {
+    body_.clear();
+    return body_;
+}
@@ -0,0 +1,121 @@
+// src/RequestBuilder.h
+#ifndef REQUEST_BUILDER_H
+#define REQUEST_BUILDER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "DataStructures.h"
+
+// Forward declare cpr::Header so users of the builder don't need the cpr headers
+namespace cpr {
+    class Header;
+}
+
+// --- RequestPath ---
+// A request path such as "/rooms/42", formatted into a fixed buffer with
+// std::to_chars instead of std::string concatenation and std::to_string.
+class RequestPath {
+public:
+    static constexpr size_t kCapacity = 256;
+
+    RequestPath() = default;
+    RequestPath(std::string_view prefix, long long id) { append(prefix).append(id); }
+
+    RequestPath& append(std::string_view text);
+    RequestPath& append(long long value);
+
+    std::string_view view() const { return std::string_view(buffer_.data(), size_); }
+    operator std::string_view() const { return view(); }
+    std::string str() const { return std::string(view()); }
+    bool overflowed() const { return overflowed_; } // Text was cut off at kCapacity
+
+private:
+    std::array<char, kCapacity> buffer_;
+    size_t size_ = 0;
+    bool overflowed_ = false;
+};
+
+std::ostream& operator<<(std::ostream& out, const RequestPath& path);
+
+// --- JsonWriter ---
+// Appends compact JSON straight to a string: no json DOM, no temporary strings.
+// Nesting is tracked in a 64-bit mask, so at most 64 levels.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+    JsonWriter& value(const std::string& text) { return value(std::string_view(text)); }
+    JsonWriter& value(long long number);
+    JsonWriter& value(int number) { return value(static_cast<long long>(number)); }
+    JsonWriter& value(double number); // Shortest round-trip form; null if not finite
+    JsonWriter& value(bool flag);
+    JsonWriter& null();
+
+    // Shorthand for key(name).value(v)
+    template <typename T>
+    JsonWriter& field(std::string_view name, const T& v) { return key(name).value(v); }
+
+private:
+    void separate(); // Comma before every element but the first of its container
+
+    std::string& out_;
+    uint64_t has_elements_ = 0; // Bit per nesting level: container already has an element
+    int depth_ = 0;
+    bool after_key_ = false;
+};
+
+// Request bodies, with the same keys and values as their nlohmann to_json
+void writeJson(JsonWriter& writer, const BookingData& booking);
+void writeJson(JsonWriter& writer, const RoomData& room);
+void writeJson(JsonWriter& writer, const PaymentData& payment);
+
+// --- HeaderBlocks ---
+// The default request headers, built once per auth token rather than per
+// request. Requests share a block by reference count; a new token makes a new
+// block, so requests already holding the old one are unaffected. Not
+// thread-safe to modify; ApiClient only reads published copies (TokenStore.h).
+class HeaderBlocks {
+public:
+    HeaderBlocks();
+    void setToken(const std::string& token); // Empty: no authenticated block
+    // The authenticated block only if there is a token; the public block otherwise
+    const std::shared_ptr<const cpr::Header>& get(bool withAuth) const { return withAuth && auth_ ? auth_ : public_; }
+    bool hasToken() const { return auth_ != nullptr; }
+
+private:
+    std::shared_ptr<const cpr::Header> public_;
+    std::shared_ptr<const cpr::Header> auth_;
+};
+
+// --- RequestBuilder ---
+// Scratch buffers for building one request: the full URL and the JSON body.
+// Their capacity is kept between requests, so once they have grown to the
+// largest request seen, building a request allocates nothing. One per thread
+// (forThisThread()); a request's views stay valid until that thread builds
+// the next one.
+class RequestBuilder {
+public:
+    static RequestBuilder& forThisThread();
+
+    std::string_view url(std::string_view base, std::string_view path);
+    std::string& body(); // Emptied, ready for a JsonWriter
+
+private:
+    std::string url_;
+    std::string body_;
+};
+
+#endif // REQUEST_BUILDER_H
@@ -0,0 +1,320 @@
+// src/RequestMetrics.cpp
+#include "RequestMetrics.h"
+#include <cpr/cpr.h>
+#include <curl/curl.h>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+namespace {
+
+uint64_t nowMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// A curl_off_t transfer info value: microseconds for *_TIME_T, bytes for SIZE_*_T (0 if unavailable)
+uint64_t curlValue(CURL* handle, CURLINFO info) {
+    curl_off_t value = 0;
+    if (curl_easy_getinfo(handle, info, &value) != CURLE_OK || value < 0) return 0;
+    return static_cast<uint64_t>(value);
+}
+
+uint64_t span(uint64_t from, uint64_t to) {
+    return to > from ? to - from : 0;
+}
+
+bool isNumber(std::string_view segment) {
+    return !segment.empty() && std::all_of(segment.begin(), segment.end(),
+                                           [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// Calls append(piece) for each piece of `path`'s route: the path without scheme,
+// host, query or fragment, with numeric segments replaced by "{id}"
+template <typename Append>
+void writeRoute(std::string_view path, Append&& append) {
+    size_t scheme = path.find("://");
+    if (scheme != std::string_view::npos) {
+        size_t slash = path.find('/', scheme + 3);
+        path = slash == std::string_view::npos ? std::string_view("/") : path.substr(slash);
+    }
+    size_t query = path.find_first_of("?#");
+    if (query != std::string_view::npos) path = path.substr(0, query);
+    if (path.empty()) {
+        append("/");
+        return;
+    }
+
+    size_t pos = 0;
+    while (pos < path.size()) {
+        size_t slash = path.find('/', pos);
+        size_t end = slash == std::string_view::npos ? path.size() : slash;
+        std::string_view segment = path.substr(pos, end - pos);
+        append(isNumber(segment) ? std::string_view("{id}") : segment);
+        if (slash == std::string_view::npos) break;
+        append("/");
+        pos = slash + 1;
+    }
+}
+
+// "METHOD route" built in place, so finding a known route allocates nothing.
+// A key too long for the buffer is recorded under "OTHER OTHER".
+class RouteKey {
+public:
+    RouteKey(std::string_view method, std::string_view path) {
+        append(method);
+        append(" ");
+        writeRoute(path, [this](std::string_view piece) { append(piece); });
+        if (overflow_) {
+            size_ = 0;
+            overflow_ = false;
+            append(kOtherKey);
+        }
+    }
+    std::string_view view() const { return std::string_view(buffer_.data(), size_); }
+
+    static constexpr std::string_view kOtherKey = "OTHER OTHER";
+
+private:
+    void append(std::string_view text) {
+        if (overflow_ || text.size() > buffer_.size() - size_) { overflow_ = true; return; }
+        std::copy(text.begin(), text.end(), buffer_.begin() + size_);
+        size_ += text.size();
+    }
+
+    std::array<char, 256> buffer_;
+    size_t size_ = 0;
+    bool overflow_ = false;
+};
+
+// Escapes a Prometheus label value (backslash, quote, newline)
+std::string labelValue(std::string_view value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') out += '\\';
+        if (c == '\n') { out += "\\n"; continue; }
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+const char* requestPhaseName(RequestPhase phase) {
+    switch (phase) {
+        case RequestPhase::Total:    return "total";
+        case RequestPhase::Dns:      return "dns";
+        case RequestPhase::Connect:  return "connect";
+        case RequestPhase::Tls:      return "tls";
+        case RequestPhase::Server:   return "server";
+        case RequestPhase::Download: return "download";
+        case RequestPhase::Parse:    return "parse";
+        case RequestPhase::Count:    break;
+    }
+    return "unknown";
+}
+
+// --- AtomicHistogram ---
+
+void AtomicHistogram::record(uint64_t micros) {
+    size_t bucket = static_cast<size_t>(
+        std::lower_bound(kUpperBoundsMicros.begin(), kUpperBoundsMicros.end(), micros) - kUpperBoundsMicros.begin());
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_micros_.fetch_add(micros, std::memory_order_relaxed);
+}
+
+AtomicHistogram::Snapshot AtomicHistogram::snapshot() const {
+    // Counters are read one by one, so a snapshot taken mid-record can be off by
+    // the in-flight requests; count is derived from the buckets to stay consistent
+    Snapshot s;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        s.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        s.count += s.buckets[i];
+    }
+    s.sumMicros = sum_micros_.load(std::memory_order_relaxed);
+    return s;
+}
+
+double AtomicHistogram::Snapshot::quantileMillis(double q) const {
+    if (count == 0) return 0.0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count) + 0.5);
+    rank = std::max<uint64_t>(1, std::min(rank, count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBoundCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return static_cast<double>(kUpperBoundsMicros[i]) / 1000.0;
+    }
+    return std::numeric_limits<double>::infinity();
+}
+
+// --- Routes ---
+
+std::string RequestMetrics::routeOf(std::string_view path) {
+    std::string route;
+    route.reserve(path.size());
+    writeRoute(path, [&route](std::string_view piece) { route.append(piece.data(), piece.size()); });
+    return route;
+}
+
+RequestMetrics::Route& RequestMetrics::route(std::string_view method, std::string_view path) {
+    RouteKey routeKey(method, path);
+    std::string_view key = routeKey.view();
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = routes_.find(key);
+        if (it != routes_.end()) return *it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (routes_.size() >= kMaxRoutes && routes_.find(key) == routes_.end()) key = RouteKey::kOtherKey;
+    auto it = routes_.find(key);
+    if (it != routes_.end()) return *it->second;
+
+    auto fresh = std::make_unique<Route>();
+    fresh->key.assign(key.data(), key.size());
+    size_t space = key.find(' ');
+    fresh->method.assign(key.substr(0, space));
+    fresh->route.assign(key.substr(space + 1));
+    std::string_view stored = fresh->key; // Owned by the Route, which never moves
+    return *routes_.emplace(stored, std::move(fresh)).first->second;
+}
+
+// --- Recording ---
+
+void RequestMetrics::recordTransfer(std::string_view method, std::string_view path,
+                                    const cpr::Response& response, cpr::Session& session) {
+    Route& r = route(method, path);
+    r.requests.fetch_add(1, std::memory_order_relaxed);
+
+    size_t statusClass = kStatusClassCount - 1;
+    if (!response.error && response.status_code >= 100 && response.status_code < 600) {
+        statusClass = static_cast<size_t>(response.status_code / 100 - 1);
+    }
+    r.statusClasses[statusClass].fetch_add(1, std::memory_order_relaxed);
+
+    CURL* handle = session.GetCurlHolder()->handle;
+    r.bytesSent.fetch_add(curlValue(handle, CURLINFO_SIZE_UPLOAD_T), std::memory_order_relaxed);
+    r.bytesReceived.fetch_add(curlValue(handle, CURLINFO_SIZE_DOWNLOAD_T), std::memory_order_relaxed);
+    r.bytesDecoded.fetch_add(response.text.size(), std::memory_order_relaxed);
+
+    // curl reports milestones as time since the transfer started
+    uint64_t nameLookup = curlValue(handle, CURLINFO_NAMELOOKUP_TIME_T);
+    uint64_t connected = curlValue(handle, CURLINFO_CONNECT_TIME_T);
+    uint64_t tlsDone = curlValue(handle, CURLINFO_APPCONNECT_TIME_T);
+    uint64_t preTransfer = curlValue(handle, CURLINFO_PRETRANSFER_TIME_T);
+    uint64_t firstByte = curlValue(handle, CURLINFO_STARTTRANSFER_TIME_T);
+    uint64_t total = curlValue(handle, CURLINFO_TOTAL_TIME_T);
+
+    long newConnections = 0;
+    curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &newConnections);
+    if (newConnections > 0) {
+        r.phase(RequestPhase::Dns).record(nameLookup);
+        r.phase(RequestPhase::Connect).record(span(nameLookup, connected));
+        if (tlsDone > 0) r.phase(RequestPhase::Tls).record(span(connected, tlsDone));
+    }
+    r.phase(RequestPhase::Total).record(total);
+    if (firstByte > 0) {
+        r.phase(RequestPhase::Server).record(span(preTransfer, firstByte));
+        r.phase(RequestPhase::Download).record(span(firstByte, total));
+    }
+}
+
+void RequestMetrics::recordParse(std::string_view method, std::string_view path, uint64_t micros) {
+    route(method, path).phase(RequestPhase::Parse).record(micros);
+}
+
+RequestMetrics::ParseTimer::ParseTimer(RequestMetrics& metrics, std::string_view method, std::string_view path)
+    : metrics_(metrics), method_(method), path_(path), started_(nowMicros()) {}
+
+void RequestMetrics::ParseTimer::stop() {
+    if (stopped_) return;
+    stopped_ = true;
+    metrics_.recordParse(method_, path_, nowMicros() - started_);
+}
+
+// --- Reporting ---
+
+RequestMetrics::Snapshot RequestMetrics::snapshot() const {
+    Snapshot result;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    result.reserve(routes_.size());
+    for (const auto& entry : routes_) {
+        const Route& r = *entry.second;
+        RouteSnapshot s;
+        s.method = r.method;
+        s.route = r.route;
+        s.requests = r.requests.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kStatusClassCount; ++i) s.statusClasses[i] = r.statusClasses[i].load(std::memory_order_relaxed);
+        s.bytesSent = r.bytesSent.load(std::memory_order_relaxed);
+        s.bytesReceived = r.bytesReceived.load(std::memory_order_relaxed);
+        s.bytesDecoded = r.bytesDecoded.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kRequestPhaseCount; ++i) s.phases[i] = r.phases[i].snapshot();
+        result.push_back(std::move(s));
+    }
+    lock.unlock();
+
+    std::sort(result.begin(), result.end(), [](const RouteSnapshot& a, const RouteSnapshot& b) {
+        return a.route != b.route ? a.route < b.route : a.method < b.method;
+    });
+    return result;
+}
+
+std::optional<AtomicHistogram::Snapshot> RequestMetrics::histogram(std::string_view method, std::string_view path,
+                                                                  RequestPhase phase) const {
+    RouteKey key(method, path);
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = routes_.find(key.view());
+    if (it == routes_.end()) return std::nullopt;
+    return it->second->phases[static_cast<size_t>(phase)].snapshot();
+}
+
+std::string RequestMetrics::prometheusText() const {
+    static const char* const kStatusLabels[kStatusClassCount] = {"1xx", "2xx", "3xx", "4xx", "5xx", "error"};
+    Snapshot routes = snapshot();
+    std::ostringstream out;
+
+    out << "# HELP hotel_client_requests_total Requests sent by the API client, by status class (error: no response).\n"
+        << "# TYPE hotel_client_requests_total counter\n";
+    for (const auto& r : routes) {
+        std::string labels = "method=\"" + labelValue(r.method) + "\",route=\"" + labelValue(r.route) + "\"";
+        for (size_t i = 0; i < kStatusClassCount; ++i) {
+            if (r.statusClasses[i] == 0) continue;
+            out << "hotel_client_requests_total{" << labels << ",status=\"" << kStatusLabels[i] << "\"} "
+                << r.statusClasses[i] << '\n';
+        }
+    }
+
+    out << "# HELP hotel_client_body_bytes_total Request and response body bytes (received: on the wire, decoded: after decompression).\n"
+        << "# TYPE hotel_client_body_bytes_total counter\n";
+    for (const auto& r : routes) {
+        std::string labels = "method=\"" + labelValue(r.method) + "\",route=\"" + labelValue(r.route) + "\"";
+        out << "hotel_client_body_bytes_total{" << labels << ",direction=\"sent\"} " << r.bytesSent << '\n'
+            << "hotel_client_body_bytes_total{" << labels << ",direction=\"received\"} " << r.bytesReceived << '\n'
+            << "hotel_client_body_bytes_total{" << labels << ",direction=\"decoded\"} " << r.bytesDecoded << '\n';
+    }
+
+    out << "# HELP hotel_client_request_duration_seconds Request time by phase (total, dns, connect, tls, server, download, parse).\n"
+        << "# TYPE hotel_client_request_duration_seconds histogram\n";
+    for (const auto& r : routes) {
+        std::string labels = "method=\"" + labelValue(r.method) + "\",route=\"" + labelValue(r.route) + "\"";
+        for (size_t p = 0; p < kRequestPhaseCount; ++p) {
+            const AtomicHistogram::Snapshot& h = r.phases[p];
+            if (h.count == 0) continue;
+            std::string phaseLabels = labels + ",phase=\"" + requestPhaseName(static_cast<RequestPhase>(p)) + "\"";
+            uint64_t cumulative = 0;
+            for (size_t b = 0; b < AtomicHistogram::kBoundCount; ++b) {
+                cumulative += h.buckets[b];
+                out << "hotel_client_request_duration_seconds_bucket{" << phaseLabels << ",le=\""
+                    << static_cast<double>(AtomicHistogram::kUpperBoundsMicros[b]) / 1e6 << "\"} " << cumulative << '\n';
+            }
+            out << "hotel_client_request_duration_seconds_bucket{" << phaseLabels << ",le=\"+Inf\"} " << h.count << '\n'
+                << "hotel_client_request_duration_seconds_sum{" << phaseLabels << "} "
+                << static_cast<double>(h.sumMicros) / 1e6 << '\n'
+                << "hotel_client_request_duration_seconds_count{" << phaseLabels << "} " << h.count << '\n';
+        }
+    }
+    return out.str();
+}
@@ -0,0 +1,151 @@
+// src/RequestMetrics.h
+#ifndef REQUEST_METRICS_H
+#define REQUEST_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Forward declare cpr types so users of the metrics don't need the cpr headers
+namespace cpr {
+    class Session;
+    class Response;
+}
+
+// --- Request Phases ---
+// Where the time of one request went. The connection phases are only recorded
+// for requests that opened a new connection; parse is the client's own decoding.
+enum class RequestPhase : size_t {
+    Total = 0,   // Whole transfer, as curl measured it
+    Dns,         // Name lookup
+    Connect,     // TCP handshake
+    Tls,         // TLS handshake (https only)
+    Server,      // Request sent -> first response byte: backend time plus one round trip
+    Download,    // First byte -> last byte
+    Parse,       // Client-side JSON decoding of the body
+    Count
+};
+constexpr size_t kRequestPhaseCount = static_cast<size_t>(RequestPhase::Count);
+const char* requestPhaseName(RequestPhase phase);
+
+// --- AtomicHistogram ---
+// Fixed-bucket latency histogram that any number of threads can record into
+// with relaxed atomic increments. Bucket bounds match the usual Prometheus
+// latency buckets, from 0.5 ms to 10 s plus an overflow bucket.
+class AtomicHistogram {
+public:
+    static constexpr size_t kBoundCount = 14;
+    static constexpr size_t kBucketCount = kBoundCount + 1; // Last bucket: above every bound
+    static constexpr std::array<uint64_t, kBoundCount> kUpperBoundsMicros = {
+        500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+        1000000, 2500000, 5000000, 10000000};
+
+    struct Snapshot {
+        std::array<uint64_t, kBucketCount> buckets{}; // Per bucket, not cumulative
+        uint64_t count = 0;
+        uint64_t sumMicros = 0;
+
+        double meanMillis() const { return count ? static_cast<double>(sumMicros) / 1000.0 / static_cast<double>(count) : 0.0; }
+        // Upper bound (ms) of the bucket holding the q-th quantile, q in (0, 1]; infinity in the overflow bucket
+        double quantileMillis(double q) const;
+    };
+
+    void record(uint64_t micros);
+    Snapshot snapshot() const;
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+    std::atomic<uint64_t> sum_micros_{0};
+};
+
+// --- RequestMetrics ---
+// Per-route counters and phase histograms for ApiClient requests. Routes are
+// the method plus the path with numeric segments folded to {id} and the query
+// dropped, so "GET /rooms/7?x=1" and "GET /rooms/9" are both "GET /rooms/{id}".
+// Recording builds the route key in a stack buffer, takes a shared lock to find
+// it (the map is keyed by views of each route's own key string, so looking one
+// up allocates nothing) and otherwise only touches atomics; a new route takes
+// the exclusive lock once.
+class RequestMetrics {
+public:
+    static constexpr size_t kStatusClassCount = 6; // 1xx..5xx, then transport errors (no response)
+    static constexpr size_t kMaxRoutes = 256;      // Beyond this, new routes share "OTHER"
+
+    struct RouteSnapshot {
+        std::string method;
+        std::string route;
+        uint64_t requests = 0;
+        std::array<uint64_t, kStatusClassCount> statusClasses{};
+        uint64_t bytesSent = 0;     // Request bodies
+        uint64_t bytesReceived = 0; // Response bodies as they came over the wire (compressed, if they were)
+        uint64_t bytesDecoded = 0;  // Response bodies after decompression
+        std::array<AtomicHistogram::Snapshot, kRequestPhaseCount> phases;
+
+        const AtomicHistogram::Snapshot& phase(RequestPhase p) const { return phases[static_cast<size_t>(p)]; }
+        uint64_t errors() const { return statusClasses[3] + statusClasses[4] + statusClasses[5]; } // 4xx, 5xx, transport
+    };
+    using Snapshot = std::vector<RouteSnapshot>; // Sorted by route, then method
+
+    // "GET /rooms/{id}"-style route of a request path (absolute URLs are reduced to their path)
+    static std::string routeOf(std::string_view path);
+
+    // After a transfer on `session`: status class, body sizes and curl's timing breakdown
+    void recordTransfer(std::string_view method, std::string_view path,
+                        const cpr::Response& response, cpr::Session& session);
+    void recordParse(std::string_view method, std::string_view path, uint64_t micros);
+
+    Snapshot snapshot() const;
+    // One phase of one route, if that route has been seen (e.g. to pick a hedge delay)
+    std::optional<AtomicHistogram::Snapshot> histogram(std::string_view method, std::string_view path, RequestPhase phase) const;
+
+    // Prometheus text exposition format (version 0.0.4)
+    std::string prometheusText() const;
+
+    // Times a decode and records it as the route's parse phase at stop() or,
+    // if stop() wasn't called, when it goes out of scope
+    class ParseTimer {
+    public:
+        ParseTimer(RequestMetrics& metrics, std::string_view method, std::string_view path);
+        ~ParseTimer() { stop(); }
+        void stop();
+        ParseTimer(const ParseTimer&) = delete;
+        ParseTimer& operator=(const ParseTimer&) = delete;
+
+    private:
+        RequestMetrics& metrics_;
+        std::string_view method_;
+        std::string_view path_;
+        uint64_t started_;
+        bool stopped_ = false;
+    };
+
+private:
+    struct Route {
+        std::string key;    // "METHOD route"; routes_ keys view it
+        std::string method;
+        std::string route;
+        std::atomic<uint64_t> requests{0};
+        std::array<std::atomic<uint64_t>, kStatusClassCount> statusClasses{};
+        std::atomic<uint64_t> bytesSent{0};
+        std::atomic<uint64_t> bytesReceived{0};
+        std::atomic<uint64_t> bytesDecoded{0};
+        std::array<AtomicHistogram, kRequestPhaseCount> phases;
+
+        AtomicHistogram& phase(RequestPhase p) { return phases[static_cast<size_t>(p)]; }
+    };
+
+    Route& route(std::string_view method, std::string_view path);
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, std::unique_ptr<Route>> routes_; // Keyed by Route::key
+};
+
+#endif // REQUEST_METRICS_H
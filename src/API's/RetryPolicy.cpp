@@ -0,0 +1,55 @@
+// src/RetryPolicy.cpp
+#include "RetryPolicy.h"
+#include <cpr/cpr.h>
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace {
+
+// Seconds from a Retry-After header; the HTTP-date form is ignored (0)
+long retryAfterSeconds(const cpr::Response& response) {
+    auto it = response.header.find("Retry-After");
+    if (it == response.header.end()) return 0;
+    try {
+        return std::max(0L, std::stol(it->second));
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+} // namespace
+
+bool RetryPolicy::isRetryable(const cpr::Response& response) {
+    if (response.error) {
+        // Deliberately cancelled transfers (e.g. a hedge that lost) are not failures
+        return response.error.code != cpr::ErrorCode::REQUEST_CANCELLED;
+    }
+    switch (response.status_code) {
+        case 408: // Request Timeout
+        case 429: // Too Many Requests
+        case 502: // Bad Gateway
+        case 503: // Service Unavailable
+        case 504: // Gateway Timeout
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::chrono::milliseconds RetryPolicy::delayBefore(int retry, const cpr::Response& response) const {
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+
+    // baseDelay * 2^(retry-1), without overflowing for large retry counts
+    long long cap = maxDelay.count();
+    long long ceiling = baseDelay.count();
+    for (int i = 1; i < retry && ceiling < cap; ++i) ceiling *= 2;
+    ceiling = std::max(0LL, std::min(ceiling, cap));
+    std::uniform_int_distribution<long long> jitter(0, ceiling);
+    long long delay = jitter(rng);
+
+    if (!response.error && (response.status_code == 429 || response.status_code == 503)) {
+        delay = std::max(delay, std::min(static_cast<long long>(retryAfterSeconds(response)) * 1000, cap));
+    }
+    return std::chrono::milliseconds(delay);
+}
@@ -0,0 +1,50 @@
+// src/RetryPolicy.h
+#ifndef RETRY_POLICY_H
+#define RETRY_POLICY_H
+
+#include <chrono>
+#include <cstdint>
+
+// Forward declare cpr::Response so users of the policy don't need the cpr headers
+namespace cpr {
+    class Response;
+}
+
+// --- RetryPolicy ---
+// How ApiClient retries idempotent requests (GET) that failed transiently:
+// transport errors (connect failure, timeout) and 408/429/502/503/504.
+// Retry n waits a random time in [0, min(maxDelay, baseDelay * 2^(n-1))]
+// ("full jitter"), so clients that failed together don't retry together.
+// A Retry-After header on 429/503 raises the wait, up to maxDelay.
+struct RetryPolicy {
+    int maxAttempts = 3;                       // Including the first; 1 disables retries
+    std::chrono::milliseconds baseDelay{50};
+    std::chrono::milliseconds maxDelay{2000};
+
+    // Wait before retry number `retry` (1 for the first retry) after `response`
+    std::chrono::milliseconds delayBefore(int retry, const cpr::Response& response) const;
+
+    static bool isRetryable(const cpr::Response& response);
+};
+
+// --- HedgePolicy ---
+// Hedged reads for single-resource GETs: if the first request hasn't answered
+// after the route's observed latency quantile, a second copy goes out on
+// another pooled connection and whichever answers first is used; the other
+// is cancelled. Off by default since it adds load on the server.
+struct HedgePolicy {
+    bool enabled = false;
+    double quantile = 0.95;                       // Hedge after this latency quantile of the route
+    uint64_t minSamples = 50;                     // Use defaultDelay until the route has this many
+    std::chrono::milliseconds defaultDelay{250};
+    std::chrono::milliseconds minDelay{5};        // Never hedge sooner than this
+};
+
+// Counters for retries and hedges, for checking what the policies cost
+struct RetryStats {
+    uint64_t retries = 0;     // Extra attempts after a transient failure
+    uint64_t hedgesSent = 0;  // Duplicate GETs sent
+    uint64_t hedgesWon = 0;   // Duplicates that answered before the original
+};
+
+#endif // RETRY_POLICY_H
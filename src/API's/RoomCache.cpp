@@ -0,0 +1,172 @@
+// src/RoomCache.cpp
+#include "RoomCache.h"
+
+RoomCache::RoomCache(std::chrono::seconds ttl) : ttl_(ttl) {}
+
+void RoomCache::setTtl(std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ttl_ = ttl;
+}
+
+uint64_t RoomCache::generation() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+}
+
+bool RoomCache::isFresh(Clock::time_point fetchedAt) const {
+    // A default time point marks seeded entries, which always need revalidating
+    return fetchedAt != Clock::time_point{} && Clock::now() - fetchedAt < ttl_;
+}
+
+
+// --- Full catalog ---
+
+std::optional<std::vector<Room>> RoomCache::freshList() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!list_valid_ || !isFresh(list_fetched_at_)) return std::nullopt;
+
+    std::vector<Room> rooms;
+    rooms.reserve(list_order_.size());
+    for (int id : list_order_) {
+        auto it = rooms_.find(id);
+        if (it == rooms_.end()) return std::nullopt; // Partially invalidated
+        rooms.push_back(it->second.room);
+    }
+    stats_.hits++;
+    return rooms;
+}
+
+RoomCache::Validators RoomCache::listValidators() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return list_valid_ ? list_validators_ : Validators{};
+}
+
+std::optional<std::vector<Room>> RoomCache::revalidateList() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!list_valid_) return std::nullopt;
+
+    std::vector<Room> rooms;
+    rooms.reserve(list_order_.size());
+    auto now = Clock::now();
+    for (int id : list_order_) {
+        auto it = rooms_.find(id);
+        if (it == rooms_.end()) return std::nullopt;
+        it->second.fetchedAt = now;
+        rooms.push_back(it->second.room);
+    }
+    list_fetched_at_ = now;
+    stats_.revalidated++;
+    return rooms;
+}
+
+void RoomCache::storeList(const std::vector<Room>& rooms, const Validators& validators, uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.misses++;
+    if (generation != generation_) return; // A write happened while this was in flight
+
+    auto now = Clock::now();
+    rooms_.clear();
+    list_order_.clear();
+    list_order_.reserve(rooms.size());
+    for (const auto& room : rooms) {
+        rooms_[room.id] = RoomEntry{room, Validators{}, now};
+        list_order_.push_back(room.id);
+    }
+    list_valid_ = true;
+    list_validators_ = validators;
+    list_fetched_at_ = now;
+}
+
+std::optional<RoomCache::Catalog> RoomCache::catalog() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!list_valid_) return std::nullopt;
+    Catalog catalog;
+    catalog.rooms.reserve(list_order_.size());
+    for (int id : list_order_) {
+        auto it = rooms_.find(id);
+        if (it == rooms_.end()) return std::nullopt;
+        catalog.rooms.push_back(it->second.room);
+    }
+    catalog.validators = list_validators_;
+    return catalog;
+}
+
+void RoomCache::seedList(const Catalog& catalog) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    rooms_.clear();
+    list_order_.clear();
+    list_order_.reserve(catalog.rooms.size());
+    for (const auto& room : catalog.rooms) {
+        rooms_[room.id] = RoomEntry{room, Validators{}, Clock::time_point{}};
+        list_order_.push_back(room.id);
+    }
+    list_valid_ = true;
+    list_validators_ = catalog.validators;
+    list_fetched_at_ = Clock::time_point{};
+}
+
+
+// --- Single room ---
+
+std::optional<Room> RoomCache::freshRoom(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = rooms_.find(id);
+    if (it == rooms_.end() || !isFresh(it->second.fetchedAt)) return std::nullopt;
+    stats_.hits++;
+    return it->second.room;
+}
+
+RoomCache::Validators RoomCache::roomValidators(int id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = rooms_.find(id);
+    return it == rooms_.end() ? Validators{} : it->second.validators;
+}
+
+std::optional<Room> RoomCache::revalidateRoom(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = rooms_.find(id);
+    if (it == rooms_.end()) return std::nullopt;
+    it->second.fetchedAt = Clock::now();
+    stats_.revalidated++;
+    return it->second.room;
+}
+
+void RoomCache::storeRoom(const Room& room, const Validators& validators, uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.misses++;
+    if (generation != generation_) return;
+    rooms_[room.id] = RoomEntry{room, validators, Clock::now()};
+}
+
+
+// --- Invalidation ---
+
+void RoomCache::invalidateAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    rooms_.clear();
+    list_order_.clear();
+    list_valid_ = false;
+    list_validators_ = Validators{};
+}
+
+void RoomCache::invalidateList() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    list_valid_ = false;
+    list_validators_ = Validators{};
+}
+
+void RoomCache::invalidateRoom(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    generation_++;
+    rooms_.erase(id);
+    list_valid_ = false; // The list ETag no longer matches what we hold
+    list_validators_ = Validators{};
+}
+
+RoomCache::Stats RoomCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
@@ -0,0 +1,95 @@
+// src/RoomCache.h
+#ifndef ROOM_CACHE_H
+#define ROOM_CACHE_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "DataStructures.h"
+
+// --- RoomCache ---
+// Client-side copy of the room catalog, keyed by room id.
+// Entries are served directly while younger than the TTL. After that the client
+// revalidates with If-None-Match / If-Modified-Since and, on a 304, simply
+// refreshes the timestamp here without touching the JSON parser.
+class RoomCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // HTTP validators returned by the server for a cached response
+    struct Validators {
+        std::string etag;         // ETag header
+        std::string lastModified; // Last-Modified header
+        bool empty() const { return etag.empty() && lastModified.empty(); }
+    };
+
+    struct Stats {
+        uint64_t hits = 0;        // served without any request
+        uint64_t revalidated = 0; // 304 Not Modified, cached copy reused
+        uint64_t misses = 0;      // full download and parse
+    };
+
+    explicit RoomCache(std::chrono::seconds ttl = std::chrono::seconds(60));
+
+    void setTtl(std::chrono::seconds ttl);
+
+    // Generation changes on every invalidation; pass the value read before a request
+    // to store*() so a response that raced with a write is not cached.
+    uint64_t generation() const;
+
+    // --- Full catalog (/rooms) ---
+    std::optional<std::vector<Room>> freshList();            // within TTL
+    Validators listValidators() const;                       // for a conditional GET
+    std::optional<std::vector<Room>> revalidateList();       // after a 304
+    void storeList(const std::vector<Room>& rooms, const Validators& validators, uint64_t generation);
+
+    // --- Single room (/rooms/{id}) ---
+    std::optional<Room> freshRoom(int id);
+    Validators roomValidators(int id) const;
+    std::optional<Room> revalidateRoom(int id);
+    void storeRoom(const Room& room, const Validators& validators, uint64_t generation);
+
+    // --- Snapshots (SnapshotFile.h) ---
+    struct Catalog {
+        std::vector<Room> rooms; // In /rooms order
+        Validators validators;
+    };
+    std::optional<Catalog> catalog() const; // Last full catalog, however old
+    // A catalog saved by an earlier run: served as stale, so the next getRooms
+    // revalidates it (usually a 304) instead of downloading it again
+    void seedList(const Catalog& catalog);
+
+    // --- Invalidation (after create/update/delete through the client) ---
+    void invalidateAll();
+    void invalidateList();       // Catalog membership changed (e.g. a room was created)
+    void invalidateRoom(int id); // Drops the room and the list it belongs to
+
+    Stats stats() const;
+
+private:
+    struct RoomEntry {
+        Room room;
+        Validators validators;    // only set when fetched via /rooms/{id}
+        Clock::time_point fetchedAt;
+    };
+
+    bool isFresh(Clock::time_point fetchedAt) const;
+
+    mutable std::mutex mutex_;
+    Clock::duration ttl_;
+    uint64_t generation_ = 0;
+
+    std::unordered_map<int, RoomEntry> rooms_;
+    std::vector<int> list_order_;  // ids in /rooms order
+    bool list_valid_ = false;
+    Validators list_validators_;
+    Clock::time_point list_fetched_at_;
+
+    Stats stats_;
+};
+
+#endif // ROOM_CACHE_H
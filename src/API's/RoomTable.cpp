@@ -0,0 +1,218 @@
+// src/RoomTable.cpp
+#include "RoomTable.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define ROOM_TABLE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROOM_TABLE_SSE2 1
+#endif
+
+namespace {
+
+// Append base + i for every set bit i of a block's match mask
+inline void appendMatches(uint32_t bits, uint32_t base, std::vector<uint32_t>& out) {
+    for (uint32_t i = 0; bits; ++i, bits >>= 1) {
+        if (bits & 1) out.push_back(base + i);
+    }
+}
+
+// Float bits as an unsigned key with the same order as the floats
+inline uint32_t orderedBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+} // namespace
+
+// --- Building ---
+
+void RoomTable::build(const std::vector<Room>& rooms) {
+    size_t n = rooms.size();
+    ids_.resize(n);
+    prices_.resize(n);
+    capacities_.resize(n);
+    types_.resize(n);
+    views_.resize(n);
+    amenity_masks_.resize(n);
+    flags_.resize(n);
+    overflow_amenities_.clear();
+
+    for (size_t row = 0; row < n; ++row) {
+        const Room& room = rooms[row];
+        ids_[row] = room.id;
+        prices_[row] = static_cast<float>(room.price);
+        capacities_[row] = room.capacity;
+        types_[row] = static_cast<int32_t>(room.type.id());
+        views_[row] = static_cast<int32_t>(room.view.id());
+        amenity_masks_[row] = room.amenities.mask();
+        int32_t flags = room.available ? kAvailable : 0;
+        if (room.amenities.hasOverflow()) {
+            flags |= kAmenityOverflow;
+            overflow_amenities_[static_cast<uint32_t>(row)] = room.amenities;
+        }
+        flags_[row] = flags;
+    }
+}
+
+// --- Filtering ---
+
+std::vector<uint32_t> RoomTable::filter(const Query& query) const {
+    Predicate p;
+    p.minPrice = query.minPrice;
+    p.maxPrice = query.maxPrice;
+    p.minCapacity = std::max(query.minCapacity, std::numeric_limits<int32_t>::min() + 1);
+    p.type = query.type.empty() ? -1 : static_cast<int32_t>(query.type.id());
+    p.view = query.view.empty() ? -1 : static_cast<int32_t>(query.view.id());
+    p.amenityMask = query.amenities.mask();
+    p.requiredFlags = (query.availableOnly ? kAvailable : 0) |
+                      (query.amenities.hasOverflow() ? kAmenityOverflow : 0);
+
+    std::vector<uint32_t> rows;
+    size_t tail = filterSimd(p, rows);
+    filterScalar(p, tail, size(), rows);
+
+    // Rare case: amenities outside the mask need the full set
+    if (query.amenities.hasOverflow()) {
+        rows.erase(std::remove_if(rows.begin(), rows.end(), [&](uint32_t row) {
+            return !overflow_amenities_.at(row).containsAll(query.amenities);
+        }), rows.end());
+    }
+    return rows;
+}
+
+void RoomTable::filterScalar(const Predicate& p, size_t begin, size_t end, std::vector<uint32_t>& out) const {
+    for (size_t row = begin; row < end; ++row) {
+        bool keep = prices_[row] >= p.minPrice && prices_[row] <= p.maxPrice &&
+                    capacities_[row] >= p.minCapacity &&
+                    (p.type < 0 || types_[row] == p.type) &&
+                    (p.view < 0 || views_[row] == p.view) &&
+                    (amenity_masks_[row] & p.amenityMask) == p.amenityMask &&
+                    (flags_[row] & p.requiredFlags) == p.requiredFlags;
+        if (keep) out.push_back(static_cast<uint32_t>(row));
+    }
+}
+
+#if defined(ROOM_TABLE_AVX2)
+
+size_t RoomTable::filterSimd(const Predicate& p, std::vector<uint32_t>& out) const {
+    const size_t blocks = size() / 8 * 8;
+    const __m256 minPrice = _mm256_set1_ps(p.minPrice);
+    const __m256 maxPrice = _mm256_set1_ps(p.maxPrice);
+    const __m256i capacityFloor = _mm256_set1_epi32(p.minCapacity - 1);
+    const __m256i type = _mm256_set1_epi32(p.type);
+    const __m256i view = _mm256_set1_epi32(p.view);
+    const __m256i flags = _mm256_set1_epi32(p.requiredFlags);
+    const __m256i amenities = _mm256_set1_epi64x(static_cast<long long>(p.amenityMask));
+
+    for (size_t row = 0; row < blocks; row += 8) {
+        __m256 price = _mm256_loadu_ps(&prices_[row]);
+        __m256i keep = _mm256_castps_si256(_mm256_and_ps(_mm256_cmp_ps(price, minPrice, _CMP_GE_OQ),
+                                                         _mm256_cmp_ps(price, maxPrice, _CMP_LE_OQ)));
+        __m256i capacity = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&capacities_[row]));
+        keep = _mm256_and_si256(keep, _mm256_cmpgt_epi32(capacity, capacityFloor));
+        if (p.type >= 0) {
+            __m256i types = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&types_[row]));
+            keep = _mm256_and_si256(keep, _mm256_cmpeq_epi32(types, type));
+        }
+        if (p.view >= 0) {
+            __m256i views = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&views_[row]));
+            keep = _mm256_and_si256(keep, _mm256_cmpeq_epi32(views, view));
+        }
+        __m256i rowFlags = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&flags_[row]));
+        keep = _mm256_and_si256(keep, _mm256_cmpeq_epi32(_mm256_and_si256(rowFlags, flags), flags));
+
+        uint32_t bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(keep)));
+        if (bits && p.amenityMask) {
+            // Four 64-bit masks per register: two loads cover the eight rows
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&amenity_masks_[row]));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&amenity_masks_[row + 4]));
+            __m256i lowOk = _mm256_cmpeq_epi64(_mm256_and_si256(low, amenities), amenities);
+            __m256i highOk = _mm256_cmpeq_epi64(_mm256_and_si256(high, amenities), amenities);
+            bits &= static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(lowOk))) |
+                    static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(highOk))) << 4;
+        }
+        appendMatches(bits, static_cast<uint32_t>(row), out);
+    }
+    return blocks;
+}
+
+#elif defined(ROOM_TABLE_SSE2)
+
+size_t RoomTable::filterSimd(const Predicate& p, std::vector<uint32_t>& out) const {
+    const size_t blocks = size() / 4 * 4;
+    const __m128 minPrice = _mm_set1_ps(p.minPrice);
+    const __m128 maxPrice = _mm_set1_ps(p.maxPrice);
+    const __m128i capacityFloor = _mm_set1_epi32(p.minCapacity - 1);
+    const __m128i type = _mm_set1_epi32(p.type);
+    const __m128i view = _mm_set1_epi32(p.view);
+    const __m128i flags = _mm_set1_epi32(p.requiredFlags);
+    const __m128i amenities = _mm_set1_epi64x(static_cast<long long>(p.amenityMask));
+
+    // SSE2 has no 64-bit compare: compare 32-bit halves and AND each pair
+    auto amenityBits = [&](const uint64_t* masks) {
+        __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks));
+        __m128i equal = _mm_cmpeq_epi32(_mm_and_si128(halves, amenities), amenities);
+        equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(equal)));
+    };
+
+    for (size_t row = 0; row < blocks; row += 4) {
+        __m128 price = _mm_loadu_ps(&prices_[row]);
+        __m128i keep = _mm_castps_si128(_mm_and_ps(_mm_cmpge_ps(price, minPrice), _mm_cmple_ps(price, maxPrice)));
+        __m128i capacity = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&capacities_[row]));
+        keep = _mm_and_si128(keep, _mm_cmpgt_epi32(capacity, capacityFloor));
+        if (p.type >= 0) {
+            __m128i types = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&types_[row]));
+            keep = _mm_and_si128(keep, _mm_cmpeq_epi32(types, type));
+        }
+        if (p.view >= 0) {
+            __m128i views = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&views_[row]));
+            keep = _mm_and_si128(keep, _mm_cmpeq_epi32(views, view));
+        }
+        __m128i rowFlags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&flags_[row]));
+        keep = _mm_and_si128(keep, _mm_cmpeq_epi32(_mm_and_si128(rowFlags, flags), flags));
+
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(keep)));
+        if (bits && p.amenityMask) {
+            bits &= amenityBits(&amenity_masks_[row]) | amenityBits(&amenity_masks_[row + 2]) << 2;
+        }
+        appendMatches(bits, static_cast<uint32_t>(row), out);
+    }
+    return blocks;
+}
+
+#else
+
+size_t RoomTable::filterSimd(const Predicate&, std::vector<uint32_t>&) const {
+    return 0; // No vector unit: filterScalar handles every row
+}
+
+#endif
+
+// --- Ordering ---
+
+std::vector<uint32_t> RoomTable::topKByPrice(const std::vector<uint32_t>& rows, size_t k, bool cheapestFirst) const {
+    // Price and row packed into one integer key, so selection is a plain integer sort
+    std::vector<uint64_t> keys(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        uint32_t price = orderedBits(prices_[rows[i]]);
+        if (!cheapestFirst) price = ~price;
+        keys[i] = static_cast<uint64_t>(price) << 32 | rows[i];
+    }
+
+    k = std::min(k, keys.size());
+    if (k < keys.size()) {
+        std::nth_element(keys.begin(), keys.begin() + static_cast<ptrdiff_t>(k), keys.end());
+        keys.resize(k);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<uint32_t> result(k);
+    for (size_t i = 0; i < k; ++i) result[i] = static_cast<uint32_t>(keys[i]);
+    return result;
+}
@@ -0,0 +1,66 @@
+// src/SingleFlight.h
+#ifndef SINGLE_FLIGHT_H
+#define SINGLE_FLIGHT_H
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// --- SingleFlight ---
+// Collapses concurrent calls with the same key into one. The first caller for
+// a key runs the work; callers arriving while it is in flight wait for it and
+// get the same result (or exception) instead of repeating the request and the
+// decode. Nothing is cached: once the call finishes the next caller starts a
+// new one. Keys should cover everything the result depends on (method, path,
+// auth scope).
+template <typename T>
+class SingleFlight {
+public:
+    // Result of fn(), shared with any concurrent caller of the same key
+    template <typename F>
+    std::shared_ptr<const T> run(const std::string& key, F&& fn) {
+        std::promise<std::shared_ptr<const T>> promise;
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = calls_.find(key);
+        if (it != calls_.end()) {
+            std::shared_future<std::shared_ptr<const T>> inFlight = it->second;
+            lock.unlock(); // Never wait while holding the map lock
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            return inFlight.get();
+        }
+        calls_.emplace(key, promise.get_future().share());
+        lock.unlock();
+
+        // Leader: run the work, publish it, then retire the key
+        try {
+            auto result = std::make_shared<const T>(fn());
+            finish(key);
+            promise.set_value(result);
+            return result;
+        } catch (...) {
+            finish(key);
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    uint64_t coalesced() const { return coalesced_.load(std::memory_order_relaxed); } // Callers that shared a call
+
+private:
+    void finish(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.erase(key);
+    }
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<const T>>> calls_;
+    std::atomic<uint64_t> coalesced_{0};
+};
+
+#endif // SINGLE_FLIGHT_H
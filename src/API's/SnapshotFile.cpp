@@ -0,0 +1,376 @@
+// src/SnapshotFile.cpp
+#include "SnapshotFile.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <type_traits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// --- On-disk layout ---
+
+namespace {
+
+constexpr char kMagic[8] = {'H', 'O', 'T', 'E', 'L', 'S', 'N', 'P'};
+constexpr uint32_t kByteOrderMark = 0x01020304; // Reads differently on a machine of the other endianness
+
+struct StringRef {
+    uint32_t offset = 0; // Into the string pool
+    uint32_t size = 0;
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t headerBytes;        // sizeof(Header), RoomRecord and BookingRecord as written,
+    uint32_t roomRecordBytes;    // so a layout change without a version bump is still caught
+    uint32_t bookingRecordBytes;
+    int32_t bookingsUserId;
+    int64_t savedAt;             // Unix seconds
+    uint64_t fileBytes;
+    uint64_t roomsOffset;
+    uint64_t roomCount;
+    uint64_t bookingsOffset;
+    uint64_t bookingCount;
+    uint64_t stringsOffset;
+    uint64_t stringsBytes;
+    StringRef etag;
+    StringRef lastModified;
+};
+
+struct RoomRecord {
+    int32_t id;
+    int32_t capacity;
+    double price;
+    StringRef name, type, bedSize, view, description, image, amenities;
+    uint8_t available;
+    uint8_t reserved[7];
+};
+
+struct BookingRecord {
+    int32_t id;
+    int32_t userId;
+    int32_t roomId;
+    int32_t guests;
+    int32_t checkInDays;         // Date::days(), unset included
+    int32_t checkOutDays;
+    int32_t housekeepingSeconds; // TimeOfDay::secondsOfDay(), -1 when unset
+    uint8_t housekeeping;
+    uint8_t parking;
+    uint8_t reserved[2];
+    double totalPrice;
+    StringRef status, package;
+};
+
+static_assert(std::is_trivially_copyable<Header>::value && std::is_trivially_copyable<RoomRecord>::value &&
+              std::is_trivially_copyable<BookingRecord>::value, "snapshot records are copied as raw bytes");
+static_assert(sizeof(RoomRecord) % 8 == 0 && sizeof(BookingRecord) % 8 == 0 && sizeof(Header) % 8 == 0,
+              "records must keep the sections 8-byte aligned");
+
+// Records are memcpy'd out rather than cast in place: no alignment or aliasing assumptions
+template <typename T>
+T readAt(const char* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void appendRaw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+class StringPool {
+public:
+    StringRef add(std::string_view text) {
+        StringRef ref{static_cast<uint32_t>(bytes_.size()), static_cast<uint32_t>(text.size())};
+        bytes_.append(text.data(), text.size());
+        return ref;
+    }
+    const std::string& bytes() const { return bytes_; }
+
+private:
+    std::string bytes_;
+};
+
+bool sectionFits(uint64_t offset, uint64_t count, uint64_t recordBytes, uint64_t fileBytes) {
+    return offset <= fileBytes && count <= (fileBytes - offset) / recordBytes;
+}
+
+} // namespace
+
+// --- Writing ---
+
+bool SnapshotFile::write(const std::string& path, const Contents& contents) {
+    StringPool strings;
+    std::string records;
+    records.reserve(contents.rooms.size() * sizeof(RoomRecord) + contents.bookings.size() * sizeof(BookingRecord));
+
+    for (const Room& room : contents.rooms) {
+        RoomRecord record{};
+        record.id = room.id;
+        record.capacity = room.capacity;
+        record.price = room.price;
+        record.name = strings.add(room.name);
+        record.type = strings.add(room.type.str());
+        record.bedSize = strings.add(room.bedSize.str());
+        record.view = strings.add(room.view.str());
+        record.description = strings.add(room.description);
+        record.image = strings.add(room.image);
+        std::string amenities;
+        for (Symbol amenity : room.amenities.symbols()) {
+            if (!amenities.empty()) amenities += '\n';
+            amenities += amenity.str();
+        }
+        record.amenities = strings.add(amenities);
+        record.available = room.available ? 1 : 0;
+        appendRaw(records, record);
+    }
+    for (const Booking& booking : contents.bookings) {
+        BookingRecord record{};
+        record.id = booking.id;
+        record.userId = booking.userId;
+        record.roomId = booking.roomId;
+        record.guests = booking.guests;
+        record.checkInDays = booking.checkIn.days();
+        record.checkOutDays = booking.checkOut.days();
+        record.housekeepingSeconds = booking.housekeepingTime.secondsOfDay();
+        record.housekeeping = booking.housekeeping ? 1 : 0;
+        record.parking = booking.parking ? 1 : 0;
+        record.totalPrice = booking.totalPrice;
+        record.status = strings.add(booking.status);
+        record.package = strings.add(booking.package);
+        appendRaw(records, record);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrderMark;
+    header.headerBytes = sizeof(Header);
+    header.roomRecordBytes = sizeof(RoomRecord);
+    header.bookingRecordBytes = sizeof(BookingRecord);
+    header.bookingsUserId = contents.bookingsUserId;
+    header.savedAt = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.etag = strings.add(contents.roomValidators.etag);
+    header.lastModified = strings.add(contents.roomValidators.lastModified);
+    header.roomsOffset = sizeof(Header);
+    header.roomCount = contents.rooms.size();
+    header.bookingsOffset = header.roomsOffset + header.roomCount * sizeof(RoomRecord);
+    header.bookingCount = contents.bookings.size();
+    header.stringsOffset = sizeof(Header) + records.size();
+    header.stringsBytes = strings.bytes().size();
+    header.fileBytes = header.stringsOffset + header.stringsBytes;
+    if (strings.bytes().size() > UINT32_MAX) {
+        LOG_ERROR("[Snapshot] Too much text to save a snapshot");
+        return false;
+    }
+
+    // Readers either see the old file or the complete new one
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        out.write(records.data(), static_cast<std::streamsize>(records.size()));
+        out.write(strings.bytes().data(), static_cast<std::streamsize>(strings.bytes().size()));
+        if (!out.flush()) {
+            LOG_ERROR("[Snapshot] Could not write " << temp);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        LOG_ERROR("[Snapshot] Could not replace " << path << ": " << ec.message());
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+// --- Reading ---
+
+bool SnapshotFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize{};
+    void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && static_cast<uint64_t>(fileSize.QuadPart) >= sizeof(Header)) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // The view keeps the mapping alive
+        }
+    }
+    CloseHandle(file);
+    if (!view) return false;
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info{};
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<uint64_t>(info.st_size) >= sizeof(Header)) {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd); // The mapping stays valid without the descriptor
+    if (view == MAP_FAILED) return false;
+    data_ = static_cast<const char*>(view);
+    size_ = static_cast<size_t>(info.st_size);
+#endif
+
+    Header header = readAt<Header>(data_, 0);
+    const char* problem = nullptr;
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) problem = "not a snapshot file";
+    else if (header.version != kVersion) problem = "written by another client version";
+    else if (header.byteOrder != kByteOrderMark || header.headerBytes != sizeof(Header) ||
+             header.roomRecordBytes != sizeof(RoomRecord) || header.bookingRecordBytes != sizeof(BookingRecord)) {
+        problem = "written on an incompatible platform";
+    } else if (header.fileBytes != size_ ||
+               !sectionFits(header.roomsOffset, header.roomCount, sizeof(RoomRecord), size_) ||
+               !sectionFits(header.bookingsOffset, header.bookingCount, sizeof(BookingRecord), size_) ||
+               header.stringsOffset > size_ || header.stringsBytes > size_ - header.stringsOffset) {
+        problem = "truncated or damaged";
+    }
+    if (problem) {
+        LOG_INFO("[Snapshot] Ignoring " << path << ": " << problem);
+        close();
+        return false;
+    }
+    rooms_offset_ = static_cast<size_t>(header.roomsOffset);
+    room_count_ = static_cast<size_t>(header.roomCount);
+    bookings_offset_ = static_cast<size_t>(header.bookingsOffset);
+    booking_count_ = static_cast<size_t>(header.bookingCount);
+    strings_offset_ = static_cast<size_t>(header.stringsOffset);
+    strings_size_ = static_cast<size_t>(header.stringsBytes);
+    return true;
+}
+
+void SnapshotFile::close() {
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+#else
+    munmap(const_cast<char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    room_count_ = booking_count_ = 0;
+}
+
+std::string_view SnapshotFile::text(uint32_t offset, uint32_t size) const {
+    if (offset > strings_size_ || size > strings_size_ - offset) return {};
+    return std::string_view(data_ + strings_offset_ + offset, size);
+}
+
+std::chrono::system_clock::time_point SnapshotFile::savedAt() const {
+    if (!data_) return {};
+    return std::chrono::system_clock::time_point(std::chrono::seconds(readAt<Header>(data_, 0).savedAt));
+}
+
+size_t SnapshotFile::roomCount() const {
+    return room_count_;
+}
+
+size_t SnapshotFile::bookingCount() const {
+    return booking_count_;
+}
+
+int SnapshotFile::bookingsUserId() const {
+    return data_ ? readAt<Header>(data_, 0).bookingsUserId : 0;
+}
+
+RoomCache::Validators SnapshotFile::roomValidators() const {
+    RoomCache::Validators validators;
+    if (!data_) return validators;
+    Header header = readAt<Header>(data_, 0);
+    validators.etag = std::string(text(header.etag.offset, header.etag.size));
+    validators.lastModified = std::string(text(header.lastModified.offset, header.lastModified.size));
+    return validators;
+}
+
+SnapshotFile::RoomView SnapshotFile::room(size_t index) const {
+    RoomRecord record = readAt<RoomRecord>(data_, rooms_offset_ + index * sizeof(RoomRecord));
+    RoomView view;
+    view.id = record.id;
+    view.price = record.price;
+    view.capacity = record.capacity;
+    view.available = record.available != 0;
+    view.name = text(record.name.offset, record.name.size);
+    view.type = text(record.type.offset, record.type.size);
+    view.bedSize = text(record.bedSize.offset, record.bedSize.size);
+    view.view = text(record.view.offset, record.view.size);
+    view.description = text(record.description.offset, record.description.size);
+    view.image = text(record.image.offset, record.image.size);
+    view.amenities = text(record.amenities.offset, record.amenities.size);
+    return view;
+}
+
+Booking SnapshotFile::booking(size_t index) const {
+    BookingRecord record = readAt<BookingRecord>(data_, bookings_offset_ + index * sizeof(BookingRecord));
+    Booking booking;
+    booking.id = record.id;
+    booking.userId = record.userId;
+    booking.roomId = record.roomId;
+    booking.guests = record.guests;
+    booking.checkIn = Date::fromDays(record.checkInDays);
+    booking.checkOut = Date::fromDays(record.checkOutDays);
+    booking.housekeepingTime = TimeOfDay::fromSeconds(record.housekeepingSeconds);
+    booking.housekeeping = record.housekeeping != 0;
+    booking.parking = record.parking != 0;
+    booking.totalPrice = record.totalPrice;
+    booking.status = std::string(text(record.status.offset, record.status.size));
+    booking.package = std::string(text(record.package.offset, record.package.size));
+    return booking;
+}
+
+std::vector<Room> SnapshotFile::rooms() const {
+    std::vector<Room> rooms;
+    rooms.reserve(room_count_);
+    for (size_t i = 0; i < room_count_; ++i) {
+        RoomView view = room(i);
+        Room& room = rooms.emplace_back();
+        room.id = view.id;
+        room.name = std::string(view.name);
+        room.type = Symbol(view.type);
+        room.price = view.price;
+        room.bedSize = Symbol(view.bedSize);
+        room.view = Symbol(view.view);
+        room.capacity = view.capacity;
+        room.description = std::string(view.description);
+        room.image = std::string(view.image);
+        room.available = view.available;
+        std::string_view amenities = view.amenities;
+        while (!amenities.empty()) {
+            size_t end = std::min(amenities.find('\n'), amenities.size());
+            room.amenities.insert(amenities.substr(0, end));
+            amenities.remove_prefix(std::min(end + 1, amenities.size()));
+        }
+    }
+    return rooms;
+}
+
+std::vector<Booking> SnapshotFile::bookings() const {
+    std::vector<Booking> bookings;
+    bookings.reserve(booking_count_);
+    for (size_t i = 0; i < booking_count_; ++i) bookings.push_back(booking(i));
+    return bookings;
+}
@@ -0,0 +1,82 @@
+// src/SnapshotFile.h
+#ifndef SNAPSHOT_FILE_H
+#define SNAPSHOT_FILE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "DataStructures.h"
+#include "RoomCache.h"
+
+// --- SnapshotFile ---
+// Room catalog and the logged-in user's recent bookings, saved between runs so
+// the client has something to show before its first request. The file is a
+// header, fixed-size room and booking records and one string pool; it is
+// memory-mapped and read in place, so opening it costs no parsing at all.
+//
+// Layout (native byte order, checked on open):
+//   Header | RoomRecord[roomCount] | BookingRecord[bookingCount] | strings
+// Records refer to text as (offset, size) into the string pool. Any change to
+// the layout bumps kVersion; files of another version are ignored, not migrated.
+class SnapshotFile {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    struct Contents {
+        std::vector<Room> rooms;                 // In /rooms order
+        RoomCache::Validators roomValidators;    // For revalidating the catalog
+        int bookingsUserId = 0;                  // Whose bookings these are (0 = none saved)
+        std::vector<Booking> bookings;
+    };
+
+    // One room's fields, pointing into the mapping (valid while the file is open)
+    struct RoomView {
+        int id = 0;
+        double price = 0.0;
+        int capacity = 0;
+        bool available = false;
+        std::string_view name, type, bedSize, view, description, image;
+        std::string_view amenities; // Names separated by '\n'
+    };
+
+    // Writes a new snapshot next to `path` and renames it into place
+    static bool write(const std::string& path, const Contents& contents);
+
+    SnapshotFile() = default;
+    ~SnapshotFile() { close(); }
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    // Maps the file and checks its header; false if missing, another version or damaged
+    bool open(const std::string& path);
+    void close(); // Required before write() replaces the same file on Windows
+    bool isOpen() const { return data_ != nullptr; }
+
+    std::chrono::system_clock::time_point savedAt() const;
+    size_t roomCount() const;
+    size_t bookingCount() const;
+    int bookingsUserId() const;
+
+    RoomView room(size_t index) const;
+    Booking booking(size_t index) const;
+    RoomCache::Validators roomValidators() const;
+
+    // Everything, copied out of the mapping (symbols interned, strings owned)
+    std::vector<Room> rooms() const;
+    std::vector<Booking> bookings() const;
+
+private:
+    std::string_view text(uint32_t offset, uint32_t size) const; // Empty if outside the string pool
+
+    const char* data_ = nullptr; // Read-only mapping of the whole file
+    size_t size_ = 0;
+    // Section positions, copied from the header by open()
+    size_t rooms_offset_ = 0, room_count_ = 0;
+    size_t bookings_offset_ = 0, booking_count_ = 0;
+    size_t strings_offset_ = 0, strings_size_ = 0;
+};
+
+#endif // SNAPSHOT_FILE_H
@@ -0,0 +1,159 @@
+// src/Symbol.cpp
+#include "Symbol.h"
+#include <algorithm>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+
+// --- SymbolTable ---
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolTable::SymbolTable() {
+    for (auto& id : amenity_ids_) id.store(kNotFound, std::memory_order_relaxed);
+    intern(""); // Id 0: the empty string, what a default Symbol names
+}
+
+SymbolTable::~SymbolTable() {
+    for (auto& chunk : chunks_) delete[] chunk.load(std::memory_order_relaxed);
+}
+
+uint32_t SymbolTable::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(text);
+        if (it != ids_.end()) return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(text); // Another thread may have added it meanwhile
+    if (it != ids_.end()) return it->second;
+
+    uint32_t id = count_.load(std::memory_order_relaxed);
+    uint32_t chunkIndex = id >> kChunkBits;
+    if (chunkIndex >= kMaxChunks) throw std::length_error("SymbolTable is full");
+    Entry* chunk = chunks_[chunkIndex].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new Entry[kChunkSize];
+        chunks_[chunkIndex].store(chunk, std::memory_order_release);
+    }
+    Entry& slot = chunk[id & (kChunkSize - 1)];
+    slot.text.assign(text.data(), text.size());
+    ids_.emplace(std::string_view(slot.text), id);
+    count_.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+uint32_t SymbolTable::find(std::string_view text) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(text);
+    return it == ids_.end() ? kNotFound : it->second;
+}
+
+const std::string& SymbolTable::text(uint32_t id) const {
+    return entry(id).text;
+}
+
+int SymbolTable::amenityBit(uint32_t id) {
+    int bit = findAmenityBit(id);
+    if (bit >= 0 || amenity_bits_used_.load(std::memory_order_relaxed) >= kAmenityBits) return bit;
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    Entry& slot = const_cast<Entry&>(entry(id));
+    bit = slot.amenityBit.load(std::memory_order_relaxed);
+    if (bit >= 0 || amenity_bits_used_.load(std::memory_order_relaxed) >= kAmenityBits) return bit;
+    bit = amenity_bits_used_.fetch_add(1, std::memory_order_relaxed);
+    amenity_ids_[static_cast<size_t>(bit)].store(id, std::memory_order_release);
+    slot.amenityBit.store(bit, std::memory_order_release);
+    return bit;
+}
+
+// --- Symbol ---
+
+Symbol Symbol::existing(std::string_view text) {
+    uint32_t id = SymbolTable::instance().find(text);
+    return id == SymbolTable::kNotFound ? Symbol() : fromId(id);
+}
+
+// --- AmenitySet ---
+
+void AmenitySet::insert(Symbol amenity) {
+    if (amenity.empty()) return;
+    int bit = SymbolTable::instance().amenityBit(amenity.id());
+    if (bit >= 0) {
+        bits_ |= uint64_t{1} << bit;
+        return;
+    }
+    auto pos = std::lower_bound(overflow_.begin(), overflow_.end(), amenity,
+                                [](Symbol a, Symbol b) { return a.id() < b.id(); });
+    if (pos == overflow_.end() || *pos != amenity) overflow_.insert(pos, amenity);
+}
+
+bool AmenitySet::contains(Symbol amenity) const {
+    int bit = SymbolTable::instance().findAmenityBit(amenity.id());
+    if (bit >= 0) return (bits_ >> bit) & 1;
+    return std::binary_search(overflow_.begin(), overflow_.end(), amenity,
+                              [](Symbol a, Symbol b) { return a.id() < b.id(); });
+}
+
+bool AmenitySet::containsAll(const AmenitySet& required) const {
+    if ((bits_ & required.bits_) != required.bits_) return false;
+    for (Symbol amenity : required.overflow_) {
+        if (!contains(amenity)) return false;
+    }
+    return true;
+}
+
+size_t AmenitySet::size() const {
+    size_t count = overflow_.size();
+    for (uint64_t bits = bits_; bits; bits &= bits - 1) ++count;
+    return count;
+}
+
+std::vector<Symbol> AmenitySet::symbols() const {
+    std::vector<Symbol> result;
+    result.reserve(size());
+    const SymbolTable& table = SymbolTable::instance();
+    for (int bit = 0; bit < SymbolTable::kAmenityBits; ++bit) {
+        if ((bits_ >> bit) & 1) result.push_back(Symbol::fromId(table.amenityAtBit(bit)));
+    }
+    result.insert(result.end(), overflow_.begin(), overflow_.end());
+    return result;
+}
+
+// --- Streams & JSON ---
+
+std::ostream& operator<<(std::ostream& out, const Symbol& symbol) {
+    return out << symbol.str();
+}
+
+std::ostream& operator<<(std::ostream& out, const AmenitySet& amenities) {
+    const char* separator = "";
+    for (Symbol amenity : amenities.symbols()) {
+        out << separator << amenity.str();
+        separator = ", ";
+    }
+    return out;
+}
+
+void to_json(nlohmann::json& j, const Symbol& symbol) {
+    j = symbol.str();
+}
+
+void from_json(const nlohmann::json& j, Symbol& symbol) {
+    symbol = j.is_null() ? Symbol() : Symbol(j.get_ref<const std::string&>());
+}
+
+void to_json(nlohmann::json& j, const AmenitySet& amenities) {
+    j = nlohmann::json::array();
+    for (Symbol amenity : amenities.symbols()) j.push_back(amenity.str());
+}
+
+void from_json(const nlohmann::json& j, AmenitySet& amenities) {
+    amenities.clear();
+    if (j.is_null()) return;
+    for (const auto& element : j) amenities.insert(std::string_view(element.get_ref<const std::string&>()));
+}
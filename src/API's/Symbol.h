@@ -0,0 +1,136 @@
+// src/Symbol.h
+#ifndef SYMBOL_H
+#define SYMBOL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// --- SymbolTable ---
+// Process-wide intern pool for categorical strings (room types, views, bed
+// sizes, amenities). Each distinct string is stored once and named by a small
+// integer id. Looking up the text for an id takes no lock; interning takes a
+// shared lock, or an exclusive one the first time a string is seen.
+// The first 64 distinct amenity names also get a bit for AmenitySet masks.
+class SymbolTable {
+public:
+    static constexpr uint32_t kNotFound = UINT32_MAX;
+    static constexpr int kAmenityBits = 64;
+
+    static SymbolTable& instance();
+
+    uint32_t intern(std::string_view text);
+    uint32_t find(std::string_view text) const; // kNotFound if never interned
+    const std::string& text(uint32_t id) const;
+    size_t size() const { return count_.load(std::memory_order_acquire); }
+
+    // Bit of an amenity symbol in AmenitySet masks: assigned on first use, -1 once all 64 are taken
+    int amenityBit(uint32_t id);
+    int findAmenityBit(uint32_t id) const { return entry(id).amenityBit.load(std::memory_order_acquire); }
+    uint32_t amenityAtBit(int bit) const { return amenity_ids_[static_cast<size_t>(bit)].load(std::memory_order_acquire); }
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+private:
+    SymbolTable();
+    ~SymbolTable();
+
+    struct Entry {
+        std::string text;
+        std::atomic<int> amenityBit{-1};
+    };
+
+    static constexpr uint32_t kChunkBits = 10;
+    static constexpr uint32_t kChunkSize = 1u << kChunkBits; // Entries per chunk, never moved
+    static constexpr uint32_t kMaxChunks = 4096;             // Up to ~4M symbols
+
+    const Entry& entry(uint32_t id) const {
+        return chunks_[id >> kChunkBits].load(std::memory_order_acquire)[id & (kChunkSize - 1)];
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, uint32_t> ids_; // Views into the chunk storage
+    std::array<std::atomic<Entry*>, kMaxChunks> chunks_{};
+    std::atomic<uint32_t> count_{0};
+    std::array<std::atomic<uint32_t>, kAmenityBits> amenity_ids_{};
+    std::atomic<int> amenity_bits_used_{0};
+};
+
+// --- Symbol ---
+// 4-byte handle to an interned string. Equality is an integer compare; the
+// default Symbol is the empty string.
+class Symbol {
+public:
+    Symbol() = default;
+    explicit Symbol(std::string_view text) : id_(SymbolTable::instance().intern(text)) {}
+
+    // Symbol for text that has been seen before, without interning it; empty if it never was
+    static Symbol existing(std::string_view text);
+    // Symbol for an id handed out by SymbolTable
+    static Symbol fromId(uint32_t id) {
+        Symbol symbol;
+        symbol.id_ = id;
+        return symbol;
+    }
+
+    uint32_t id() const { return id_; }
+    bool empty() const { return id_ == 0; }
+    const std::string& str() const { return SymbolTable::instance().text(id_); }
+
+    friend bool operator==(Symbol a, Symbol b) { return a.id_ == b.id_; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.id_ != b.id_; }
+    friend bool operator==(Symbol a, std::string_view b) { return a.str() == b; }
+    friend bool operator!=(Symbol a, std::string_view b) { return a.str() != b; }
+
+private:
+    uint32_t id_ = 0;
+};
+
+// --- AmenitySet ---
+// Set of amenity symbols as a 64-bit mask, with a sorted overflow list for
+// names beyond the first 64 distinct ones. "Has WiFi and Minibar" is a mask
+// test when both are in the mask. Iteration order is bit order, not the
+// order the server listed them.
+class AmenitySet {
+public:
+    void insert(Symbol amenity);
+    void insert(std::string_view name) { insert(Symbol(name)); }
+    void clear() { bits_ = 0; overflow_.clear(); }
+
+    bool contains(Symbol amenity) const;
+    bool containsAll(const AmenitySet& required) const;
+
+    uint64_t mask() const { return bits_; }
+    bool hasOverflow() const { return !overflow_.empty(); }
+    bool empty() const { return bits_ == 0 && overflow_.empty(); }
+    size_t size() const;
+
+    std::vector<Symbol> symbols() const;
+
+    friend bool operator==(const AmenitySet& a, const AmenitySet& b) { return a.bits_ == b.bits_ && a.overflow_ == b.overflow_; }
+    friend bool operator!=(const AmenitySet& a, const AmenitySet& b) { return !(a == b); }
+
+private:
+    uint64_t bits_ = 0;
+    std::vector<Symbol> overflow_; // Sorted by id
+};
+
+std::ostream& operator<<(std::ostream& out, const Symbol& symbol);
+std::ostream& operator<<(std::ostream& out, const AmenitySet& amenities); // "WiFi, TV, ..."
+
+// JSON as before: a Symbol is a string, an AmenitySet an array of strings (null reads as empty)
+void to_json(nlohmann::json& j, const Symbol& symbol);
+void from_json(const nlohmann::json& j, Symbol& symbol);
+void to_json(nlohmann::json& j, const AmenitySet& amenities);
+void from_json(const nlohmann::json& j, AmenitySet& amenities);
+
+#endif // SYMBOL_H
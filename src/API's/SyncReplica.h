@@ -0,0 +1,133 @@
+// src/SyncReplica.h
+#ifndef SYNC_REPLICA_H
+#define SYNC_REPLICA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// --- SyncDiff ---
+// What one sync changed in a replica, by record id (ascending)
+struct SyncDiff {
+    bool ok = false;        // The sync request succeeded and was applied
+    bool reset = false;     // The server sent the whole collection (first sync or expired cursor)
+    std::vector<int> inserted;
+    std::vector<int> updated;
+    std::vector<int> deleted;
+
+    bool empty() const { return inserted.empty() && updated.empty() && deleted.empty(); }
+    size_t size() const { return inserted.size() + updated.size() + deleted.size(); }
+};
+
+// --- SyncReplica ---
+// Local copy of a collection keyed by id, kept current with delta syncs: each
+// sync applies the records changed and the ids deleted since the stored cursor
+// (the server's high-water mark) and moves the cursor forward. A full sync
+// replaces the contents, and the diff is worked out against what was there so
+// callers see the same inserted/updated/deleted lists either way.
+// T needs an `int id` and a nlohmann to_json (used to tell real updates from
+// records re-sent unchanged). Thread-safe.
+template <typename T>
+class SyncReplica {
+public:
+    std::string cursor() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cursor_;
+    }
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+    // Bumped by every sync that changed something: a cheap "anything new?" check
+    uint64_t version() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return version_;
+    }
+    std::optional<T> find(int id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = items_.find(id);
+        if (it == items_.end()) return std::nullopt;
+        return it->second;
+    }
+    std::vector<T> values() const { // In id order
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<T> out;
+        out.reserve(items_.size());
+        for (const auto& entry : items_) out.push_back(entry.second);
+        return out;
+    }
+
+    // Drops everything; the next sync is a full one. Syncs started under
+    // another scope (e.g. a previous user) are ignored from now on.
+    void reset(std::string scope = "") {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!items_.empty()) ++version_;
+        items_.clear();
+        cursor_.clear();
+        scope_ = std::move(scope);
+    }
+
+    // Applies one sync response. Returns a diff with ok = false (and changes
+    // nothing) if `scope` is no longer the replica's.
+    SyncDiff apply(std::vector<T>&& changed, const std::vector<int>& deleted, bool full, std::string cursor,
+                   const std::string& scope = "") {
+        SyncDiff diff;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (scope != scope_) return diff;
+        diff.ok = true;
+        diff.reset = full;
+
+        if (full) {
+            std::map<int, T> previous;
+            previous.swap(items_);
+            for (T& item : changed) {
+                int id = item.id;
+                auto old = previous.find(id);
+                if (old == previous.end()) {
+                    diff.inserted.push_back(id);
+                } else {
+                    if (nlohmann::json(old->second) != nlohmann::json(item)) diff.updated.push_back(id);
+                    previous.erase(old);
+                }
+                items_.insert_or_assign(id, std::move(item));
+            }
+            for (const auto& gone : previous) diff.deleted.push_back(gone.first);
+        } else {
+            for (T& item : changed) {
+                int id = item.id;
+                auto result = items_.insert_or_assign(id, std::move(item));
+                (result.second ? diff.inserted : diff.updated).push_back(id);
+            }
+            for (int id : deleted) {
+                if (items_.erase(id)) diff.deleted.push_back(id);
+            }
+        }
+        sortUnique(diff.inserted);
+        sortUnique(diff.updated);
+        sortUnique(diff.deleted);
+        cursor_ = std::move(cursor);
+        if (!diff.empty()) ++version_;
+        return diff;
+    }
+
+private:
+    static void sortUnique(std::vector<int>& ids) {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    mutable std::mutex mutex_;
+    std::map<int, T> items_;
+    std::string cursor_;     // Empty until the first sync
+    std::string scope_;
+    uint64_t version_ = 0;
+};
+
+#endif // SYNC_REPLICA_H
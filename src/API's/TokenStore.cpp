@@ -0,0 +1,18 @@
+// src/TokenStore.cpp
+#include "TokenStore.h"
+
+TokenStore::TokenStore() : current_(std::make_shared<const AuthSnapshot>()) {}
+
+std::shared_ptr<const AuthSnapshot> TokenStore::publish(const std::string& token, int userId) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    std::shared_ptr<const AuthSnapshot> previous = current_; // Only publishers store, and we hold their lock
+    auto next = std::make_shared<AuthSnapshot>();
+    next->token = token;
+    next->version = previous->version + 1;
+    next->userId = token.empty() ? 0 : userId;
+    next->headers = previous->headers; // Shares the public block
+    next->headers.setToken(token);     // Built here once rather than on every request
+    std::shared_ptr<const AuthSnapshot> published = std::move(next);
+    std::atomic_store_explicit(&current_, published, std::memory_order_release);
+    return published;
+}
@@ -0,0 +1,49 @@
+// src/TokenStore.h
+#ifndef TOKEN_STORE_H
+#define TOKEN_STORE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "RequestBuilder.h" // HeaderBlocks
+
+// --- AuthSnapshot ---
+// One auth token and the default headers built for it. Never modified once
+// published, so any number of threads can read it without synchronisation.
+struct AuthSnapshot {
+    std::string token;   // Empty when logged out
+    uint64_t version = 0; // Bumped by every publish; tells a rejected token from its replacement
+    int userId = 0;       // The account the token was issued to; 0 when logged out or not reported
+    HeaderBlocks headers;
+
+    bool loggedIn() const { return !token.empty(); }
+};
+
+// --- TokenStore ---
+// Read-copy-update holder for the current AuthSnapshot. Readers (every request)
+// take a reference with std::atomic_load and never wait on a publisher; a token
+// change builds a new snapshot and swaps it in with std::atomic_store. A
+// request keeps the snapshot it started with alive, even across a re-login,
+// and a replaced snapshot (with its token) is freed when the last such request
+// lets go of it.
+class TokenStore {
+public:
+    TokenStore();
+    TokenStore(const TokenStore&) = delete;
+    TokenStore& operator=(const TokenStore&) = delete;
+
+    // Stays valid for as long as the caller holds it, even after later publishes
+    std::shared_ptr<const AuthSnapshot> current() const {
+        return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+    }
+
+    // Makes `token` (empty = logged out), issued to `userId`, the current one; returns the new snapshot
+    std::shared_ptr<const AuthSnapshot> publish(const std::string& token, int userId = 0);
+
+private:
+    std::shared_ptr<const AuthSnapshot> current_; // Only through std::atomic_load/atomic_store
+    std::mutex write_mutex_;                      // Publishers only
+};
+
+#endif // TOKEN_STORE_H
@@ -0,0 +1,261 @@
+// src/TrafficCapture.cpp
+#include "TrafficCapture.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+constexpr char kMagic[8] = {'H', 'O', 'T', 'E', 'L', 'C', 'A', 'P'};
+constexpr size_t kHeaderBytes = sizeof(kMagic) + 4 + 8;
+constexpr size_t kFixedBytes = 8 + 8 + 8 + 4 + 1 + 1 + 2;  // Payload fields before the strings
+constexpr uint32_t kMaxRecordBytes = 256u * 1024 * 1024;  // Anything larger is treated as corruption
+constexpr size_t kFileBufferBytes = 1024 * 1024;
+constexpr uint8_t kFlagAuth = 1, kFlagRedacted = 2;
+
+void putLittleEndian(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+void putString(std::string& out, std::string_view text) {
+    putLittleEndian(out, text.size(), 4);
+    out.append(text.data(), text.size());
+}
+
+// Reads forward through one record's payload; any overrun marks it bad
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data_(data) {}
+
+    uint64_t number(int bytes) {
+        if (!ok_ || data_.size() - offset_ < static_cast<size_t>(bytes)) { ok_ = false; return 0; }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(static_cast<unsigned char>(data_[offset_ + i])) << (8 * i);
+        offset_ += bytes;
+        return value;
+    }
+    std::string text() {
+        size_t size = static_cast<size_t>(number(4));
+        if (!ok_ || data_.size() - offset_ < size) { ok_ = false; return {}; }
+        std::string value(data_.substr(offset_, size));
+        offset_ += size;
+        return value;
+    }
+    bool ok() const { return ok_; }
+
+private:
+    std::string_view data_;
+    size_t offset_ = 0;
+    bool ok_ = true;
+};
+
+// Login and signup carry the password one way and the token the other
+bool carriesCredentials(std::string_view path) {
+    std::string_view route = path.substr(0, path.find('?'));
+    return route == endpoints::login.pattern || route == endpoints::signup.pattern;
+}
+
+uint64_t unixMicros() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+std::atomic<uint64_t> g_recorderIds{0};
+
+} // namespace
+
+// --- TrafficCapture ---
+
+void TrafficCapture::encodeHeader(std::string& out, uint64_t startedAtMicros) {
+    out.append(kMagic, sizeof(kMagic));
+    putLittleEndian(out, kVersion, 4);
+    putLittleEndian(out, startedAtMicros, 8);
+}
+
+void TrafficCapture::encode(std::string& out, const TrafficRecord& record) {
+    size_t start = out.size();
+    putLittleEndian(out, 0, 4); // Size, filled in below
+    putLittleEndian(out, record.startMicros, 8);
+    putLittleEndian(out, record.elapsedMicros, 8);
+    putLittleEndian(out, record.transferMicros, 8);
+    putLittleEndian(out, record.lane, 4);
+    out.push_back(static_cast<char>(record.method));
+    out.push_back(static_cast<char>((record.requiresAuth ? kFlagAuth : 0) | (record.redacted ? kFlagRedacted : 0)));
+    putLittleEndian(out, static_cast<uint64_t>(std::clamp(record.status, 0, 0xFFFF)), 2);
+    putString(out, record.path);
+    putString(out, record.requestBody);
+    putString(out, record.responseHeaders);
+    putString(out, record.responseBody);
+    uint64_t size = out.size() - start - 4;
+    for (int i = 0; i < 4; ++i) out[start + i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+}
+
+bool TrafficCapture::read(const std::string& path, std::vector<TrafficRecord>& records,
+                          uint64_t& startedAtMicros, std::string& error) {
+    std::string data;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            error = "could not open " + path;
+            return false;
+        }
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    if (data.size() < kHeaderBytes || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        error = path + " is not a traffic capture";
+        return false;
+    }
+    Reader header(std::string_view(data).substr(sizeof(kMagic), kHeaderBytes - sizeof(kMagic)));
+    uint64_t version = header.number(4);
+    if (version != kVersion) {
+        error = path + " was written by another client version (capture v" + std::to_string(version) + ")";
+        return false;
+    }
+    startedAtMicros = header.number(8);
+
+    records.clear();
+    size_t offset = kHeaderBytes;
+    while (data.size() - offset >= 4) {
+        Reader prefix(std::string_view(data).substr(offset, 4));
+        uint64_t size = prefix.number(4);
+        if (size < kFixedBytes || size > kMaxRecordBytes || data.size() - offset - 4 < size) break;
+
+        Reader in(std::string_view(data).substr(offset + 4, size));
+        TrafficRecord record;
+        record.startMicros = in.number(8);
+        record.elapsedMicros = in.number(8);
+        record.transferMicros = in.number(8);
+        record.lane = static_cast<uint32_t>(in.number(4));
+        uint64_t method = in.number(1);
+        uint64_t flags = in.number(1);
+        record.status = static_cast<int>(in.number(2));
+        record.path = in.text();
+        record.requestBody = in.text();
+        record.responseHeaders = in.text();
+        record.responseBody = in.text();
+        if (!in.ok() || method > static_cast<uint64_t>(HttpMethod::Delete)) break;
+        record.method = static_cast<HttpMethod>(method);
+        record.requiresAuth = (flags & kFlagAuth) != 0;
+        record.redacted = (flags & kFlagRedacted) != 0;
+        records.push_back(std::move(record));
+        offset += 4 + size;
+    }
+    if (offset < data.size()) {
+        LOG_WARN("[Capture] Ignoring " << data.size() - offset << " truncated or damaged bytes at the end of " << path);
+    }
+    return true;
+}
+
+// --- TrafficRecorder ---
+
+TrafficRecorder::TrafficRecorder(std::string path, uint64_t maxBytes)
+    : path_(std::move(path)), max_bytes_(maxBytes), id_(++g_recorderIds),
+      started_(std::chrono::steady_clock::now()) {}
+
+TrafficRecorder::~TrafficRecorder() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) std::fclose(file_);
+}
+
+bool TrafficRecorder::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) return true;
+    file_ = std::fopen(path_.c_str(), "wb");
+    if (!file_) {
+        LOG_ERROR("[Capture] Could not create " << path_);
+        return false;
+    }
+    file_buffer_.resize(kFileBufferBytes);
+    std::setvbuf(file_, file_buffer_.data(), _IOFBF, file_buffer_.size());
+
+    std::string header;
+    TrafficCapture::encodeHeader(header, unixMicros());
+    if (std::fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+        LOG_ERROR("[Capture] Could not write to " << path_);
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    stats_.bytes = header.size();
+    LOG_INFO("[Capture] Recording requests to " << path_);
+    return true;
+}
+
+bool TrafficRecorder::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_ != nullptr;
+}
+
+uint64_t TrafficRecorder::now() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - started_).count());
+}
+
+uint32_t TrafficRecorder::laneForThisThread() {
+    thread_local uint64_t owner = 0;
+    thread_local uint32_t lane = 0;
+    if (owner != id_) {
+        owner = id_;
+        lane = next_lane_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return lane;
+}
+
+void TrafficRecorder::record(uint64_t started, HttpMethod method, std::string_view path, bool requiresAuth,
+                             std::string_view requestBody, int status, uint64_t transferMicros,
+                             std::string_view responseHeaders, std::string_view responseBody) {
+    TrafficRecord record;
+    record.startMicros = started;
+    uint64_t finished = now();
+    record.elapsedMicros = finished > started ? finished - started : 0;
+    record.transferMicros = transferMicros;
+    record.lane = laneForThisThread();
+    record.method = method;
+    record.requiresAuth = requiresAuth;
+    record.redacted = carriesCredentials(path);
+    record.status = status;
+    record.path = path;
+    record.responseHeaders = responseHeaders;
+    if (!record.redacted) {
+        record.requestBody = requestBody;
+        record.responseBody = responseBody;
+    }
+
+    // Encoded outside the lock, into a buffer this thread keeps
+    thread_local std::string encoded;
+    encoded.clear();
+    TrafficCapture::encode(encoded, record);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || full_) {
+        ++stats_.dropped;
+        return;
+    }
+    if (stats_.bytes + encoded.size() > max_bytes_) {
+        full_ = true;
+        ++stats_.dropped;
+        LOG_WARN("[Capture] " << path_ << " reached " << max_bytes_ << " bytes; recording stopped.");
+        return;
+    }
+    if (std::fwrite(encoded.data(), 1, encoded.size(), file_) != encoded.size()) {
+        full_ = true;
+        ++stats_.dropped;
+        LOG_ERROR("[Capture] Could not write to " << path_ << "; recording stopped.");
+        return;
+    }
+    ++stats_.records;
+    stats_.bytes += encoded.size();
+}
+
+void TrafficRecorder::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) std::fflush(file_);
+}
+
+TrafficRecorder::Stats TrafficRecorder::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
@@ -0,0 +1,102 @@
+// src/TrafficCapture.h
+#ifndef TRAFFIC_CAPTURE_H
+#define TRAFFIC_CAPTURE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Endpoint.h" // HttpMethod
+
+// One request the client sent and what came back
+struct TrafficRecord {
+    uint64_t startMicros = 0;    // When it was sent, since the capture began
+    uint64_t elapsedMicros = 0;  // Until the client had its answer, retries and hedges included
+    uint64_t transferMicros = 0; // The answering transfer alone, as curl timed it
+    uint32_t lane = 0;           // Sending thread, numbered in order of first request
+    HttpMethod method = HttpMethod::Get;
+    bool requiresAuth = false;
+    bool redacted = false;       // Bodies left out (credentials, tokens)
+    int status = 0;              // 0: no response (network error)
+    std::string path;            // Relative to the API base, with the query
+    std::string requestBody;
+    std::string responseHeaders; // "Name: value\n" for the headers the client reads
+    std::string responseBody;    // As decoded by curl (no Content-Encoding)
+};
+
+// --- TrafficCapture ---
+// A recorded session, for hotel_replay. The file is a header, then one
+// [u32 size][payload] record per request, little-endian:
+//   Header:  "HOTELCAP" | u32 version | u64 start (Unix microseconds)
+//   Payload: u64 start | u64 elapsed | u64 transfer | u32 lane | u8 method |
+//            u8 flags (1 auth, 2 redacted) | u16 status |
+//            path, request body, response headers, response body as [u32 size][bytes]
+// A file cut short (the client was killed) reads up to the last whole record.
+class TrafficCapture {
+public:
+    static constexpr uint32_t kVersion = 1;
+
+    // Loads every record, in the order they were written; false if the file is missing or not a capture
+    static bool read(const std::string& path, std::vector<TrafficRecord>& records,
+                     uint64_t& startedAtMicros, std::string& error);
+
+    // The record's bytes, size prefix included
+    static void encode(std::string& out, const TrafficRecord& record);
+    static void encodeHeader(std::string& out, uint64_t startedAtMicros);
+};
+
+// --- TrafficRecorder ---
+// Writes a TrafficCapture while the client runs (ApiClient::setTrafficRecorder).
+// Records are encoded on the sending thread and appended under a lock through a
+// large stdio buffer, so recording costs a copy of each body and no syscall per
+// request. Once the file reaches maxBytes recording stops, with one warning.
+// Login and signup bodies are never written: they carry passwords and tokens.
+class TrafficRecorder {
+public:
+    struct Stats {
+        uint64_t records = 0;
+        uint64_t bytes = 0;   // Header included
+        uint64_t dropped = 0; // Requests not recorded: over maxBytes or a write failed
+    };
+
+    explicit TrafficRecorder(std::string path, uint64_t maxBytes = 1ull << 30);
+    ~TrafficRecorder(); // Flushes and closes
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+    // Creates (or truncates) the file and writes its header; false if it can't be written
+    bool open();
+    bool isOpen() const;
+    const std::string& path() const { return path_; }
+
+    // Microseconds since open(); pass the value taken before a request as `started`
+    uint64_t now() const;
+    void record(uint64_t started, HttpMethod method, std::string_view path, bool requiresAuth,
+                std::string_view requestBody, int status, uint64_t transferMicros,
+                std::string_view responseHeaders, std::string_view responseBody);
+
+    void flush();
+    Stats stats() const;
+
+private:
+    uint32_t laneForThisThread();
+
+    std::string path_;
+    uint64_t max_bytes_;
+    uint64_t id_;                   // Tells this recorder's lanes from an earlier one's
+    std::chrono::steady_clock::time_point started_;
+    std::atomic<uint32_t> next_lane_{0};
+
+    mutable std::mutex mutex_;
+    std::FILE* file_ = nullptr;
+    std::vector<char> file_buffer_; // stdio buffer for file_
+    bool full_ = false;             // maxBytes reached (or a write failed): no more records
+    Stats stats_;
+};
+
+#endif // TRAFFIC_CAPTURE_H
@@ -0,0 +1,381 @@
+// src/TrafficReplay.cpp
+// hotel_replay: plays a traffic capture (HOTEL_CAPTURE_PATH in the client,
+// TrafficRecorder) back through an ApiClient. A built-in stand-in server
+// answers each request with the response recorded for it, after the recorded
+// transfer time, so two client builds can be compared on identical traffic.
+// Requests keep their recorded threads (lanes) and, at --speed=1, their timing.
+//
+// Example (a morning's check-ins, ten times faster):
+//   hotel_replay --capture=rush.cap --speed=10
+//   hotel_replay --capture=rush.cap --speed=max --record=replayed.cap
+#include <crow.h>
+#include <cpr/cpr.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "ApiClient.h"
+#include "LatencyHistogram.h"
+#include "Logger.h"
+#include "TrafficCapture.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::string kApiPrefix = "/api";
+
+struct ReplayConfig {
+    std::string capturePath;
+    double speed = 1.0;              // 0: as fast as each lane can go
+    std::string baseUrl;             // Replay against this server instead of the stand-in
+    std::string bindAddress = "127.0.0.1";
+    int port = 8089;                 // Stand-in server
+    unsigned serverThreads = std::max(2u, std::thread::hardware_concurrency());
+    bool serverDelay = true;         // Stand-in waits the recorded transfer time before answering
+    std::string email;               // Log in first (with --url; the stand-in doesn't check auth)
+    std::string password;
+    std::string recordPath;          // Capture the replay itself
+    TransportOptions transport;
+    bool verbose = false;
+};
+
+void printUsage() {
+    std::cout << "Usage: hotel_replay --capture=FILE [options]\n"
+              << "  --capture=FILE        Traffic capture to play back (required)\n"
+              << "  --speed=N|max         Schedule factor: 1 = as recorded, 10 = ten times faster,\n"
+              << "                        max = each lane sends as soon as its last request is done (default 1)\n"
+              << "  --port=N              Stand-in server port (default 8089)\n"
+              << "  --threads=N           Stand-in server threads (default: hardware concurrency)\n"
+              << "  --no-server-delay     Stand-in answers at once instead of after the recorded transfer time\n"
+              << "  --url=URL             Replay against this API (e.g. hotel_mock_server) instead of the stand-in\n"
+              << "  --email=E --password=P  Log in before replaying (with --url)\n"
+              << "  --record=FILE         Capture the replayed traffic too, for comparing runs\n"
+              << "  --http1               HTTP/1.1 only\n"
+              << "  --h2c                 HTTP/2 without negotiation\n"
+              << "  --no-compression      Don't send Accept-Encoding\n"
+              << "  --verbose             Keep the client's per-request logging\n";
+}
+
+bool parseArgs(int argc, char** argv, ReplayConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+        size_t eq = arg.find('=');
+        if (eq != std::string::npos) {
+            value = arg.substr(eq + 1);
+            arg = arg.substr(0, eq);
+        }
+        try {
+            if (arg == "--help" || arg == "-h") { printUsage(); return false; }
+            else if (arg == "--capture") config.capturePath = value;
+            else if (arg == "--speed") config.speed = value == "max" ? 0.0 : std::max(0.0, std::stod(value));
+            else if (arg == "--port") config.port = std::stoi(value);
+            else if (arg == "--threads") config.serverThreads = static_cast<unsigned>(std::max(1, std::stoi(value)));
+            else if (arg == "--no-server-delay") config.serverDelay = false;
+            else if (arg == "--url") config.baseUrl = value;
+            else if (arg == "--email") config.email = value;
+            else if (arg == "--password") config.password = value;
+            else if (arg == "--record") config.recordPath = value;
+            else if (arg == "--http1") config.transport.httpVersion = TransportOptions::HttpVersion::Http1;
+            else if (arg == "--h2c") config.transport.httpVersion = TransportOptions::HttpVersion::Http2PriorKnowledge;
+            else if (arg == "--no-compression") config.transport.compression = false;
+            else if (arg == "--verbose") config.verbose = true;
+            else {
+                std::cerr << "[Replay Error] Unknown option: " << arg << std::endl;
+                printUsage();
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "[Replay Error] Invalid value for " << arg << ": '" << value << "'" << std::endl;
+            return false;
+        }
+    }
+    if (config.capturePath.empty()) {
+        std::cerr << "[Replay Error] --capture is required." << std::endl;
+        printUsage();
+        return false;
+    }
+    return true;
+}
+
+std::string requestKey(HttpMethod method, const std::string& target) {
+    return std::string(methodName(method)) + " " + target;
+}
+
+// "GET /rooms/42?x=1" -> "GET /rooms/{id}", so a report row covers a route rather than one URL
+std::string routeName(const TrafficRecord& record) {
+    std::string path = record.path.substr(0, record.path.find('?'));
+    std::string route;
+    size_t start = 0;
+    while (start < path.size()) {
+        size_t end = path.find('/', start + 1);
+        if (end == std::string::npos) end = path.size();
+        std::string segment = path.substr(start, end - start); // "/42"
+        bool numeric = segment.size() > 1 &&
+                       std::all_of(segment.begin() + 1, segment.end(), [](char c) { return c >= '0' && c <= '9'; });
+        route += numeric ? "/{id}" : segment;
+        start = end;
+    }
+    return std::string(methodName(record.method)) + " " + route;
+}
+
+// --- Stand-in server ---
+// Answers each request with the next recorded response for the same method and
+// target, in capture order; once those run out (the client sent more, e.g.
+// retries) the last one is repeated.
+class PlaybackServer {
+public:
+    PlaybackServer(const std::vector<TrafficRecord>& records, const ReplayConfig& config)
+        : records_(records), delay_(config.serverDelay) {
+        for (size_t i = 0; i < records.size(); ++i) {
+            queues_[requestKey(records[i].method, records[i].path)].indices.push_back(i);
+        }
+    }
+
+    crow::response handle(const crow::request& req) {
+        if (req.url.compare(0, kApiPrefix.size(), kApiPrefix) != 0) {
+            return crow::response(404, "{\"message\":\"Not Found\"}");
+        }
+        std::optional<HttpMethod> method = parseMethod(crow::method_name(req.method));
+        const TrafficRecord* record = method ? next(requestKey(*method, req.raw_url.substr(kApiPrefix.size()))) : nullptr;
+        if (!record) {
+            unmatched_.fetch_add(1, std::memory_order_relaxed);
+            return crow::response(404, "{\"message\":\"Not in the capture\"}");
+        }
+        served_.fetch_add(1, std::memory_order_relaxed);
+        if (delay_) std::this_thread::sleep_for(std::chrono::microseconds(record->transferMicros));
+
+        // A request that got no response at all is answered with the closest thing
+        crow::response res(record->status ? record->status : 503, record->responseBody);
+        size_t start = 0;
+        while (start < record->responseHeaders.size()) {
+            size_t end = record->responseHeaders.find('\n', start);
+            if (end == std::string::npos) end = record->responseHeaders.size();
+            size_t colon = record->responseHeaders.find(':', start);
+            if (colon != std::string::npos && colon < end) {
+                size_t value = std::min(colon + 2, end);
+                res.set_header(record->responseHeaders.substr(start, colon - start),
+                               record->responseHeaders.substr(value, end - value));
+            }
+            start = end + 1;
+        }
+        return res;
+    }
+
+    uint64_t served() const { return served_.load(); }
+    uint64_t unmatched() const { return unmatched_.load(); }
+
+private:
+    struct Queue {
+        std::vector<size_t> indices; // Into records_, in capture order
+        size_t next = 0;
+    };
+
+    const TrafficRecord* next(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = queues_.find(key);
+        if (found == queues_.end()) return nullptr;
+        Queue& queue = found->second;
+        size_t index = queue.indices[std::min(queue.next, queue.indices.size() - 1)];
+        ++queue.next;
+        return &records_[index];
+    }
+
+    const std::vector<TrafficRecord>& records_;
+    bool delay_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, Queue> queues_;
+    std::atomic<uint64_t> served_{0};
+    std::atomic<uint64_t> unmatched_{0};
+};
+
+// --- Client side ---
+struct RouteStats {
+    LatencyHistogram recorded; // As the original client saw it
+    LatencyHistogram replayed;
+    uint64_t mismatches = 0;   // Status differs from the recorded one
+};
+
+struct LaneStats {
+    std::map<std::string, RouteStats> routes;
+    uint64_t maxLagMicros = 0; // Furthest a request was sent behind its scheduled time
+};
+
+// Sends one lane's requests in order, each no earlier than its scaled start time
+void runLane(ApiClient& client, const std::vector<TrafficRecord>& records, const std::vector<size_t>& lane,
+             double speed, Clock::time_point start, LaneStats& stats) {
+    for (size_t index : lane) {
+        const TrafficRecord& record = records[index];
+        if (speed > 0) {
+            auto due = start + std::chrono::microseconds(static_cast<uint64_t>(static_cast<double>(record.startMicros) / speed));
+            std::this_thread::sleep_until(due);
+            auto lag = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - due).count();
+            stats.maxLagMicros = std::max(stats.maxLagMicros, static_cast<uint64_t>(std::max<int64_t>(0, lag)));
+        }
+
+        auto sent = Clock::now();
+        std::optional<cpr::Response> response = client.replayRequest(record);
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sent).count();
+
+        RouteStats& route = stats.routes[routeName(record)];
+        route.recorded.record(record.elapsedMicros);
+        route.replayed.record(static_cast<uint64_t>(micros));
+        int status = response && !response->error ? static_cast<int>(response->status_code) : 0;
+        // A recorded network error comes back from the stand-in as a 503, the nearest it can do
+        bool matches = status == record.status || (record.status == 0 && status == 503);
+        if (!matches) route.mismatches++;
+    }
+}
+
+void printRow(const std::string& name, const RouteStats& s) {
+    auto ms = [](uint64_t micros) { return static_cast<double>(micros) / 1000.0; };
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(8) << s.replayed.count()
+              << std::setw(10) << s.mismatches
+              << std::fixed << std::setprecision(2)
+              << std::setw(12) << ms(s.recorded.percentile(50))
+              << std::setw(10) << ms(s.replayed.percentile(50))
+              << std::setw(10) << ms(s.replayed.percentile(95))
+              << std::setw(10) << ms(s.replayed.percentile(99))
+              << std::setw(10) << ms(s.replayed.max()) << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ReplayConfig config;
+    if (!parseArgs(argc, argv, config)) return 1;
+    if (!config.verbose) Logger::instance().setLevel(LogLevel::Off);
+
+    std::vector<TrafficRecord> records;
+    uint64_t capturedAt = 0;
+    std::string error;
+    if (!TrafficCapture::read(config.capturePath, records, capturedAt, error)) {
+        std::cerr << "[Replay Error] " << error << std::endl;
+        return 1;
+    }
+    if (records.empty()) {
+        std::cerr << "[Replay Error] " << config.capturePath << " holds no requests." << std::endl;
+        return 1;
+    }
+
+    // Lanes in recorded order; a record's start time orders it within its lane
+    std::map<uint32_t, std::vector<size_t>> lanes;
+    size_t redacted = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        lanes[records[i].lane].push_back(i);
+        if (records[i].redacted) ++redacted;
+    }
+    uint64_t spanMicros = 0;
+    for (const auto& record : records) spanMicros = std::max(spanMicros, record.startMicros);
+    std::cout << "hotel_replay: " << records.size() << " requests over " << std::fixed << std::setprecision(1)
+              << static_cast<double>(spanMicros) / 1e6 << "s in " << lanes.size() << " lanes, at "
+              << (config.speed > 0 ? std::to_string(config.speed) + "x" : std::string("maximum speed")) << std::endl;
+    if (redacted > 0) {
+        std::cout << "[Replay Info] " << redacted << " login/signup requests were recorded without bodies." << std::endl;
+    }
+
+    bool standIn = config.baseUrl.empty();
+    if (standIn) config.baseUrl = "http://" + config.bindAddress + ":" + std::to_string(config.port) + kApiPrefix;
+
+    // --- Client ---
+    // One client shared by every lane, as the application shares it across threads
+    ApiClient client(config.baseUrl, std::max<size_t>(1, lanes.size()));
+    client.setTransportOptions(config.transport);
+    TrafficRecorder recorder(config.recordPath);
+    if (!config.recordPath.empty()) {
+        if (!recorder.open()) {
+            std::cerr << "[Replay Error] Could not create " << config.recordPath << std::endl;
+            return 1;
+        }
+        client.setTrafficRecorder(&recorder);
+    }
+    if (!config.email.empty() && !client.login(config.email, config.password)) {
+        std::cerr << "[Replay Error] Login as " << config.email << " failed." << std::endl;
+        return 1;
+    }
+
+    // --- Stand-in server ---
+    PlaybackServer playback(records, config);
+    crow::SimpleApp app;
+    std::future<void> server;
+    if (standIn) {
+        app.loglevel(config.verbose ? crow::LogLevel::Info : crow::LogLevel::Warning);
+        CROW_CATCHALL_ROUTE(app)([&playback](const crow::request& req) { return playback.handle(req); });
+        server = app.bindaddr(config.bindAddress)
+                     .port(static_cast<std::uint16_t>(config.port))
+                     .concurrency(static_cast<std::uint16_t>(config.serverThreads))
+                     .run_async();
+        app.wait_for_server_start();
+    }
+
+    std::vector<LaneStats> stats(lanes.size());
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    size_t laneIndex = 0;
+    for (const auto& lane : lanes) {
+        threads.emplace_back(runLane, std::ref(client), std::cref(records), std::cref(lane.second),
+                             config.speed, start, std::ref(stats[laneIndex++]));
+    }
+    for (auto& t : threads) t.join();
+    double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (!config.recordPath.empty()) {
+        recorder.flush();
+        client.setTrafficRecorder(nullptr);
+    }
+    Logger::instance().flush();
+    if (standIn) app.stop();
+
+    // --- Report ---
+    std::map<std::string, RouteStats> routes;
+    RouteStats total;
+    uint64_t maxLag = 0;
+    for (const auto& lane : stats) {
+        for (const auto& route : lane.routes) {
+            RouteStats& merged = routes[route.first];
+            merged.recorded.merge(route.second.recorded);
+            merged.replayed.merge(route.second.replayed);
+            merged.mismatches += route.second.mismatches;
+            total.recorded.merge(route.second.recorded);
+            total.replayed.merge(route.second.replayed);
+            total.mismatches += route.second.mismatches;
+        }
+        maxLag = std::max(maxLag, lane.maxLagMicros);
+    }
+
+    std::cout << "\n--- Replay (" << std::fixed << std::setprecision(1) << wallSeconds << "s";
+    if (config.speed > 0) std::cout << ", " << static_cast<double>(spanMicros) / 1e6 / config.speed << "s scheduled";
+    std::cout << ") ---" << std::endl;
+    std::cout << std::left << std::setw(28) << "Route" << std::right
+              << std::setw(8) << "Count" << std::setw(10) << "Mismatch" << std::setw(12) << "rec p50 ms"
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p95 ms" << std::setw(10) << "p99 ms"
+              << std::setw(10) << "max ms" << std::endl;
+    for (const auto& route : routes) printRow(route.first, route.second);
+    printRow("TOTAL", total);
+
+    if (config.speed > 0) {
+        std::cout << "Schedule: sent up to " << std::setprecision(2) << static_cast<double>(maxLag) / 1000.0
+                  << " ms behind the recorded timing" << std::endl;
+    }
+    if (standIn) {
+        std::cout << "Stand-in: " << playback.served() << " answered from the capture, "
+                  << playback.unmatched() << " not in it" << std::endl;
+    }
+    if (!config.recordPath.empty()) {
+        TrafficRecorder::Stats recorded = recorder.stats();
+        std::cout << "Recorded " << recorded.records << " requests (" << recorded.bytes << " bytes) to "
+                  << config.recordPath << std::endl;
+    }
+    return total.mismatches == 0 ? 0 : 2;
+}
@@ -0,0 +1,72 @@
+// src/WorkerPool.cpp
+#include "WorkerPool.h"
+#include "Logger.h"
+#include <exception>
+
+namespace {
+thread_local const WorkerPool* current_pool = nullptr; // Pool owning the current thread, if any
+}
+
+WorkerPool::WorkerPool(size_t threadCount, size_t maxQueued)
+    : max_queued_(maxQueued == 0 ? 1 : maxQueued) {
+    if (threadCount == 0) threadCount = 1;
+    threads_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+    for (auto& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+void WorkerPool::enqueue(std::function<void()> job) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return stopping_ || queue_.size() < max_queued_; });
+        if (stopping_) {
+            // Pool is shutting down; run inline so the caller's future is still satisfied
+            lock.unlock();
+            job();
+            return;
+        }
+        queue_.push_back(std::move(job));
+    }
+    not_empty_.notify_one();
+}
+
+bool WorkerPool::isWorkerThread() const {
+    return current_pool == this;
+}
+
+void WorkerPool::workerLoop() {
+    current_pool = this;
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return; // stopping_ and fully drained
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        not_full_.notify_one();
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            // submit() stores exceptions in the future; this only catches post() jobs
+            LOG_ERROR("[Worker Error] Uncaught exception in async job: " << e.what());
+        } catch (...) {
+            LOG_ERROR("[Worker Error] Uncaught non-standard exception in async job.");
+        }
+    }
+}
@@ -0,0 +1,62 @@
+// src/WorkerPool.h
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// --- WorkerPool ---
+// Fixed number of threads pulling jobs from a bounded queue.
+// submit() blocks while the queue is full, so callers get natural backpressure
+// instead of an unbounded pile of pending requests.
+class WorkerPool {
+public:
+    WorkerPool(size_t threadCount, size_t maxQueued = 256);
+    ~WorkerPool(); // Finishes queued jobs, then joins the threads
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Queue a callable and get a future for its result (exceptions land in the future)
+    template <typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        // packaged_task is move-only; share it so the job fits in a std::function
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged] { (*packaged)(); });
+        return future;
+    }
+
+    // Queue a fire-and-forget job; exceptions are logged by the worker
+    void post(std::function<void()> job) { enqueue(std::move(job)); }
+
+    size_t threadCount() const { return threads_.size(); }
+
+    // True when called from one of this pool's threads. Code that would block on
+    // another job of the same pool should run that work inline instead (deadlock).
+    bool isWorkerThread() const;
+
+private:
+    void enqueue(std::function<void()> job);
+    void workerLoop();
+
+    const size_t max_queued_;
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> queue_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    bool stopping_ = false;
+};
+
+#endif // WORKER_POOL_H
@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include "Date.h"
+#include "Symbol.h"
 
 using json = nlohmann::json;
 
@@ -13,13 +15,13 @@ using json = nlohmann::json;
 struct Room {
     int id = 0;
     std::string name = "";
-    std::string type = "";
+    Symbol type;       // Interned: a handful of values repeated across the catalog
     double price = 0.0;
-    std::string bedSize = ""; // Matches bedSize in JSON
-    std::string view = "";
+    Symbol bedSize;    // Matches bedSize in JSON
+    Symbol view;
     int capacity = 0;
     std::string description = "";
-    std::vector<std::string> amenities;
+    AmenitySet amenities; // Serialized as an array of names
     std::string image = ""; // Assuming URL string
     bool available = true; // Assuming API provides availability
     // Add created_at, updated_at std::string fields if needed
@@ -64,13 +66,13 @@ struct Booking {
     int id = 0;
     int userId = 0;     // Matches userId in JSON
     int roomId = 0;     // Matches roomId in JSON
-    std::string checkIn = "";  // Matches checkIn in JSON
-    std::string checkOut = ""; // Matches checkOut in JSON
+    Date checkIn;  // Matches checkIn in JSON ("YYYY-MM-DD")
+    Date checkOut; // Matches checkOut in JSON
     int guests = 0;
     std::string status = "";
     std::string package = "";
     bool housekeeping = false;
-    std::string housekeepingTime = ""; // Matches housekeepingTime in JSON
+    TimeOfDay housekeepingTime; // Matches housekeepingTime in JSON ("HH:MM")
     bool parking = false;
     double totalPrice = 0.0; // Matches totalPrice in JSON
     // Add created_at, updated_at std::string fields if needed
@@ -83,16 +85,55 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Booking, id, userId, roomId, checkIn, checkOu
 // Fields needed to create a new booking request
 struct BookingData {
     int room_id; // Match JSON key expected by API
-    std::string check_in;
-    std::string check_out;
+    Date check_in;  // Sent as "YYYY-MM-DD"
+    Date check_out;
     int guests;
     std::string package;
     bool housekeeping;
-    std::string housekeeping_time; // Optional if housekeeping is false
+    TimeOfDay housekeeping_time; // Optional if housekeeping is false (sent as "")
     bool parking;
 };
 // Macro for BookingData struct
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BookingData, room_id, check_in, check_out, guests, package, housekeeping, housekeeping_time, parking);
 
 
+// --- MaintenanceTask Structure (for receiving data) ---
+// Flat fields of MaintenanceTaskResource; nested room/category/assignee objects are not kept
+struct MaintenanceTask {
+    int id = 0;
+    std::string status = "";
+    std::string scheduled_date = "";  // Laravel timestamp, as sent
+    std::string completed_at = "";    // Empty until completed
+    std::string notes = "";
+    int actual_duration = 0;          // Minutes
+    int parent_task_id = 0;           // 0 for top-level tasks
+    std::string recurrence_rule = "";
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(MaintenanceTask, id, status, scheduled_date, completed_at, notes, actual_duration, parent_task_id, recurrence_rule);
+
+
+// --- Payment Structures ---
+// PaymentResource; a newly created payment only carries transaction_id and status
+struct Payment {
+    int id = 0;
+    std::string transaction_id = "";
+    double amount = 0.0;
+    std::string currency = "";
+    int booking_id = 0;
+    std::string payment_method = "";
+    std::string status = "";          // "pending", "completed", "failed", "refunded"
+    std::string refund_reason = "";
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Payment, id, transaction_id, amount, currency, booking_id, payment_method, status, refund_reason);
+
+// Fields needed to take a payment (POST /payments)
+struct PaymentData {
+    double amount = 0.0;
+    std::string currency;       // ISO 4217, e.g. "USD"
+    int booking_id = 0;
+    std::string payment_method;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(PaymentData, amount, currency, booking_id, payment_method);
+
+
 #endif // DATA_STRUCTURES_H
\ No newline at end of file
@@ -5,8 +5,21 @@
 #include <cstdlib>      // For std::getenv
 #include <limits>       // For std::numeric_limits (used for clearing cin buffer)
 #include <optional>     // For std::optional
+#include <algorithm>    // For std::find_if
+#include <chrono>       // For timing searches
+#include <future>       // For background refreshes
+#include <iomanip>      // For money formatting in quotes
+#include <memory>       // For std::unique_ptr
 #include <dotenv.h>     // For loading .env file
 #include "ApiClient.h"  // Our API client class
+#include "AvailabilityIndex.h" // Local room availability over date ranges
+#include "JournalReplayer.h" // Sends queued offline writes in the background
+#include "Logger.h"     // Level-gated client logging
+#include "MutationJournal.h" // Local journal of writes made while the API was down
+#include "RateCalendar.h" // Local stay quotes from nightly rates
+#include "RoomTable.h"  // Columnar room search
+#include "SnapshotFile.h" // Rooms and bookings saved between runs
+#include "TrafficCapture.h" // Request/response recording for hotel_replay
 #include "DataStructures.h" // Our data structures (Room, BookingData, etc.)
 
 // Helper function to get environment variable or return a default value
@@ -45,6 +58,44 @@ void clearInputBuffer() {
      std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
+// Read a "YYYY-MM-DD" date, asking again until it parses
+Date readDate() {
+    std::string text;
+    Date date;
+    while (!(std::cin >> text) || !Date::parse(text, date)) {
+        std::cerr << "Invalid date (YYYY-MM-DD): ";
+        std::cin.clear(); clearInputBuffer();
+    }
+    clearInputBuffer();
+    return date;
+}
+
+// Read an "HH:MM" time, asking again until it parses
+TimeOfDay readTime() {
+    std::string text;
+    TimeOfDay time;
+    while (!(std::cin >> text) || !TimeOfDay::parse(text, time)) {
+        std::cerr << "Invalid time (HH:MM): ";
+        std::cin.clear(); clearInputBuffer();
+    }
+    clearInputBuffer();
+    return time;
+}
+
+void printBooking(const Booking& booking) {
+    std::cout << "Booking ID: " << booking.id << " | Room ID: " << booking.roomId
+              << " | Check-In: " << booking.checkIn << " | Check-Out: " << booking.checkOut
+              << " | Guests: " << booking.guests << std::endl;
+    std::cout << "  Status: " << booking.status << " | Package: " << booking.package
+              << " | Price: $" << booking.totalPrice << std::endl;
+    std::cout << "  Housekeeping: " << (booking.housekeeping ? ("Yes (" + booking.housekeepingTime.toString() + ")") : "No")
+              << " | Parking: " << (booking.parking ? "Yes" : "No") << std::endl;
+    std::cout << "---------------------" << std::endl;
+}
+
+// Bookings kept in the snapshot: the latest check-ins first
+constexpr size_t kSnapshotBookings = 500;
+
 int main() {
     // --- Load .env file ---
     try {
@@ -56,26 +107,124 @@ int main() {
     }
     // --- -------------- ---
 
+    // --- Logging ---
+    // HOTEL_LOG_* may come from .env, so read them again now. The console
+    // client logs synchronously unless HOTEL_LOG_ASYNC says otherwise, so
+    // request logs stay in order with the command output around them.
+    Logger::instance().configureFromEnvironment();
+    if (!std::getenv("HOTEL_LOG_ASYNC")) Logger::instance().setAsync(false);
+
     // --- Configuration ---
     std::string api_base_url = getEnvVar("API_BASE_URL", "http://127.0.0.1:8000/api");
 
+    // --- Offline Journal ---
+    // Bookings and updates that can't reach the API are kept here and sent once it is back.
+    // Declared before the client so it outlives any request still running on its workers.
+    MutationJournal journal(getEnvVar("HOTEL_JOURNAL_PATH", "hotel_journal.bin"));
+    bool journalOpen = journal.open();
+    if (!journalOpen) {
+        std::cerr << "[Config Warning] Could not open the offline journal '" << journal.path()
+                  << "'. Writes made while the API is unreachable will be lost." << std::endl;
+    }
+
+    // --- Traffic Capture ---
+    // With HOTEL_CAPTURE_PATH set, every request and response is recorded there so a
+    // slow session can be played back later with hotel_replay. Off unless asked for.
+    const char* capturePath = std::getenv("HOTEL_CAPTURE_PATH");
+    TrafficRecorder recorder(capturePath ? capturePath : "");
+    bool capturing = capturePath && *capturePath && recorder.open();
+    if (capturePath && *capturePath && !capturing) {
+        std::cerr << "[Config Warning] Could not create the traffic capture '" << recorder.path()
+                  << "'. Requests will not be recorded." << std::endl;
+    }
+
     // --- Initialize ApiClient ---
     ApiClient client(api_base_url);
+    // With HOTEL_AUTO_RELOGIN=1 an expired session is renewed once (for the REPL and
+    // the journal replayer alike) instead of failing every request until the next login
+    client.setAutoRelogin(getEnvVar("HOTEL_AUTO_RELOGIN", "0") == "1");
     std::optional<User> loggedInUser = std::nullopt; // Store logged in user details
+    std::unique_ptr<JournalReplayer> replayer;
+    if (journalOpen) {
+        client.setMutationJournal(&journal);
+        replayer = std::make_unique<JournalReplayer>(client);
+    }
+    if (capturing) client.setTrafficRecorder(&recorder);
+
+    // --- Rates ---
+    // Seasons, special prices and surcharges for local quotes. Without a rates
+    // file every night costs Room::price, which is what the API charges today.
+    RateRules rateRules = RateRules::load(getEnvVar("HOTEL_RATES_PATH", "hotel_rates.json")).value_or(RateRules{});
+    constexpr int32_t kQuoteHorizonNights = 730;
+
+    // --- Startup Snapshot ---
+    // The last run's rooms and bookings, usable before any request goes out. The
+    // catalog seeds the room cache and is revalidated in the background right away.
+    std::string snapshotPath = getEnvVar("HOTEL_SNAPSHOT_PATH", "hotel_snapshot.bin");
+    SnapshotFile::Contents saved; // What the next snapshot will hold
+    {
+        SnapshotFile snapshot;
+        if (snapshot.open(snapshotPath)) {
+            saved.rooms = snapshot.rooms();
+            saved.roomValidators = snapshot.roomValidators();
+            saved.bookingsUserId = snapshot.bookingsUserId();
+            saved.bookings = snapshot.bookings();
+            client.seedRoomCatalog(RoomCache::Catalog{saved.rooms, saved.roomValidators});
+            auto age = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::system_clock::now() - snapshot.savedAt());
+            std::cout << "Loaded " << saved.rooms.size() << " rooms and " << saved.bookings.size()
+                      << " bookings from the snapshot saved " << age.count() << " minute(s) ago." << std::endl;
+        }
+    } // Unmapped here, so the file can be replaced while we run
+    std::future<std::vector<Room>> roomsRefresh = client.getRoomsAsync();
+    std::future<std::vector<Booking>> bookingsRefresh;
+    int bookingsRefreshUser = 0;
+    auto saveSnapshot = [&] {
+        if (std::optional<RoomCache::Catalog> catalog = client.roomCatalog()) {
+            saved.rooms = std::move(catalog->rooms);
+            saved.roomValidators = std::move(catalog->validators);
+        }
+        SnapshotFile::write(snapshotPath, saved);
+    };
+    // Folds finished background refreshes into `saved`; true if any finished
+    auto collectRefreshes = [&] {
+        bool refreshed = false;
+        if (roomsRefresh.valid() && roomsRefresh.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            roomsRefresh.get(); // Lands in the room cache; roomCatalog() picks it up
+            refreshed = true;
+        }
+        if (bookingsRefresh.valid() && bookingsRefresh.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            std::vector<Booking> bookings = bookingsRefresh.get();
+            // Empty may just mean the request failed: don't trade saved bookings for nothing
+            if (!bookings.empty() || saved.bookingsUserId != bookingsRefreshUser) {
+                std::sort(bookings.begin(), bookings.end(),
+                          [](const Booking& a, const Booking& b) { return a.checkIn > b.checkIn; });
+                if (bookings.size() > kSnapshotBookings) bookings.resize(kSnapshotBookings);
+                saved.bookings = std::move(bookings);
+                saved.bookingsUserId = bookingsRefreshUser;
+            }
+            refreshed = true;
+        }
+        return refreshed;
+    };
 
     // --- Application Start ---
     std::cout << "\n--- Serene Hotel C++ Client ---" << std::endl;
     std::cout << "Connecting to API at: " << api_base_url << std::endl;
+    if (journalOpen && journal.pendingCount() > 0) {
+        std::cout << journal.pendingCount() << " write(s) from an earlier session are queued and will be sent when the account that made them logs in." << std::endl;
+    }
 
     // --- User Interaction Loop ---
     std::string command;
     while (true) {
+        if (collectRefreshes()) saveSnapshot();
+        Logger::instance().flush(); // Pending log lines before the prompt
         // Display options based on authentication state
         if (!loggedInUser.has_value()) { // Check if user is logged in
             std::cout << "\nOptions: [login, signup, exit]" << std::endl;
         } else {
             std::cout << "\nLogged in as: " << loggedInUser.value().username << " (Role: " << loggedInUser.value().role << ")" << std::endl;
-            std::cout << "Options: [rooms, my_bookings, create_booking, profile, logout";
+            std::cout << "Options: [rooms, find_rooms, search_rooms, my_bookings, create_booking, group_booking, quote, profile, dashboard, metrics, sync, logout";
             // Add manager options if applicable
             if (loggedInUser.value().role == "manager" || loggedInUser.value().role == "receptionist") { // Adjust roles as needed
                  std::cout << ", create_room, update_room, delete_room";
@@ -110,6 +259,9 @@ int main() {
             if (loginResult.has_value()) {
                 loggedInUser = loginResult; // Store the returned User object
                 std::cout << "\nLogin successful! Welcome, " << loggedInUser.value().username << "." << std::endl;
+                if (replayer) replayer->wake(); // Queued writes need a token to be sent
+                bookingsRefresh = client.getBookingsAsync(); // For the snapshot
+                bookingsRefreshUser = loggedInUser.value().id;
             } else {
                 std::cerr << "\nLogin failed. Please check credentials or try again." << std::endl;
             }
@@ -141,9 +293,7 @@ int main() {
                               << " | Capacity: " << room.capacity << " | View: " << room.view
                               << " | Available: " << (room.available ? "Yes" : "No") << std::endl;
                     std::cout << "  Bed Size: " << room.bedSize << std::endl;
-                    std::cout << "  Amenities: ";
-                    for(size_t i = 0; i < room.amenities.size(); ++i) { std::cout << room.amenities[i] << (i == room.amenities.size() - 1 ? "" : ", "); }
-                    std::cout << std::endl;
+                    std::cout << "  Amenities: " << room.amenities << std::endl;
                     std::cout << "  Description: " << room.description << std::endl;
                     std::cout << "------------------------" << std::endl;
                 }
@@ -151,38 +301,113 @@ int main() {
                 std::cerr << "Failed to fetch rooms or no rooms currently listed." << std::endl;
             }
         }
+        else if (command == "find_rooms" && loggedInUser) {
+             Date checkIn, checkOut; int guests;
+             std::cout << "Enter Check-in Date (YYYY-MM-DD): "; checkIn = readDate();
+             std::cout << "Enter Check-out Date (YYYY-MM-DD): "; checkOut = readDate();
+             std::cout << "Enter Number of Guests: ";
+             while (!(std::cin >> guests) || guests <= 0) { std::cerr << "Invalid guests: "; std::cin.clear(); clearInputBuffer();} clearInputBuffer();
+
+             // Staff can see every booking; guests only know their own, so results are a best guess
+             const std::string& role = loggedInUser.value().role;
+             bool staff = role == "admin" || role == "manager" || role == "receptionist";
+             std::vector<Room> rooms = client.getRooms();
+             std::vector<Booking> bookings;
+             if (staff) {
+                 PageCursor<Booking> cursor = client.adminBookingPages();
+                 cursor.forEach([&bookings](const Booking& booking) { bookings.push_back(booking); return true; });
+             } else {
+                 bookings = client.getBookings();
+             }
+
+             // Only the requested nights are indexed, however long the booking history
+             AvailabilityIndex availability;
+             if (!availability.build(rooms, bookings, checkIn, checkOut)) {
+                 std::cerr << "Check-out must be after check-in (and within " << AvailabilityIndex::kMaxWindowDays << " nights)." << std::endl;
+                 continue;
+             }
+             std::vector<int> freeIds = availability.freeRooms(checkIn, checkOut, guests);
+             if (freeIds.empty()) {
+                 std::cout << "No rooms for " << guests << " guest(s) appear free from " << checkIn << " to " << checkOut << "." << std::endl;
+             } else {
+                 std::cout << "--- Rooms free from " << checkIn << " to " << checkOut << " ---" << std::endl;
+                 for (int id : freeIds) {
+                     auto room = std::find_if(rooms.begin(), rooms.end(), [id](const Room& r) { return r.id == id; });
+                     std::cout << "ID: " << id << " | Name: " << room->name << " | Type: " << room->type
+                               << " | Capacity: " << room->capacity << " | Price: $" << room->price << std::endl;
+                 }
+                 if (!staff) std::cout << "(Based on your own bookings; the server makes the final check.)" << std::endl;
+             }
+        }
+        else if (command == "search_rooms" && loggedInUser) {
+             RoomTable::Query query;
+             std::cout << "Enter Price Range (min max, e.g., 80 200): ";
+             while (!(std::cin >> query.minPrice >> query.maxPrice) || query.maxPrice < query.minPrice) { std::cerr << "Invalid range: "; std::cin.clear(); clearInputBuffer(); } clearInputBuffer();
+             std::cout << "Enter Minimum Capacity: ";
+             while (!(std::cin >> query.minCapacity) || query.minCapacity < 0) { std::cerr << "Invalid capacity: "; std::cin.clear(); clearInputBuffer(); } clearInputBuffer();
+             std::cout << "Enter View (or - for any): ";
+             std::string view; std::cin >> view; clearInputBuffer();
+             if (view != "-") query.view = Symbol(view);
+             std::cout << "Enter Required Amenities (comma-separated, or - for none): ";
+             std::string amenitiesStr; std::getline(std::cin, amenitiesStr);
+             std::string temp;
+             for (char c : amenitiesStr + ",") {
+                if (c == ',') { if (!temp.empty() && temp != "-") query.amenities.insert(std::string_view(temp)); temp.clear(); }
+                else if (!std::isspace(static_cast<unsigned char>(c))) { temp += c; }
+             }
+             std::cout << "Show how many (cheapest first): ";
+             size_t limit;
+             while (!(std::cin >> limit) || limit == 0) { std::cerr << "Invalid number: "; std::cin.clear(); clearInputBuffer(); } clearInputBuffer();
+
+             std::vector<Room> rooms = client.getRooms(); // Served from the room cache when fresh
+             RoomTable table;
+             table.build(rooms);
+             auto started = std::chrono::steady_clock::now();
+             std::vector<uint32_t> rows = table.topKByPrice(table.filter(query), limit);
+             auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count();
+
+             std::cout << "--- " << rows.size() << " of " << table.size() << " rooms match (" << micros << " us) ---" << std::endl;
+             for (uint32_t row : rows) {
+                 const Room& room = rooms[row]; // Table rows follow the order of `rooms`
+                 std::cout << "ID: " << room.id << " | Name: " << room.name << " | Type: " << room.type
+                           << " | Price: $" << room.price << " | Capacity: " << room.capacity
+                           << " | View: " << room.view << std::endl;
+                 std::cout << "  Amenities: " << room.amenities << std::endl;
+             }
+        }
         else if ((command == "my_bookings" || command == "bookings") && loggedInUser) {
              std::cout << "\nFetching your bookings..." << std::endl;
-             std::vector<Booking> bookings = client.getBookings(); // Backend handles filtering by auth token
-             if (!bookings.empty()) {
-                 std::cout << "--- Your Bookings ---" << std::endl;
-                 for(const auto& booking : bookings) {
-                      std::cout << "Booking ID: " << booking.id << " | Room ID: " << booking.roomId
-                                << " | Check-In: " << booking.checkIn << " | Check-Out: " << booking.checkOut
-                                << " | Guests: " << booking.guests << std::endl;
-                      std::cout << "  Status: " << booking.status << " | Package: " << booking.package
-                                << " | Price: $" << booking.totalPrice << std::endl;
-                      std::cout << "  Housekeeping: " << (booking.housekeeping ? ("Yes (" + booking.housekeepingTime + ")") : "No")
-                                << " | Parking: " << (booking.parking ? "Yes" : "No") << std::endl;
-                      std::cout << "---------------------" << std::endl;
-                 }
-             } else {
+             // Print each page as it arrives instead of waiting for the full history
+             PageCursor<Booking> cursor = client.bookingPages();
+             size_t shown = 0;
+             while (std::optional<Booking> bookingOpt = cursor.next()) {
+                  if (shown++ == 0) std::cout << "--- Your Bookings ---" << std::endl;
+                  printBooking(bookingOpt.value());
+             }
+             if (shown == 0 && cursor.failed() && saved.bookingsUserId == loggedInUser.value().id && !saved.bookings.empty()) {
+                  // Offline: the snapshot is better than nothing
+                  std::cerr << "Could not reach the API; showing your bookings as of the last snapshot." << std::endl;
+                  std::cout << "--- Your Bookings (snapshot) ---" << std::endl;
+                  for (const auto& booking : saved.bookings) printBooking(booking);
+             } else if (shown == 0) {
                   std::cout << "You currently have no bookings or failed to fetch them." << std::endl;
+             } else if (cursor.failed()) {
+                  std::cerr << "Stopped after " << shown << " bookings: failed to fetch the next page." << std::endl;
              }
         }
         else if (command == "create_booking" && loggedInUser) {
              BookingData newBooking; int tempBool;
              std::cout << "Enter Room ID to book: ";
              while (!(std::cin >> newBooking.room_id)) { std::cerr << "Invalid ID: "; std::cin.clear(); clearInputBuffer();} clearInputBuffer();
-             std::cout << "Enter Check-in Date (YYYY-MM-DD): "; std::cin >> newBooking.check_in; clearInputBuffer(); // Add validation
-             std::cout << "Enter Check-out Date (YYYY-MM-DD): "; std::cin >> newBooking.check_out; clearInputBuffer(); // Add validation
+             std::cout << "Enter Check-in Date (YYYY-MM-DD): "; newBooking.check_in = readDate();
+             std::cout << "Enter Check-out Date (YYYY-MM-DD): "; newBooking.check_out = readDate();
              std::cout << "Enter Number of Guests: ";
              while (!(std::cin >> newBooking.guests) || newBooking.guests <= 0) { std::cerr << "Invalid guests: "; std::cin.clear(); clearInputBuffer();} clearInputBuffer();
              std::cout << "Enter Package (e.g., Silver, Gold, Platinum): "; std::cin >> newBooking.package; clearInputBuffer();
              std::cout << "Request Housekeeping (1=yes, 0=no): ";
              while (!(std::cin >> tempBool) || (tempBool != 0 && tempBool != 1)) { std::cerr << "Invalid (1/0): "; std::cin.clear(); clearInputBuffer();} clearInputBuffer();
              newBooking.housekeeping = (tempBool == 1);
-             if(newBooking.housekeeping) { std::cout << "Enter Preferred HK Time (HH:MM): "; std::cin >> newBooking.housekeeping_time; clearInputBuffer(); } else { newBooking.housekeeping_time = ""; }
+             if(newBooking.housekeeping) { std::cout << "Enter Preferred HK Time (HH:MM): "; newBooking.housekeeping_time = readTime(); } else { newBooking.housekeeping_time = TimeOfDay(); }
              std::cout << "Request Parking (1=yes, 0=no): ";
              while (!(std::cin >> tempBool) || (tempBool != 0 && tempBool != 1)) { std::cerr << "Invalid (1/0): "; std::cin.clear(); clearInputBuffer();} clearInputBuffer();
              newBooking.parking = (tempBool == 1);
@@ -195,10 +420,96 @@ int main() {
                 std::cout << "  Booking ID: " << booking.id << std::endl;
                 std::cout << "  Status: " << booking.status << std::endl;
                 std::cout << "  Total Price: $" << booking.totalPrice << std::endl;
+             } else if (client.lastWriteQueued()) {
+                std::cout << "The hotel API is unreachable. The booking was saved and will be sent automatically once it is back." << std::endl;
              } else {
                 std::cerr << "Booking creation failed. Please check details or room availability." << std::endl;
              }
          }
+        else if (command == "group_booking" && loggedInUser) {
+             // Same stay for several rooms (group/event reservations), submitted in parallel
+             std::cout << "Enter Room IDs (comma-separated, e.g., 101,102,103): ";
+             std::string roomIdsStr; std::getline(std::cin, roomIdsStr);
+             BookingData templateBooking;
+             std::cout << "Enter Check-in Date (YYYY-MM-DD): "; templateBooking.check_in = readDate();
+             std::cout << "Enter Check-out Date (YYYY-MM-DD): "; templateBooking.check_out = readDate();
+             std::cout << "Enter Guests per Room: ";
+             while (!(std::cin >> templateBooking.guests) || templateBooking.guests <= 0) { std::cerr << "Invalid guests: "; std::cin.clear(); clearInputBuffer();} clearInputBuffer();
+             std::cout << "Enter Package (e.g., Silver, Gold, Platinum): "; std::cin >> templateBooking.package; clearInputBuffer();
+             templateBooking.housekeeping = false;
+             templateBooking.housekeeping_time = TimeOfDay();
+             templateBooking.parking = false;
+
+             std::vector<BookingData> groupBookings;
+             std::string temp;
+             for (char c : roomIdsStr + ",") {
+                if (c == ',') {
+                    if (!temp.empty()) {
+                        try { templateBooking.room_id = std::stoi(temp); groupBookings.push_back(templateBooking); }
+                        catch (const std::exception&) { std::cerr << "Skipping invalid room ID: " << temp << std::endl; }
+                    }
+                    temp.clear();
+                }
+                else if (!std::isspace(static_cast<unsigned char>(c))) { temp += c; }
+             }
+             if (groupBookings.empty()) {
+                 std::cerr << "No valid room IDs entered." << std::endl;
+             } else {
+                 std::cout << "\nSubmitting " << groupBookings.size() << " bookings..." << std::endl;
+                 BookingBatchResult batch = client.createBookings(groupBookings);
+                 for (size_t i = 0; i < batch.items.size(); ++i) {
+                     const auto& item = batch.items[i];
+                     std::cout << "  Room " << groupBookings[i].room_id << ": ";
+                     if (item.ok()) std::cout << "Booking ID " << item.booking->id << " (" << item.booking->status << ")" << std::endl;
+                     else std::cout << "FAILED - " << item.error << std::endl;
+                 }
+                 std::cout << batch.succeeded << "/" << batch.items.size() << " bookings created in "
+                           << batch.elapsedSeconds << "s (" << batch.bookingsPerSecond << " bookings/s)." << std::endl;
+             }
+        }
+        else if (command == "quote" && loggedInUser) {
+             // Rates for the next two years, computed once; each stay after that is a subtraction per room
+             std::vector<Room> rooms = client.getRooms();
+             if (rooms.empty()) { std::cerr << "No rooms to quote (could not fetch the room list)." << std::endl; continue; }
+             auto today = std::chrono::duration_cast<std::chrono::hours>(std::chrono::system_clock::now().time_since_epoch());
+             RateCalendar calendar;
+             calendar.build(rooms, rateRules, Date::fromDays(static_cast<int32_t>(today.count() / 24)), kQuoteHorizonNights);
+
+             std::string package, answer;
+             StayOptions options;
+             std::cout << "Enter Package (e.g., Silver, Gold, Platinum, or - for none): "; std::cin >> package; clearInputBuffer();
+             if (package != "-") options.package = package;
+             std::cout << "Housekeeping (yes/no): "; std::cin >> answer; clearInputBuffer(); options.housekeeping = (answer == "yes" || answer == "y");
+             std::cout << "Parking (yes/no): "; std::cin >> answer; clearInputBuffer(); options.parking = (answer == "yes" || answer == "y");
+
+             // Quote as many date pairs as the caller asks about
+             while (true) {
+                 std::string text;
+                 Date checkIn, checkOut;
+                 std::cout << "Check-in Date (YYYY-MM-DD, or - to finish): ";
+                 if (!(std::cin >> text) || text == "-") { clearInputBuffer(); break; }
+                 clearInputBuffer();
+                 if (!Date::parse(text, checkIn)) { std::cerr << "Invalid date (YYYY-MM-DD)." << std::endl; continue; }
+                 std::cout << "Check-out Date (YYYY-MM-DD): "; checkOut = readDate();
+                 if (!calendar.covers(checkIn, checkOut)) {
+                     std::cerr << "Quotes cover stays from " << calendar.firstNight() << " to " << calendar.endNight()
+                               << " with check-out after check-in." << std::endl;
+                     continue;
+                 }
+
+                 std::vector<RateCalendar::Quote> quotes = calendar.quoteAll(checkIn, checkOut, options);
+                 std::cout << "--- " << (checkOut - checkIn) << " night(s) from " << checkIn << " to " << checkOut << " ---" << std::endl;
+                 std::cout << std::fixed << std::setprecision(2);
+                 for (size_t i = 0; i < quotes.size(); ++i) {
+                     const Room& room = rooms[i]; // quoteAll keeps the room order
+                     if (!room.available || room.id != quotes[i].roomId) continue;
+                     std::cout << "ID: " << room.id << " | Name: " << room.name << " | Type: " << room.type
+                               << " | Room: $" << quotes[i].roomTotal << " | Extras: $" << quotes[i].extras
+                               << " | Total: $" << quotes[i].total() << std::endl;
+                 }
+                 std::cout << std::defaultfloat << std::setprecision(6);
+             }
+        }
         else if (command == "profile" && loggedInUser) {
             int userIdToFetch = loggedInUser.value().id; // Get ID from stored object
             std::cout << "\nFetching your profile (ID: " << userIdToFetch << ")..." << std::endl;
@@ -218,6 +529,38 @@ int main() {
             } else {
                  std::cerr << "Failed to fetch your user profile." << std::endl;
             }
+        }
+        else if (command == "dashboard" && loggedInUser) {
+            // Rooms and bookings come from the local replicas, refreshed with only what
+            // changed since the last dashboard (or in full, from an API without delta
+            // sync); the profile request runs alongside
+            std::cout << "\nLoading dashboard..." << std::endl;
+            auto profileFuture = client.getUserProfileAsync(loggedInUser.value().id);
+            SyncDiff roomChanges = client.syncRooms();
+            SyncDiff bookingChanges = client.syncBookings();
+            std::optional<User> profile = profileFuture.get();
+
+            auto describe = [](const SyncDiff& diff) {
+                if (!diff.ok) return std::string(" (refresh failed, showing last known)");
+                if (diff.empty()) return std::string(" (no changes)");
+                return " (+" + std::to_string(diff.inserted.size()) + " new, " + std::to_string(diff.updated.size()) +
+                       " changed, " + std::to_string(diff.deleted.size()) + " removed)";
+            };
+
+            std::cout << "--- Dashboard ---" << std::endl;
+            if (profile) {
+                loggedInUser = profile; // Update local copy
+                std::cout << "User: " << profile.value().username << " (" << profile.value().email << ")" << std::endl;
+            } else {
+                std::cerr << "Failed to fetch your user profile." << std::endl;
+            }
+            std::vector<Room> rooms = client.roomReplica().values();
+            size_t availableRooms = 0;
+            for (const auto& room : rooms) { if (room.available) ++availableRooms; }
+            std::cout << "Rooms: " << rooms.size() << " listed, " << availableRooms << " available"
+                      << describe(roomChanges) << std::endl;
+            std::cout << "Your bookings: " << client.bookingReplica().size() << describe(bookingChanges) << std::endl;
+            std::cout << "-----------------" << std::endl;
         }
          // --- Staff/Manager Room Commands ---
          else if (command == "create_room" && loggedInUser && (loggedInUser.value().role == "manager" || loggedInUser.value().role == "receptionist")) {
@@ -269,6 +612,7 @@ int main() {
 
              std::cout << "\nUpdating room " << roomId << "..." << std::endl;
              if(client.updateRoom(roomId, updatedRoom)) { std::cout << "Room updated successfully!" << std::endl; }
+             else if (client.lastWriteQueued()) { std::cout << "The hotel API is unreachable. The update was saved and will be sent once it is back." << std::endl; }
              else { std::cerr << "Failed to update room." << std::endl; }
          }
           else if (command == "delete_room" && loggedInUser && (loggedInUser.value().role == "manager" || loggedInUser.value().role == "receptionist")) {
@@ -284,6 +628,41 @@ int main() {
                    std::cout << "Deletion cancelled." << std::endl;
               }
          }
+        else if (command == "metrics" && loggedInUser) {
+            // Per-route view of this session's requests: where the time went and how often it failed
+            RequestMetrics::Snapshot routes = client.metricsSnapshot();
+            if (routes.empty()) {
+                std::cout << "No requests recorded yet." << std::endl;
+            }
+            for (const auto& route : routes) {
+                const auto& total = route.phase(RequestPhase::Total);
+                std::cout << route.method << " " << route.route << ": " << route.requests << " requests, "
+                          << route.errors() << " errors | total p50 <= " << total.quantileMillis(0.50)
+                          << " ms, p95 <= " << total.quantileMillis(0.95) << " ms | server avg "
+                          << route.phase(RequestPhase::Server).meanMillis() << " ms, parse avg "
+                          << route.phase(RequestPhase::Parse).meanMillis() << " ms | "
+                          << route.bytesReceived << " bytes in (" << route.bytesDecoded << " decoded)" << std::endl;
+            }
+            std::cout << "Show Prometheus text? (yes/no): ";
+            std::string confirm; std::cin >> confirm; clearInputBuffer();
+            if (confirm == "yes") std::cout << client.metricsText();
+        }
+        else if (command == "sync" && loggedInUser) {
+            // Send queued offline writes now instead of waiting for the background replayer
+            if (!journalOpen) {
+                std::cerr << "The offline journal is not available." << std::endl;
+            } else if (client.queuedWrites() == 0) {
+                std::cout << "No queued writes." << std::endl;
+            } else {
+                size_t queued = client.queuedWrites();
+                std::cout << "\nSending " << queued << " queued write(s)..." << std::endl;
+                size_t delivered = client.replayJournal();
+                size_t left = client.queuedWrites();
+                size_t rejected = queued > delivered + left ? queued - delivered - left : 0;
+                std::cout << delivered << " delivered, " << rejected << " rejected by the API, "
+                          << left << " still queued." << std::endl;
+            }
+        }
         else if (command == "logout" && loggedInUser) {
             std::cout << "\nLogging out..." << std::endl;
             client.logout();
@@ -302,11 +681,25 @@ int main() {
 
     // --- Application End ---
     std::cout << "\nExiting Hotel Client Application." << std::endl;
+    replayer.reset(); // No replays once we start logging out
+    if (roomsRefresh.valid()) roomsRefresh.wait();
+    if (bookingsRefresh.valid()) bookingsRefresh.wait();
+    collectRefreshes();
+    saveSnapshot(); // Whatever the cache holds now, for a fast next start
+    if (journalOpen && journal.pendingCount() > 0) {
+        std::cout << journal.pendingCount() << " queued write(s) could not be sent yet; they will be retried when their account logs in next time." << std::endl;
+    }
+    ConnectionStats connStats = client.connectionStats();
+    std::cout << "[Connections] Opened: " << connStats.connectionsOpened
+              << " | Reused: " << connStats.connectionsReused
+              << " | Sessions created: " << connStats.sessionsCreated
+              << " | HTTP/2: " << connStats.http2Transfers << " | Compressed: " << connStats.compressedTransfers << std::endl;
     // Attempt graceful logout if user exits while still authenticated
     if (client.isAuthenticated()) {
         std::cout << "Performing final logout..." << std::endl;
         client.logout();
     }
 
+    Logger::instance().flush();
     return 0; // Indicate successful execution
 }
\ No newline at end of file